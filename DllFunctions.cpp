@@ -28,6 +28,23 @@ int getVersion(wchar_t **str)
     return 0;
 }
 
+int getThreadManagerMetrics(wchar_t **str)
+{
+    try {
+        std::wstring metrics = Application::getThreadManagerMetrics();
+        size_t size = (metrics.length() + 1) * sizeof(wchar_t);
+        *str = static_cast<wchar_t*>(malloc(size));
+        if (*str == nullptr) {
+            return -1;
+        }
+        wcscpy(*str, metrics.c_str());
+        return 0;
+    } catch (...) {
+        // exception must not escape extern "C" function
+        return -1;
+    }
+}
+
 // <vcc:dllInterface gen="REPLACE">
 
 int64_t applicationClearFormAction(void *form)
@@ -20,6 +20,7 @@ extern "C"
 {
 
 DLLEXPORT int getVersion(wchar_t **str);
+DLLEXPORT int getThreadManagerMetrics(wchar_t **str);
 
 // <vcc:dllInterface gen="REPLACE">
 DLLEXPORT int64_t applicationClearFormAction(void *form);
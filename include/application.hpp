@@ -79,6 +79,8 @@ class Application : public vcc::BaseForm
         virtual std::shared_ptr<vcc::IResult> doAction(const int64_t &/*formProperty*/, std::shared_ptr<vcc::IObject> /*argument*/) override { return nullptr; }
 
         // <vcc:customApplicationPublicFunctions sync="RESERVE" gen="RESERVE">
+        // Thread Manager Metrics in Json
+        static std::wstring getThreadManagerMetrics();
         // </vcc:customApplicationPublicFunctions>
 };
 
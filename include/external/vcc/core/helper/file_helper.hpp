@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "base_object.hpp"
+#include "cancellation_token.hpp"
 #include "class_macro.hpp"
 
 #define PATH std::filesystem::path
@@ -87,7 +88,8 @@ namespace vcc
 	void copyFile(const std::wstring &srcFilePath, const std::wstring &destFilePath, const bool &isForce = false);
 	void removeFile(const std::wstring &filePath);
 	void createDirectory(const std::wstring &path);
-	void copyDirectory(const std::wstring &srcDirectory, const std::wstring &destDirectory, const CopyDirectoryOption *option = nullptr);
+	// Stop copying remaining files when cancellationToken is cancelled
+	void copyDirectory(const std::wstring &srcDirectory, const std::wstring &destDirectory, const CopyDirectoryOption *option = nullptr, const CancellationToken *cancellationToken = nullptr);
 	void removeDirectory(const std::wstring &directory);
 
 	// Read File
@@ -29,6 +29,7 @@ namespace vcc
 		Uppercase // UPPERCASE
 	};
 
+	// UTF-8 conversion, wchar_t is UTF-16 if 16 bit (e.g. Windows), otherwise code point
 	std::wstring str2wstr(const std::string& str);
 	std::string wstr2str(const std::wstring &wstr);
 
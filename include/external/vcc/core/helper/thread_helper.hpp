@@ -1,8 +1,15 @@
 #pragma once
 
+#include <functional>
+#include <string>
 #include <thread>
 
 namespace vcc
 {
     std::wstring ToString(const std::thread::id &threadId);
+
+    // Call action(index) for index 0 to count - 1 by at most parallelism threads, current thread is also a worker
+    // Each worker takes next index, fewer threads are used if thread cannot be created
+    // First exception thrown by action stops taking next index and is rethrown after all threads are joined
+    void executeParallel(const size_t &count, const int64_t &parallelism, const std::function<void(const size_t &)> &action);
 }
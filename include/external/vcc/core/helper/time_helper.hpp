@@ -5,12 +5,25 @@
 
 namespace vcc
 {
+    enum class TimePrecision
+    {
+        Second,
+        Millisecond,
+        Microsecond
+    };
+
     void Sleep(const long long &milliseconds);
 
     std::wstring getDateString(const time_t &timer);
     std::wstring getCurrentDateString();
     std::wstring getDatetimeString(const time_t &timer);
     std::wstring getCurrentDatetimeString();
+    // Cached per thread, only reformat date and time when second changes
+    std::wstring getDatetimeString(const std::chrono::system_clock::time_point &time, const TimePrecision &precision);
+    std::wstring getCurrentDatetimeString(const TimePrecision &precision);
+
+    // Steady clock, not affected by system time change, comparable across threads
+    int64_t getMonotonicTime(const TimePrecision &precision = TimePrecision::Microsecond);
 
     time_t ParseDatetime(const std::wstring &timeStr, const std::wstring &format);
 }
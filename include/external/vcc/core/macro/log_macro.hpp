@@ -0,0 +1,94 @@
+#pragma once
+
+#include <string>
+#include <type_traits>
+
+#include "log_config.hpp"
+#include "log_service.hpp"
+#include "string_helper.hpp"
+
+namespace vcc
+{
+    inline void ____AppendLogArgument(std::wstring &buffer, const std::wstring &value) { buffer += value; }
+    inline void ____AppendLogArgument(std::wstring &buffer, const wchar_t *value) { if (value != nullptr) buffer += value; }
+    inline void ____AppendLogArgument(std::wstring &buffer, const std::string &value) { buffer += str2wstr(value); }
+    inline void ____AppendLogArgument(std::wstring &buffer, const char *value) { if (value != nullptr) buffer += str2wstr(value); }
+    inline void ____AppendLogArgument(std::wstring &buffer, const wchar_t &value) { buffer += value; }
+    inline void ____AppendLogArgument(std::wstring &buffer, const char &value) { buffer += (wchar_t)value; }
+    inline void ____AppendLogArgument(std::wstring &buffer, const bool &value) { buffer += value ? L"true" : L"false"; }
+
+    template<typename T>
+    requires std::is_arithmetic_v<T>
+    inline void ____AppendLogArgument(std::wstring &buffer, const T &value) { buffer += std::to_wstring(value); }
+
+    // Append format until next "{}", return false if no more placeholder
+    inline bool ____AppendLogFormat(std::wstring &buffer, const wchar_t *&format)
+    {
+        while (*format != L'\0') {
+            if (format[0] == L'{' && format[1] == L'}') {
+                format += 2;
+                return true;
+            } else if ((format[0] == L'{' && format[1] == L'{') || (format[0] == L'}' && format[1] == L'}')) {
+                buffer += format[0];
+                format += 2;
+            } else {
+                buffer += format[0];
+                format++;
+            }
+        }
+        return false;
+    }
+
+    inline void ____FormatLogMessage(std::wstring &buffer, const wchar_t *format)
+    {
+        // placeholder without argument is kept
+        while (____AppendLogFormat(buffer, format))
+            buffer += L"{}";
+    }
+
+    template<typename T, typename... Args>
+    inline void ____FormatLogMessage(std::wstring &buffer, const wchar_t *format, const T &value, const Args &...args)
+    {
+        if (!____AppendLogFormat(buffer, format))
+            return;
+        ____AppendLogArgument(buffer, value);
+        ____FormatLogMessage(buffer, format, args...);
+    }
+
+    // Replace "{}" by arguments in order, "{{" and "}}" for brace
+    // Result is stored in thread local buffer and valid until next call in the same thread
+    template<typename... Args>
+    inline const std::wstring &formatLogMessage(const wchar_t *format, const Args &...args)
+    {
+        thread_local std::wstring buffer;
+        buffer.clear();
+        ____FormatLogMessage(buffer, format, args...);
+        return buffer;
+    }
+
+    template<typename... Args>
+    inline const std::wstring &formatLogMessage(const std::wstring &format, const Args &...args)
+    {
+        return formatLogMessage(format.c_str(), args...);
+    }
+}
+
+// Check log level before formatting, arguments are not evaluated if not logged
+#define VCC_LOG(logFunction, logConfig, condition, id, ...) \
+    do { \
+        const vcc::LogConfig *____logConfig = (logConfig); \
+        if (vcc::LogService::isLogEnabled(____logConfig) && (condition)) \
+            vcc::LogService::logFunction(____logConfig, id, vcc::formatLogMessage(__VA_ARGS__)); \
+    } while (false)
+
+#define VCC_LOG_INFO(logConfig, id, ...) VCC_LOG(logInfo, logConfig, true, id, __VA_ARGS__)
+#define VCC_LOG_DEBUG(logConfig, id, ...) VCC_LOG(LogDebug, logConfig, ____logConfig->getIsLogDebug(), id, __VA_ARGS__)
+#define VCC_LOG_WARNING(logConfig, id, ...) VCC_LOG(LogWarning, logConfig, true, id, __VA_ARGS__)
+#define VCC_LOG_ERROR(logConfig, id, ...) VCC_LOG(LogError, logConfig, true, id, __VA_ARGS__)
+#define VCC_LOG_THREAD(logConfig, id, ...) VCC_LOG(LogThread, logConfig, ____logConfig->getIsLogThread(), id, __VA_ARGS__)
+#define VCC_LOG_TERMINAL(logConfig, id, ...) VCC_LOG(LogTerminal, logConfig, ____logConfig->getIsLogTerminal(), id, __VA_ARGS__)
+#define VCC_LOG_TERMINAL_RESULT(logConfig, id, ...) VCC_LOG(LogTerminalResult, logConfig, ____logConfig->getIsLogTerminalResult(), id, __VA_ARGS__)
+#define VCC_LOG_PROCESS(logConfig, id, ...) VCC_LOG(LogProcess, logConfig, ____logConfig->getIsLogProcess(), id, __VA_ARGS__)
+#define VCC_LOG_PROCESS_RESULT(logConfig, id, ...) VCC_LOG(LogProcessResult, logConfig, ____logConfig->getIsLogProcessResult(), id, __VA_ARGS__)
+#define VCC_LOG_SQL(logConfig, id, ...) VCC_LOG(LogSQL, logConfig, ____logConfig->getIsLogSQL(), id, __VA_ARGS__)
+#define VCC_LOG_SQL_RESULT(logConfig, id, ...) VCC_LOG(LogSQLResult, logConfig, ____logConfig->getIsLogSQLResult(), id, __VA_ARGS__)
@@ -3,18 +3,25 @@
 #include "base_manager.hpp"
 #include "process_state.hpp"
 #include "thread_management_mode.hpp"
+#include "thread_manager_metrics.hpp"
 
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
 #include <vector>
 
 namespace vcc
 {
     class Thread;
 
+    // All modes cancel the CancellationToken of active threads
+    // Mode applies to stop(), destructor always waits until all started threads release the manager
     enum class ThreadManagerTerminateMode
     {
-        Immediately,
-        Force,
-        Wait
+        Immediately, // return without waiting
+        Force, // wait until all threads exit or ForceTerminateTimeout reached
+        Wait // wait until all threads exit
     };
 
     class ThreadManager : public BaseManager
@@ -23,27 +30,73 @@ namespace vcc
         GETSET(ProcessState, State, ProcessState::Idle)
         GETSET(int64_t, MaxThreadPoolSize, 10)
         GETSET(ThreadManagerTerminateMode, TerminateMode, ThreadManagerTerminateMode::Wait)
+        GETSET(int64_t, ForceTerminateTimeout, 1000) // millisecond
+        // Starvation protection: waiting thread gains 1 priority every PriorityAgingInterval millisecond
+        GETSET(int64_t, PriorityAgingInterval, 1000)
+        // Earliest deadline first: thread without Deadline is scheduled as if due DefaultDeadline millisecond after queued
+        GETSET(int64_t, DefaultDeadline, 10000)
     
     protected:
+        // _Threads is a heap ordered by Thread::getScheduleKey(), front() is the next thread to run
         mutable std::vector<std::shared_ptr<Thread>> _Threads;
         mutable std::vector<std::shared_ptr<Thread>> _ActiveThreads;
+        mutable std::mutex _QueueMutex;
+        mutable int64_t _NextSeqNo = 0;
+
+        // Metrics, guarded by _MetricsMutex, time in millisecond
+        mutable std::mutex _MetricsMutex;
+        mutable std::chrono::steady_clock::time_point _MetricsStartTime = std::chrono::steady_clock::now();
+        mutable int64_t _QueuedCount = 0;
+        mutable int64_t _StartedCount = 0;
+        mutable int64_t _CompletedCount = 0;
+        mutable int64_t _FailedCount = 0;
+        mutable int64_t _CancelledCount = 0;
+        mutable int64_t _MaxQueueDepth = 0;
+        mutable int64_t _BusyTime = 0;
+        mutable std::shared_ptr<ThreadLatencyHistogram> _WaitLatency = std::make_shared<ThreadLatencyHistogram>();
+        mutable std::shared_ptr<ThreadLatencyHistogram> _ExecutionLatency = std::make_shared<ThreadLatencyHistogram>();
+        mutable std::map<int64_t, std::shared_ptr<ThreadPriorityMetrics>> _PriorityMetrics;
+
+        void recordThreadQueued(const size_t &queueDepth) const;
+        void recordThreadStarted() const;
+
+        // Threads started by trigger() which have not called releaseThread(), guarded by _ThreadExitMutex
+        mutable std::mutex _ThreadExitMutex;
+        mutable std::condition_variable _ThreadExitCondition;
+        mutable int64_t _OutstandingThreadCount = 0;
+
+        // timeout < 0 means wait forever
+        void waitThreadExit(const int64_t &timeout) const;
 
     public:
         ThreadManager(std::shared_ptr<LogConfig> logConfig) : BaseManager(logConfig) {}
         virtual ~ThreadManager();
         
-        std::vector<std::shared_ptr<Thread>> &getThreads() const;
-        std::vector<std::shared_ptr<Thread>> &getActiveThreads() const;
+        // Snapshot, waiting threads are in heap order instead of run order
+        std::vector<std::shared_ptr<Thread>> getThreads() const;
+        std::vector<std::shared_ptr<Thread>> getActiveThreads() const;
 
-        // Add to Queue Tail
+        // Add to Queue by Thread Priority and Deadline
+        // Thread runs in order of due time queue time + (Deadline or DefaultDeadline) - Priority * PriorityAgingInterval,
+        // Deadline thread is due at queue time + Deadline at the latest, FIFO if same
         void queue(std::shared_ptr<Thread> thread) const;
         
-        // Add to Queue First Piror
+        // Add to Queue First Piror, ignore Thread Priority and Deadline
         void urgent(std::shared_ptr<Thread> thread) const;
 
         // Alert Manager to do work
         void trigger() const;
 
+        // Called by Thread when it exits, record metrics
+        void notifyThreadExit(const Thread *thread) const;
+        // Called by Thread as last access to manager, manager may be destroyed after it returns
+        void releaseThread() const;
+
+        // Metrics, return snapshot
+        std::shared_ptr<ThreadManagerMetrics> getMetrics() const;
+        std::map<int64_t, std::shared_ptr<ThreadPriorityMetrics>> getPriorityMetrics() const;
+        void resetMetrics() const;
+
         // Execute Immediately
         void join(std::shared_ptr<Thread> thread) const;
         
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base_json_object.hpp"
+#include "base_object.hpp"
+#include "class_macro.hpp"
+
+namespace vcc
+{
+    class IDocument;
+    class Json;
+
+    // Latency in millisecond
+    // BucketCounts[i] counts value <= getBucketUpperBounds()[i], last bucket counts the rest
+    class ThreadLatencyHistogram : public BaseObject, public BaseJsonObject
+    {
+        GETSET(int64_t, Count, 0)
+        GETSET(int64_t, Total, 0)
+        GETSET(int64_t, Max, 0)
+        VECTOR(int64_t, BucketCounts)
+
+        public:
+            ThreadLatencyHistogram();
+            virtual ~ThreadLatencyHistogram() {}
+
+            virtual std::shared_ptr<IObject> clone() const override
+            {
+                return std::make_shared<ThreadLatencyHistogram>(*this);
+            }
+
+            static const std::vector<int64_t> &getBucketUpperBounds();
+
+            void record(const int64_t &value);
+            int64_t getAverage() const;
+
+            virtual std::shared_ptr<Json> ToJson() const override;
+            virtual void deserializeJson(std::shared_ptr<IDocument> document) override;
+    };
+
+    // Time in millisecond, recorded when thread exits
+    class ThreadPriorityMetrics : public BaseObject, public BaseJsonObject
+    {
+        GETSET(int64_t, Priority, 0)
+        GETSET(int64_t, CompletedCount, 0)
+        GETSET(int64_t, TotalWaitTime, 0)
+        GETSET(int64_t, MaxWaitTime, 0)
+        GETSET(int64_t, TotalRunTime, 0)
+        GETSET(int64_t, MaxRunTime, 0)
+        GETSET(int64_t, DeadlineMissedCount, 0)
+
+        public:
+            ThreadPriorityMetrics() : BaseObject() {}
+            virtual ~ThreadPriorityMetrics() {}
+
+            virtual std::shared_ptr<IObject> clone() const override
+            {
+                return std::make_shared<ThreadPriorityMetrics>(*this);
+            }
+
+            virtual std::shared_ptr<Json> ToJson() const override;
+            virtual void deserializeJson(std::shared_ptr<IDocument> document) override;
+    };
+
+    // Snapshot of ThreadManager, time in millisecond
+    class ThreadManagerMetrics : public BaseObject, public BaseJsonObject
+    {
+        GETSET(int64_t, QueuedCount, 0)
+        GETSET(int64_t, StartedCount, 0)
+        GETSET(int64_t, CompletedCount, 0)
+        GETSET(int64_t, FailedCount, 0)
+        GETSET(int64_t, CancelledCount, 0)
+        GETSET(int64_t, QueueDepth, 0)
+        GETSET(int64_t, MaxQueueDepth, 0)
+        GETSET(int64_t, ActiveCount, 0)
+        GETSET(int64_t, MaxThreadPoolSize, 0)
+        // Worker Utilization = BusyTime / (ElapsedTime * MaxThreadPoolSize)
+        GETSET(int64_t, ElapsedTime, 0)
+        GETSET(int64_t, BusyTime, 0)
+        GETSET(double, WorkerUtilization, 0)
+        GETSET_SPTR(ThreadLatencyHistogram, WaitLatency)
+        GETSET_SPTR(ThreadLatencyHistogram, ExecutionLatency)
+        VECTOR_SPTR(ThreadPriorityMetrics, PriorityMetrics)
+
+        public:
+            ThreadManagerMetrics() : BaseObject() {}
+            virtual ~ThreadManagerMetrics() {}
+
+            virtual std::shared_ptr<IObject> clone() const override
+            {
+                auto obj = std::make_shared<ThreadManagerMetrics>(*this);
+                obj->cloneWaitLatency(this->_WaitLatency.get());
+                obj->cloneExecutionLatency(this->_ExecutionLatency.get());
+                obj->clonePriorityMetrics(this->_PriorityMetrics);
+                return obj;
+            }
+
+            virtual std::shared_ptr<Json> ToJson() const override;
+            virtual void deserializeJson(std::shared_ptr<IDocument> document) override;
+    };
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include "exception.hpp"
+#include "exception_type.hpp"
+
+namespace vcc
+{
+    // Cooperative cancellation for Thread actions and long running services
+    // Long running services check isCancelled() or register a callback to interrupt blocking work (e.g. kill child process)
+    class CancellationToken
+    {
+        protected:
+            mutable std::atomic<bool> _IsCancelled = false;
+            mutable std::mutex _Mutex;
+            mutable int64_t _NextCallbackID = 0;
+            mutable std::map<int64_t, std::function<void()>> _Callbacks;
+            // Callback executing in cancel(), unregisterCallback waits for it
+            mutable int64_t _RunningCallbackID = -1;
+            mutable std::thread::id _CancelThreadID;
+            mutable std::condition_variable _CallbackCondition;
+
+            void finishCallback() const
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_Mutex);
+                    _RunningCallbackID = -1;
+                }
+                _CallbackCondition.notify_all();
+            }
+
+        public:
+            CancellationToken() = default;
+            virtual ~CancellationToken() {}
+
+            bool isCancelled() const
+            {
+                return _IsCancelled.load();
+            }
+
+            void throwIfCancelled() const
+            {
+                if (isCancelled())
+                    throw Exception(ExceptionType::CustomError, L"Operation cancelled.");
+            }
+
+            // Callbacks run one by one without lock, callback not run yet is skipped if unregistered meanwhile
+            void cancel() const
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_Mutex);
+                    if (_IsCancelled.exchange(true))
+                        return;
+                    _CancelThreadID = std::this_thread::get_id();
+                }
+                while (true) {
+                    std::function<void()> callback = nullptr;
+                    {
+                        std::lock_guard<std::mutex> lock(_Mutex);
+                        if (_Callbacks.empty())
+                            break;
+                        auto it = _Callbacks.begin();
+                        _RunningCallbackID = it->first;
+                        callback = std::move(it->second);
+                        _Callbacks.erase(it);
+                    }
+                    try {
+                        callback();
+                    } catch (...) {
+                        finishCallback();
+                        throw;
+                    }
+                    finishCallback();
+                }
+            }
+
+            // Callback is executed immediately if already cancelled, return -1 in that case
+            int64_t registerCallback(std::function<void()> callback) const
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_Mutex);
+                    if (!_IsCancelled.load()) {
+                        int64_t callbackID = _NextCallbackID++;
+                        _Callbacks.insert(std::make_pair(callbackID, callback));
+                        return callbackID;
+                    }
+                }
+                callback();
+                return -1;
+            }
+
+            // Callback does not run after return, wait if cancel() is running it in other thread,
+            // caller may release resource used by callback afterward such as reaping child pid
+            void unregisterCallback(const int64_t &callbackID) const
+            {
+                std::unique_lock<std::mutex> lock(_Mutex);
+                _Callbacks.erase(callbackID);
+                if (callbackID < 0 || std::this_thread::get_id() == _CancelThreadID)
+                    return;
+                _CallbackCondition.wait(lock, [this, callbackID]() { return _RunningCallbackID != callbackID; });
+            }
+    };
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace vcc
+{
+    // Bounded lock-free queue for multiple producers and single consumer
+    // Each slot carries a sequence number, producers claim slot by compare exchange on enqueue position
+    // Capacity is rounded up to power of 2
+    template <typename T>
+    class MpscRingBuffer
+    {
+        private:
+            struct Slot
+            {
+                std::atomic<size_t> Sequence = 0;
+                T Value;
+            };
+
+            size_t _Capacity = 0;
+            size_t _Mask = 0;
+            std::unique_ptr<Slot[]> _Slots;
+            alignas(64) std::atomic<size_t> _EnqueuePosition = 0;
+            alignas(64) size_t _DequeuePosition = 0;
+
+        public:
+            MpscRingBuffer(const size_t &capacity)
+            {
+                _Capacity = 2;
+                while (_Capacity < capacity)
+                    _Capacity <<= 1;
+                _Mask = _Capacity - 1;
+                _Slots = std::make_unique<Slot[]>(_Capacity);
+                for (size_t i = 0; i < _Capacity; i++)
+                    _Slots[i].Sequence.store(i, std::memory_order_relaxed);
+            }
+            ~MpscRingBuffer() {}
+
+            MpscRingBuffer(const MpscRingBuffer &) = delete;
+            MpscRingBuffer &operator=(const MpscRingBuffer &) = delete;
+
+            size_t getCapacity() const
+            {
+                return _Capacity;
+            }
+
+            // Number of slots claimed by producers, including slots still being written
+            size_t getPushedCount() const
+            {
+                return _EnqueuePosition.load(std::memory_order_acquire);
+            }
+
+            // Called by any thread, return false if full
+            bool tryPush(T &&value)
+            {
+                size_t position = _EnqueuePosition.load(std::memory_order_relaxed);
+                Slot *slot = nullptr;
+                while (true) {
+                    slot = &_Slots[position & _Mask];
+                    size_t sequence = slot->Sequence.load(std::memory_order_acquire);
+                    intptr_t diff = (intptr_t)sequence - (intptr_t)position;
+                    if (diff == 0) {
+                        if (_EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                            break;
+                    } else if (diff < 0)
+                        return false;
+                    else
+                        position = _EnqueuePosition.load(std::memory_order_relaxed);
+                }
+                slot->Value = std::move(value);
+                slot->Sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+
+            // Called by consumer thread only, return false if empty
+            bool tryPop(T &value)
+            {
+                Slot &slot = _Slots[_DequeuePosition & _Mask];
+                if (slot.Sequence.load(std::memory_order_acquire) != _DequeuePosition + 1)
+                    return false;
+                value = std::move(slot.Value);
+                slot.Sequence.store(_DequeuePosition + _Capacity, std::memory_order_release);
+                _DequeuePosition++;
+                return true;
+            }
+    };
+}
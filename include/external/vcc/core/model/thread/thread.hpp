@@ -1,11 +1,14 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <string>
 #include <thread>
 
 #include "base_object.hpp"
+#include "cancellation_token.hpp"
 #include "class_macro.hpp"
 #include "log_config.hpp"
 #include "process_state.hpp"
@@ -16,23 +19,42 @@ namespace vcc
     class Thread
     {
         GETSET_SPTR_NULL(LogConfig, LogConfig)
-        GETSET(ProcessState, State, ProcessState::Idle)
 
-        GETSET(int64_t, SeqNo, -1)
+        GETSET(int64_t, SeqNo, -1) // assigned by ThreadManager when queued
+        GETSET(int64_t, Priority, 0) // higher value runs first
+        GETSET(int64_t, Deadline, -1) // millisecond after queued, -1 means no deadline
         GETSET(std::wstring, Id, L"")
         GETSET(std::wstring, MessageStart, L"")
         GETSET(std::wstring, MessageComplete, L"")
         GETSET(std::wstring, DebugMessage, L"")
 
         protected:
+            // cancel() sets Stop from other thread while execute() runs, Stop is not overwritten by execute()
+            mutable std::atomic<ProcessState> _State = ProcessState::Idle;
             mutable std::thread::id _Pid;
             mutable const ThreadManager *_Manager = nullptr;
+            mutable std::atomic<bool> _IsExecuting = false;
+            mutable std::atomic<bool> _IsFailed = false;
+            mutable std::shared_ptr<CancellationToken> _CancellationToken = std::make_shared<CancellationToken>();
+
+            // Scheduling and metrics, set by ThreadManager and execute()
+            mutable int64_t _ScheduleKey = 0;
+            mutable std::chrono::steady_clock::time_point _QueueTime;
+            mutable std::chrono::steady_clock::time_point _StartTime;
+            mutable std::chrono::steady_clock::time_point _EndTime;
 
             mutable std::function<void(const Thread *)> _Action = nullptr;
             mutable std::function<void(const Thread *)> _Callback = nullptr;
 
             Thread() = default;
 
+            // Set state unless Stop
+            void updateState(const ProcessState &state) const;
+
+            // Exit path of execute() for both return and exception, releases manager as last action
+            class ExitGuard;
+            void exit() const;
+
         public:
             Thread(std::shared_ptr<LogConfig> logConfig, std::function<void(const Thread *)> action)
                 : _LogConfig(logConfig), _Action(action) {}
@@ -48,11 +70,33 @@ namespace vcc
                 : _LogConfig(logConfig), _Id(id), _MessageStart(messageStart), _MessageComplete(messageComplete), _DebugMessage(debugMessage), _Action(action), _Callback(callback) {}
             virtual ~Thread() {}
 
+            ProcessState getState() const;
+            void setState(const ProcessState &state) const;
+
             const ThreadManager *getManager() const;
             void setManager(const ThreadManager *manager) const;
 
             std::wstring getPid() const;
 
+            // Action should check getCancellationToken()->isCancelled() or pass the token to long running services
+            std::shared_ptr<CancellationToken> getCancellationToken() const;
+            bool isCancelled() const;
+            void cancel() const;
+
+            // True from action start to callback end
+            bool isExecuting() const;
+            // True if action or callback throws exception
+            bool isFailed() const;
+
+            // Smaller key runs first, see ThreadManager::queue
+            int64_t getScheduleKey() const;
+            void setScheduleKey(const int64_t &key) const;
+
+            std::chrono::steady_clock::time_point getQueueTime() const;
+            void setQueueTime(const std::chrono::steady_clock::time_point &time) const;
+            std::chrono::steady_clock::time_point getStartTime() const;
+            std::chrono::steady_clock::time_point getEndTime() const;
+
             void execute() const;
     };
 }
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "log_config.hpp"
+#include "log_file_writer.hpp"
+#include "log_record.hpp"
+#include "mpsc_ring_buffer.hpp"
+
+namespace vcc
+{
+	struct AsyncLogEntry
+	{
+		bool IsConsoleLog = false;
+		std::wstring FilePath = L"";
+		LogFileOption FileOption;
+		std::wstring Message = L"";
+		LogRecord Record;
+	};
+
+	// Background writer for LogConfig::IsAsync
+	// Producers push to lock-free ring buffer, writer keeps log files open and flushes in batch or on timer
+	// File rotation and format follow LogConfig at the time of push
+	// Flush interval and batch size are process wide, taken from first LogConfig pushed unless configure() is called before
+	// Remaining messages are written when process exits, push() after writer is stopped returns false and caller writes synchronously
+	class AsyncLogWriter
+	{
+	private:
+		MpscRingBuffer<AsyncLogEntry> _Buffer;
+		std::atomic<int64_t> _FlushInterval = 100;
+		std::atomic<int64_t> _BatchSize = 256;
+		std::atomic<size_t> _WrittenCount = 0;
+		std::atomic<bool> _IsConfigured = false;
+		// Producers inside push(), writer does not exit until no producer may still push
+		std::atomic<int64_t> _PushingCount = 0;
+		std::atomic<bool> _IsStopped = false;
+
+		std::mutex _Mutex;
+		std::condition_variable _WriterCondition;
+		std::condition_variable _FlushCondition;
+		bool _IsStop = false;
+		bool _IsWriterExited = false;
+		bool _IsFlushRequested = false;
+		std::thread _Writer;
+
+		// Writer thread only
+		std::map<std::wstring, std::unique_ptr<LogFileWriter>> _FileWriters;
+
+		AsyncLogWriter(const size_t &capacity);
+
+		LogFileWriter *getFileWriter(const std::wstring &filePath);
+		size_t drain();
+		void run();
+
+	public:
+		~AsyncLogWriter();
+
+		static AsyncLogWriter &getInstance();
+
+		// Override flush interval (millisecond) and batch size, value <= 0 means 1
+		void configure(const int64_t &flushInterval, const int64_t &batchSize);
+		// filePath and fileOption may differ from logConfig, see LogConfig::BinaryCategories
+		// Return false without pushing if writer is stopped
+		// Wait for free slot if buffer is full
+		bool push(const LogConfig *logConfig, const std::wstring &filePath, const LogFileOption &fileOption, const std::wstring &message, const LogRecord &record);
+		// Block until all pushed messages are written, including when writer is stopping
+		void flush();
+	};
+}
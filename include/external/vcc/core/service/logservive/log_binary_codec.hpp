@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "base_service.hpp"
+#include "log_record.hpp"
+
+namespace vcc
+{
+	// Binary log file: file header, then records
+	// Record: varint type, varint category, varint timestamp, then thread id, id, user id and message as varint byte length + UTF-8
+	class LogBinaryCodec : public BaseService
+	{
+	public:
+		LogBinaryCodec() : BaseService() {}
+		~LogBinaryCodec() {}
+
+		static const std::string &getFileHeader();
+		// Return false if data does not start with file header
+		static bool decodeFileHeader(const std::string &data, size_t &pos);
+
+		static void encode(const LogRecord &record, std::string &buffer);
+		// Return false if no complete record at pos, pos is not changed in that case
+		static bool decode(const std::string &data, size_t &pos, LogRecord &record);
+		// Decode whole file, incomplete record at the end is skipped
+		static void decodeFile(const std::wstring &filePath, std::vector<LogRecord> &records);
+	};
+}
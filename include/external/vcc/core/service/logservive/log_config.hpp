@@ -1,10 +1,13 @@
 #pragma once
 
 #include <assert.h>
+#include <set>
 #include <string>
 
 #include "base_object.hpp"
 #include "class_macro.hpp"
+#include "log_type.hpp"
+#include "time_helper.hpp"
 
 namespace vcc
 {
@@ -14,6 +17,13 @@ namespace vcc
         All
     };
 
+    enum class LogFileFormat
+    {
+        Text,
+        Binary, // see LogBinaryCodec
+        JsonLines // see LogJsonLineCodec
+    };
+
     class LogConfig : public BaseObject
     {
         // General
@@ -21,6 +31,23 @@ namespace vcc
         
         GETSET(bool, IsConsoleLog, false);
         GETSET(std::wstring, FilePath, L"");
+        GETSET(LogFileFormat, FileFormat, LogFileFormat::Text);
+        // Rotation, FilePath is renamed to FilePath.1, FilePath.1 to FilePath.2 and so on
+        GETSET(int64_t, MaxFileSize, -1); // byte, -1 means no limit
+        GETSET(int64_t, RotationInterval, -1); // second from first write in this process, -1 means no time rotation
+        GETSET(int64_t, MaxRetainedFileCount, 5); // rotated files kept, 0 means truncate when rotate
+        // High volume categories such as ProcessResult, written to BinaryFilePath in Binary format instead of FilePath
+        SET(LogCategory, BinaryCategories);
+        GETSET(std::wstring, BinaryFilePath, L""); // empty means FilePath + ".bin"
+        GETSET(TimePrecision, TimestampPrecision, TimePrecision::Millisecond);
+        // Add steady clock time in microsecond after datetime, to compare latency across threads
+        GETSET(bool, IsLogMonotonicTime, false);
+        // Async, messages are written by background writer, call LogService::flush() to wait
+        // Writer is shared by whole process, AsyncFlushInterval and AsyncBatchSize are taken from first async LogConfig logged,
+        // later LogConfig does not override them, call LogService::configureAsync() to change
+        GETSET(bool, IsAsync, false);
+        GETSET(int64_t, AsyncFlushInterval, 100); // millisecond
+        GETSET(int64_t, AsyncBatchSize, 256);
         // Debug
         GETSET(bool, IsLogDebug, false);
         // Thread
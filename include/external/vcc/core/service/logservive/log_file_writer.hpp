@@ -0,0 +1,50 @@
+#pragma once
+
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "log_config.hpp"
+#include "log_record.hpp"
+
+namespace vcc
+{
+	// Rotation and format of LogConfig, copied for async writer
+	struct LogFileOption
+	{
+		LogFileFormat FileFormat = LogFileFormat::Text;
+		int64_t MaxFileSize = -1;
+		int64_t RotationInterval = -1;
+		int64_t MaxRetainedFileCount = 5;
+
+		LogFileOption() = default;
+		LogFileOption(const LogConfig *logConfig);
+	};
+
+	// Write one log file with rotation, not thread safe
+	// Async writer keeps file open, sync log closes file after each write
+	class LogFileWriter
+	{
+	private:
+		std::wstring _FilePath = L"";
+		bool _IsKeepOpen = false;
+		std::ofstream _FileStream;
+		int64_t _FileSize = -1;
+		std::chrono::steady_clock::time_point _StartTime = std::chrono::steady_clock::now();
+
+		void open();
+		void close();
+		bool isRotationNeeded(const LogFileOption &option, const size_t &size) const;
+		void rotate(const LogFileOption &option);
+
+	public:
+		LogFileWriter(const std::wstring &filePath, const bool &isKeepOpen);
+		~LogFileWriter();
+
+		static std::wstring getRotatedFilePath(const std::wstring &filePath, const int64_t &index);
+
+		void write(const LogFileOption &option, const std::wstring &text, const LogRecord &record);
+		void flush();
+	};
+}
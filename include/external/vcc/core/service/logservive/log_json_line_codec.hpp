@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+
+#include "base_service.hpp"
+#include "log_record.hpp"
+#include "log_type.hpp"
+
+namespace vcc
+{
+	// JsonLines log file: one JSON object per line
+	// {"Type":"Info","Timestamp":1700000000000000,"ThreadId":"1","UserID":"","Category":"Process","Id":"","Message":""}
+	// Non ASCII characters are escaped as \uXXXX, so line is ASCII
+	class LogJsonLineCodec : public BaseService
+	{
+	public:
+		LogJsonLineCodec() : BaseService() {}
+		~LogJsonLineCodec() {}
+
+		static const wchar_t *getLogTypeName(const LogType &logType);
+		static const wchar_t *getLogCategoryName(const LogCategory &logCategory);
+
+		// Append one line without line break
+		static void encode(const LogRecord &record, std::string &buffer);
+	};
+}
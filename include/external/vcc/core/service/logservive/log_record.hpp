@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "log_type.hpp"
+
+namespace vcc
+{
+    // Fields of one log message, used by Binary and JsonLines log file
+    struct LogRecord
+    {
+        LogType Type = LogType::Info;
+        LogCategory Category = LogCategory::General;
+        int64_t Timestamp = 0; // microsecond since epoch
+        std::wstring ThreadId = L"";
+        std::wstring Id = L"";
+        std::wstring UserID = L"";
+        std::wstring Message = L"";
+    };
+}
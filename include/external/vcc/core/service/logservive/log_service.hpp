@@ -4,26 +4,26 @@
 
 #include "base_service.hpp"
 #include "log_config.hpp"
+#include "log_type.hpp"
 
 namespace vcc
 {
-    enum class LogType
-    {
-        Error,
-        Warning,
-		Debug,
-        Info
-    };
-
 	class LogService : public BaseService
 	{
 	private:
-		static std::wstring _logMessage(const LogConfig *logConfig, const LogType &logType, const std::wstring &id, const std::wstring &message);
+		static std::wstring _logMessage(const LogConfig *logConfig, const LogType &logType, const LogCategory &logCategory, const std::wstring &id, const std::wstring &message);
 
 	public:
 		LogService() : BaseService() {}
 		~LogService() {}
 
+		// Block until async log messages are written
+		static void flush();
+		// Flush interval (millisecond) and batch size of async writer, shared by all LogConfig
+		static void configureAsync(const int64_t &flushInterval, const int64_t &batchSize);
+		// False if message will not be written to console or file, see log_macro.hpp
+		static bool isLogEnabled(const LogConfig *logConfig);
+
 		// General
 		static std::wstring logInfo(const LogConfig *logConfig, const std::wstring &id, const std::wstring &message);
 		static std::wstring LogDebug(const LogConfig *logConfig, const std::wstring &id, const std::wstring &message);
@@ -0,0 +1,25 @@
+#pragma once
+
+namespace vcc
+{
+    enum class LogType
+    {
+        Error,
+        Warning,
+        Debug,
+        Info
+    };
+
+    // Source of log message, follows LogService functions
+    enum class LogCategory
+    {
+        General,
+        Thread,
+        Terminal,
+        TerminalResult,
+        Process,
+        ProcessResult,
+        SQL,
+        SQLResult
+    };
+}
@@ -1,23 +1,74 @@
 #pragma once
 #include "base_service.hpp"
 
+#include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "base_object.hpp"
+#include "cancellation_token.hpp"
+#include "class_macro.hpp"
 #include "log_config.hpp"
 
 namespace vcc
 {
+    // Linux only, ignored on Windows
+    class ProcessOption : public BaseObject
+    {
+        GETSET(int64_t, Timeout, -1); // millisecond, -1 means no timeout
+        GETSET(int64_t, KillGracePeriod, 2000); // millisecond from SIGTERM to SIGKILL, for timeout and cancel
+        // Resource limit of child process, -1 means not set
+        GETSET(int64_t, CpuTimeLimit, -1); // second, RLIMIT_CPU
+        GETSET(int64_t, AddressSpaceLimit, -1); // byte, RLIMIT_AS
+
+        public:
+            ProcessOption() : BaseObject() {}
+            virtual ~ProcessOption() {}
+
+            virtual std::shared_ptr<IObject> clone() const override
+            {
+                return std::make_shared<ProcessOption>(*this);
+            }
+    };
+
+    class ProcessResult : public BaseObject
+    {
+        GETSET(int64_t, ExitCode, -1); // -1 if terminated by signal
+        GETSET(int64_t, Signal, 0); // signal which terminated the process, 0 if exited
+        GETSET(bool, IsTimeout, false);
+        GETSET(std::wstring, Output, L"");
+        GETSET(std::wstring, Error, L"");
+
+        public:
+            ProcessResult() : BaseObject() {}
+            virtual ~ProcessResult() {}
+
+            virtual std::shared_ptr<IObject> clone() const override
+            {
+                return std::make_shared<ProcessResult>(*this);
+            }
+
+            bool isSuccess() const
+            {
+                return _ExitCode == 0 && _Signal == 0 && !_IsTimeout;
+            }
+    };
+
     class ProcessService : public BaseService
     {
         private:
             #ifdef _WIN32
-            static std::wstring _ExecuteWindow(const std::wstring &command);
+            static std::shared_ptr<ProcessResult> _ExecuteWindow(const std::wstring &command, const std::wstring &workspace);
             #else
-            static std::wstring _ExecuteLinux(const std::string &command);
+            // onOutput and onError receive stdout and stderr buffer after each read and may erase consumed part, Output and Error of result are remaining part
+            static std::shared_ptr<ProcessResult> _ExecuteLinux(const std::string &command, const std::string &workspace, const ProcessOption *option, const std::function<void(std::string &)> &onOutput, const std::function<void(std::string &)> &onError, const CancellationToken *cancellationToken);
             #endif
 
-            static std::wstring _Execute(const std::wstring &command);
+            static std::shared_ptr<ProcessResult> _Execute(const std::wstring &command, const std::wstring &workspace, const ProcessOption *option, const CancellationToken *cancellationToken);
+            static std::shared_ptr<ProcessResult> _ExecuteStreaming(const std::wstring &command, const std::wstring &workspace, const ProcessOption *option, const std::function<void(const std::wstring &)> &onLine, const CancellationToken *cancellationToken);
+            static std::shared_ptr<ProcessResult> _ExecuteErrorStreaming(const std::wstring &command, const std::wstring &workspace, const ProcessOption *option, const std::function<void(const std::wstring &)> &onErrorLine, const CancellationToken *cancellationToken);
+            static void _ThrowIfFailed(const ProcessResult *result, const ProcessOption *option);
 
         public:
             ProcessService() : BaseService() {}
@@ -25,6 +76,20 @@ namespace vcc
 
             static std::vector<std::string> ParseCmdLinux(const std::string &cmd);
             static std::wstring execute(const LogConfig *logConfig, const std::wstring &id, const std::wstring &command);
-            static std::wstring execute(const LogConfig *logConfig, const std::wstring &id, const std::wstring &workspace, const std::wstring &command);
+            // workspace is working directory of child process, current directory of this process is not changed, so it is safe to call from multiple threads
+            // child process is terminated when cancellationToken is cancelled
+            static std::wstring execute(const LogConfig *logConfig, const std::wstring &id, const std::wstring &workspace, const std::wstring &command, const CancellationToken *cancellationToken = nullptr);
+            // Exit code, signal and timeout are returned in result instead of exception
+            // Exception is only thrown if process cannot be started or cancellationToken is cancelled
+            static std::shared_ptr<ProcessResult> executeWithResult(const LogConfig *logConfig, const std::wstring &id, const std::wstring &workspace, const std::wstring &command, const ProcessOption *option = nullptr, const CancellationToken *cancellationToken = nullptr);
+            // onLine is called for each stdout line without line break as soon as it is read, output is not kept in memory
+            // Exception thrown by onLine kills child process and is rethrown
+            static void executeStreaming(const LogConfig *logConfig, const std::wstring &id, const std::wstring &workspace, const std::wstring &command, const std::function<void(const std::wstring &)> &onLine, const CancellationToken *cancellationToken = nullptr, const ProcessOption *option = nullptr);
+            // onErrorLine is called for each non empty stderr line as soon as it is read, line ended by carriage return (e.g. progress of git) is also delivered
+            // Trimmed stdout is returned, Error of exception only has stderr lines ended by line feed, Windows has no stderr line
+            static std::wstring executeErrorStreaming(const LogConfig *logConfig, const std::wstring &id, const std::wstring &workspace, const std::wstring &command, const std::function<void(const std::wstring &)> &onErrorLine, const CancellationToken *cancellationToken = nullptr, const ProcessOption *option = nullptr);
+            // Run independent commands concurrently, at most parallelism processes at the same time
+            // Results are in the same order as commands, command which cannot be started has ExitCode -1 and message in Error
+            static std::vector<std::shared_ptr<ProcessResult>> executeBatch(const LogConfig *logConfig, const std::wstring &id, const std::wstring &workspace, const std::vector<std::wstring> &commands, const int64_t &parallelism = 4, const ProcessOption *option = nullptr, const CancellationToken *cancellationToken = nullptr);
     };
-}
\ No newline at end of file
+}
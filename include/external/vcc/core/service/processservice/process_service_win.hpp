@@ -8,6 +8,6 @@
 
 namespace vcc 
 {
-    std::wstring ProcessServiceWin(const std::wstring &command);
+    std::wstring ProcessServiceWin(const std::wstring &command, const std::wstring &workspace);
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace vcc
+{
+    // Long running child process, requests are written to stdin and responses are read from stdout
+    // stderr is discarded, not thread safe
+    // Linux only, throw NotSupport on Windows
+    class ProcessSession
+    {
+        private:
+            int64_t _Pid = -1;
+            int _StdinFd = -1;
+            int _StdoutFd = -1;
+            // stdout read but not yet returned
+            std::string _Buffer = "";
+            size_t _BufferPos = 0;
+
+            // Read more stdout into buffer, return false if EOF
+            bool fill();
+
+        public:
+            // workspace is working directory of child process
+            ProcessSession(const std::wstring &workspace, const std::wstring &command);
+            ~ProcessSession();
+
+            ProcessSession(const ProcessSession &) = delete;
+            ProcessSession &operator=(const ProcessSession &) = delete;
+
+            bool isRunning() const;
+
+            void write(const std::string &data);
+            // Line without line break, throw if process ends before line break
+            std::string readLine();
+            // Exactly size bytes, throw if process ends before that
+            std::string read(const size_t &size);
+
+            // Close stdin and wait for child exit, SIGKILL if child is still running after grace period
+            void close(const int64_t &gracePeriod = 2000);
+    };
+}
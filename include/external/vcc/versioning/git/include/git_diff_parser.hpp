@@ -0,0 +1,92 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base_object.hpp"
+#include "class_macro.hpp"
+#include "git_service.hpp"
+
+namespace vcc
+{
+    class GitDiffHunk : public BaseObject
+    {
+        GETSET(size_t, LineNumberOld, 0);
+        GETSET(size_t, LineCountOld, 0); // 0 if omitted in hunk header, same as GitDifference
+        GETSET(size_t, LineNumberNew, 0);
+        GETSET(size_t, LineCountNew, 0);
+        GETSET(size_t, AddLineCount, 0);
+        GETSET(size_t, DeleteLineCount, 0);
+        // Lines after "@@" line in buffer of GitDiffParser, including line breaks
+        GETSET(size_t, Offset, 0);
+        GETSET(size_t, Length, 0);
+
+        public:
+            GitDiffHunk() : BaseObject() {}
+            virtual ~GitDiffHunk() {}
+
+            virtual std::shared_ptr<IObject> clone() const override
+            {
+                return std::make_shared<GitDiffHunk>(*this);
+            }
+    };
+
+    class GitDiffFile : public BaseObject
+    {
+        GETSET(std::wstring, FilePathOld, L""); // empty if file is added
+        GETSET(std::wstring, FilePathNew, L""); // empty if file is deleted
+        GETSET(bool, IsBinary, false);
+        // From "diff --git" line to end of last hunk in buffer of GitDiffParser
+        GETSET(size_t, Offset, 0);
+        GETSET(size_t, Length, 0);
+        VECTOR_SPTR(GitDiffHunk, Hunks);
+
+        public:
+            GitDiffFile() : BaseObject() {}
+            virtual ~GitDiffFile() {}
+
+            virtual std::shared_ptr<IObject> clone() const override
+            {
+                auto obj = std::make_shared<GitDiffFile>(*this);
+                obj->cloneHunks(this->_Hunks);
+                return obj;
+            }
+    };
+
+    // Parse unified diff line by line, e.g. from ProcessService::executeStreaming
+    // Raw output is kept once in buffer, files and hunks only keep byte offsets and text of hunk is created on request
+    class GitDiffParser
+    {
+        private:
+            std::string _Buffer = "";
+            std::vector<std::shared_ptr<GitDiffFile>> _Files;
+            std::shared_ptr<GitDiffHunk> _CurrentHunk = nullptr;
+            // "--- /dev/null" is read, "+++ b/path" must not set FilePathOld from "diff --git" line
+            bool _IsFileHeader = false;
+
+            void parseDiffGitLine(const std::string &line, std::shared_ptr<GitDiffFile> file);
+            void parseHunkHeader(const std::string &line, std::shared_ptr<GitDiffHunk> hunk);
+
+        public:
+            GitDiffParser() {}
+            ~GitDiffParser() {}
+
+            // line without line break
+            void parseLine(const std::wstring &line);
+            // whole output, line break is kept in buffer
+            void parse(const std::wstring &str);
+            void clear();
+
+            const std::vector<std::shared_ptr<GitDiffFile>> &getFiles() const;
+            // File of path, old path is matched for deleted file, nullptr if not found
+            std::shared_ptr<GitDiffFile> getFile(const std::wstring &filePath) const;
+            size_t getBufferSize() const;
+
+            std::wstring getText(const size_t &offset, const size_t &length) const;
+            std::wstring getFileText(const GitDiffFile *file) const;
+            std::wstring getHunkText(const GitDiffHunk *hunk) const;
+            // GitDifference of file with text of all hunks
+            std::shared_ptr<GitDifference> getDifference(const GitDiffFile *file) const;
+    };
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "git_service.hpp"
+
+namespace vcc
+{
+    // Lane layout of commit graph from hash id and parent hash ids, without git log --graph
+    // Logs must be added in git log order (child before parent), layout is continued page by page
+    // Each parent of commit gets its own lane, lanes of the same parent join at the row of parent
+    class GitLogGraph
+    {
+        private:
+            // hash id expected by each lane, empty if lane is free
+            std::vector<std::wstring> _Lanes;
+
+            int64_t findLane(const std::wstring &hashID) const;
+            int64_t findFreeLane() const;
+            // Update lanes for commit and return lane of commit, edges are filled if not nullptr
+            int64_t layout(const std::wstring &hashID, const std::vector<std::wstring> &parentHashIDs, std::vector<int64_t> *incomingColumnIndexes, std::vector<int64_t> *outgoingColumnIndexes);
+
+        public:
+            GitLogGraph() {}
+            ~GitLogGraph() {}
+
+            // State after last added commit, can be saved to continue layout from that commit later
+            const std::vector<std::wstring> &getLanes() const;
+            void setLanes(const std::vector<std::wstring> &lanes);
+            void clear();
+
+            // Set ColumnIndex, GraphIncomingColumnIndexes and GraphOutgoingColumnIndexes of log
+            void addLog(std::shared_ptr<GitLog> log);
+            void addLogs(const std::vector<std::shared_ptr<GitLog>> &logs);
+            // Update lanes only, for commits not kept in memory
+            void addCommit(const std::wstring &hashID, const std::vector<std::wstring> &parentHashIDs);
+    };
+}
@@ -1,11 +1,18 @@
 #pragma once
 
+#include <functional>
+#include <future>
+#include <list>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <vector>
 
 #include "base_manager.hpp"
 #include "class_macro.hpp"
+#include "git_object_session.hpp"
 #include "git_service.hpp"
 
 namespace vcc
@@ -14,21 +21,79 @@ namespace vcc
     {
         GETSET(std::wstring, Workspace, L"")
         VECTOR_SPTR(GitLog, GitLog)
+        // Log page cache, number of pages kept in memory including prefetched page
+        GETSET(int64_t, LogPageCacheSize, 4)
+        GETSET(bool, IsLogPagePrefetch, true)
+        // Keep result of tags, branches, remotes and config until .git/HEAD, .git/packed-refs, .git/config, .git/refs/ or global config is changed
+        GETSET(bool, IsResultCache, true)
        
         private:
+            std::mutex _ResultCacheMutex;
+            // path, modified time and size of files that results depend on
+            std::wstring _ResultCacheStamp = L"";
+            // directories under .git/refs, listed again only if their stamp is changed
+            std::vector<std::wstring> _ResultCacheRefDirectories;
+            std::wstring _ResultCacheRefDirectoryStamp = L"";
+            std::map<std::wstring, std::vector<std::wstring>> _CachedTags;
+            std::shared_ptr<GitTagCurrentTag> _CachedCurrentTag = nullptr;
+            std::optional<std::wstring> _CachedCurrentBranchName;
+            std::optional<std::vector<std::shared_ptr<GitBranch>>> _CachedBranches;
+            std::optional<std::vector<std::shared_ptr<GitRemote>>> _CachedRemotes;
+            std::shared_ptr<GitConfig> _CachedConfig = nullptr;
+            std::map<std::wstring, std::wstring> _CachedConfigValues;
+            std::shared_ptr<GitConfig> _CachedGlobalConfig = nullptr;
+            std::map<std::wstring, std::wstring> _CachedGlobalConfigValues;
+
+            mutable std::mutex _LogPageMutex;
+            std::shared_ptr<GitLogSearchCriteria> _LogPageSearchCriteria = nullptr;
+            std::shared_ptr<CancellationToken> _LogPageCancellationToken = std::make_shared<CancellationToken>();
+            int64_t _LogPageSize = -1;
+            // key is offset
+            std::map<int64_t, std::shared_future<std::vector<std::shared_ptr<GitLog>>>> _LogPages;
+            // least recently used first
+            std::list<int64_t> _LogPageOrder;
+            // lanes of commit graph before row of key, to lay out any page without previous pages in memory
+            // layout runs outside lock and publishes lanes only if generation is not changed by clearLogPageCache
+            std::mutex _LogGraphMutex;
+            std::map<int64_t, std::vector<std::wstring>> _LogGraphLanes;
+            int64_t _LogGraphGeneration = 0;
+
+            mutable std::mutex _ObjectSessionMutex;
+            mutable std::shared_ptr<GitObjectSession> _ObjectSession = nullptr;
+            mutable std::wstring _ObjectSessionWorkspace = L"";
+
             void validate() const;
+
+            // Must be called with _ResultCacheMutex locked
+            std::wstring getResultCacheStamp();
+            // Clear cached results if stamp is changed, return false if result cannot be cached
+            // Must be called with _ResultCacheMutex locked
+            bool checkResultCache();
+
+            std::vector<std::shared_ptr<GitLog>> loadLogPage(const int64_t &offset, const int64_t &count, std::shared_ptr<GitLogSearchCriteria> searchCriteria, std::shared_ptr<CancellationToken> cancellationToken);
+            void layoutLogPage(const int64_t &offset, const int64_t &count, const std::vector<std::shared_ptr<GitLog>> &logs, std::shared_ptr<GitLogSearchCriteria> searchCriteria, std::shared_ptr<CancellationToken> cancellationToken);
+            void touchLogPage(const int64_t &offset);
+            // Evicted pages are moved to discardedPages, destroy it after _LogPageMutex is released as future of std::async waits for loading
+            void evictLogPages(const int64_t &requestedOffset, const int64_t &prefetchOffset, std::vector<std::shared_future<std::vector<std::shared_ptr<GitLog>>>> &discardedPages);
         public:
             GitManager(std::shared_ptr<LogConfig> logConfig, const std::wstring &workspace = L"");
-            ~GitManager() {}
+            ~GitManager();
             
             // General
             std::wstring getVersion() const;
+            // Operations of GitManager clear cache, call it after changing repository outside GitManager in the same file system tick
+            void clearResultCache();
             bool IsGitResponse() const;
             std::shared_ptr<GitStatus> getStatus(const GitStatusSearchCriteria *searchCriteria = nullptr) const;
 
             // Initialize
             void initializeGitResponse();
-            void cloneGitResponse(const std::wstring &url, const GitCloneOption *option = nullptr);
+            void cloneGitResponse(const std::wstring &url, const GitCloneOption *option = nullptr, const CancellationToken *cancellationToken = nullptr, const std::function<void(const GitProgress *)> &onProgress = nullptr);
+
+            // Object
+            // "git cat-file --batch" session owned by manager, read commits, trees and blobs without a git process per object
+            // Started on first request and closed when manager is destroyed
+            std::shared_ptr<GitObjectSession> getObjectSession() const;
 
             /*-----------------------------------*
             * ----------- Remote     -----------*
@@ -39,11 +104,11 @@ namespace vcc
             void RenameRemote(const std::wstring &oldName, const std::wstring &newName);
             void RemoveRemote(const std::wstring &name);
             // fetch
-            void FetchAll();
+            void FetchAll(const CancellationToken *cancellationToken = nullptr, const std::function<void(const GitProgress *)> &onProgress = nullptr);
             // pull
-            void Pull(const GitPullOption *option = nullptr);
+            void Pull(const GitPullOption *option = nullptr, const CancellationToken *cancellationToken = nullptr, const std::function<void(const GitProgress *)> &onProgress = nullptr);
             // push
-            void Push(const GitPushOption *option = nullptr);
+            void Push(const GitPushOption *option = nullptr, const CancellationToken *cancellationToken = nullptr, const std::function<void(const GitProgress *)> &onProgress = nullptr);
 
             /*-----------------------------------*
             * -----------  WorkTree  -----------*
@@ -53,8 +118,15 @@ namespace vcc
             /*-----------------------------------*
             * -----------   Log      -----------*
             * ----------------------------------*/
-            // To draw graph, mark the point by column index first, then link nodes if having same ParentHashID and HashID
-            std::vector<std::shared_ptr<GitLog>> getLogs(const GitLogSearchCriteria *searchCriteria);
+            // Graph is laid out from first log, see ColumnIndex, GraphIncomingColumnIndexes and GraphOutgoingColumnIndexes of GitLog
+            std::vector<std::shared_ptr<GitLog>> getLogs(const GitLogSearchCriteria *searchCriteria, const CancellationToken *cancellationToken = nullptr);
+            // Paged history, only pages in cache are kept in memory and next page is loaded in background
+            // Graph of page continues from previous rows, lanes are saved at page boundary and rows before unknown boundary are read as hash id and parents only
+            // LogCount and Skip of search criteria limit the whole history, cache is cleared when search criteria is set
+            void setLogPageSearchCriteria(const GitLogSearchCriteria *searchCriteria);
+            std::vector<std::shared_ptr<GitLog>> getLogPage(const int64_t &offset, const int64_t &count);
+            size_t getCachedLogPageCount() const;
+            void clearLogPageCache();
             
             /*-----------------------------------*
             * -----------    Tag     -----------*
@@ -100,6 +172,8 @@ namespace vcc
             std::shared_ptr<GitDifference> getDifferenceWorkingFile(const std::wstring &filePath, const GitDifferentSearchCriteria *searchCriteria = nullptr);
             std::shared_ptr<GitDifference> getDifferenceFile(const std::wstring &filePath, const GitDifferentSearchCriteria *searchCriteria = nullptr);
             std::shared_ptr<GitDifference> getDifferenceCommit(const std::wstring &fromHashID, const std::wstring &toHashID, const std::wstring &filePath, const GitDifferentSearchCriteria *searchCriteria = nullptr);
+            // One git diff for all files, see GitService::getDifferences
+            std::vector<std::shared_ptr<GitDifference>> getDifferences(const std::vector<std::wstring> &filePaths, const GitDifferentSearchCriteria *searchCriteria = nullptr, const CancellationToken *cancellationToken = nullptr);
 
             /*-----------------------------------*
             * ----------    Blame    -----------*
@@ -121,6 +195,13 @@ namespace vcc
             void Commit(const std::wstring &command);
             void Amend();
 
+            /*-----------------------------------*
+            * ----------- Config     -----------*
+            * ----------------------------------*/
+            void getConfig(std::shared_ptr<GitConfig> config);
+            std::wstring getConfig(const std::wstring &key);
+            void getGlobalConfig(std::shared_ptr<GitConfig> config);
+            std::wstring getGlobalConfig(const std::wstring &key);
 
         /*-----------------------------------*
          * ----------Reset/Restore-----------*
@@ -140,8 +221,6 @@ namespace vcc
         //  * ----------------------------------*/
         // // Overall Config
         // bool IsConfigExists(const std::wstring &key);
-        // void getConfig(std::shared_ptr<GitConfig> config);
-        // std::wstring getConfig(const std::wstring &key);
         // std::wstring getUserName();
         // std::wstring getUserEmail();
         
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "base_manager.hpp"
+#include "base_object.hpp"
+#include "cancellation_token.hpp"
+#include "class_macro.hpp"
+#include "git_manager.hpp"
+#include "git_service.hpp"
+#include "log_config.hpp"
+
+namespace vcc
+{
+    enum class GitRepositoryOperation
+    {
+        Fetch,
+        Pull,
+        Status
+    };
+
+    class GitRepositoryResult : public BaseObject
+    {
+        GETSET(std::wstring, Workspace, L"");
+        GETSET(GitRepositoryOperation, Operation, GitRepositoryOperation::Status);
+        GETSET(bool, IsSuccess, false);
+        GETSET(bool, IsCancelled, false); // not started or killed because of cancellation
+        GETSET(std::wstring, Error, L"");
+        GETSET_SPTR_NULL(GitStatus, Status); // Status operation only
+
+        public:
+            GitRepositoryResult() : BaseObject() {}
+            virtual ~GitRepositoryResult() {}
+
+            virtual std::shared_ptr<IObject> clone() const override
+            {
+                auto obj = std::make_shared<GitRepositoryResult>(*this);
+                if (_Status != nullptr)
+                    obj->setStatus(std::dynamic_pointer_cast<GitStatus>(_Status->clone()));
+                return obj;
+            }
+    };
+
+    class GitRepositoryProgress : public BaseObject
+    {
+        GETSET(int64_t, TotalCount, 0);
+        GETSET(int64_t, CompletedCount, 0);
+        GETSET(int64_t, FailedCount, 0);
+        GETSET_SPTR_NULL(GitRepositoryResult, Result); // repository just completed
+
+        public:
+            GitRepositoryProgress() : BaseObject() {}
+            virtual ~GitRepositoryProgress() {}
+
+            virtual std::shared_ptr<IObject> clone() const override
+            {
+                auto obj = std::make_shared<GitRepositoryProgress>(*this);
+                if (_Result != nullptr)
+                    obj->setResult(std::dynamic_pointer_cast<GitRepositoryResult>(_Result->clone()));
+                return obj;
+            }
+    };
+
+    // Fetch, pull or query status of several repositories concurrently, at most Parallelism repositories at the same time
+    // Each repository has its own GitManager, failure of one repository does not stop the others and is returned in its result
+    class GitMultiRepositoryManager : public BaseManager
+    {
+        GETSET(int64_t, Parallelism, 4)
+
+        private:
+            mutable std::mutex _Mutex;
+            std::vector<std::shared_ptr<GitManager>> _GitManagers;
+
+            // action runs operation of one repository and throws on failure
+            std::vector<std::shared_ptr<GitRepositoryResult>> execute(const GitRepositoryOperation &operation, const std::function<void(GitManager *, GitRepositoryResult *)> &action,
+                const std::function<void(const GitRepositoryProgress *)> &onProgress, const CancellationToken *cancellationToken);
+
+        public:
+            GitMultiRepositoryManager(std::shared_ptr<LogConfig> logConfig) : BaseManager(logConfig) {}
+            ~GitMultiRepositoryManager() {}
+
+            // .git exists in workspace, git command in other directory runs on repository containing it
+            static bool isRepositoryRoot(const std::wstring &workspace);
+            // Direct sub directories of directory which are git repositories, sorted by path
+            static std::vector<std::wstring> findRepositories(const std::wstring &directory);
+            // "workspace: error" of failed repositories separated by line break, empty if all succeeded
+            static std::wstring getErrorMessage(const std::vector<std::shared_ptr<GitRepositoryResult>> &results);
+
+            // Workspace already added is ignored, throw if workspace is not repository root, see isRepositoryRoot
+            void addWorkspace(const std::wstring &workspace);
+            // Share existing GitManager, e.g. of form, so that its result cache is cleared after pull, same check as addWorkspace
+            void addGitManager(std::shared_ptr<GitManager> gitManager);
+            // Add all repositories found by findRepositories
+            void addWorkspaces(const std::wstring &directory);
+            void clearWorkspaces();
+            std::vector<std::wstring> getWorkspaces() const;
+            std::shared_ptr<GitManager> getGitManager(const std::wstring &workspace) const;
+
+            // Results are in the same order as workspaces
+            // onProgress is called once per repository after it is completed, calls are serialized but may come from any worker thread
+            // Repositories not started yet are skipped after cancellationToken is cancelled, no exception is thrown
+            std::vector<std::shared_ptr<GitRepositoryResult>> FetchAll(const std::function<void(const GitRepositoryProgress *)> &onProgress = nullptr, const CancellationToken *cancellationToken = nullptr);
+            std::vector<std::shared_ptr<GitRepositoryResult>> Pull(const GitPullOption *option = nullptr, const std::function<void(const GitRepositoryProgress *)> &onProgress = nullptr, const CancellationToken *cancellationToken = nullptr);
+            std::vector<std::shared_ptr<GitRepositoryResult>> getStatus(const GitStatusSearchCriteria *searchCriteria = nullptr, const std::function<void(const GitRepositoryProgress *)> &onProgress = nullptr, const CancellationToken *cancellationToken = nullptr);
+    };
+}
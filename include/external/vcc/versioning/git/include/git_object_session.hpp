@@ -0,0 +1,78 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "base_object.hpp"
+#include "class_macro.hpp"
+#include "log_config.hpp"
+#include "process_session.hpp"
+
+namespace vcc
+{
+    class GitObject : public BaseObject
+    {
+        GETSET(std::wstring, Name, L""); // object name in request, e.g. HEAD, hash id, HEAD:path
+        GETSET(std::wstring, HashID, L"");
+        GETSET(std::wstring, Type, L""); // blob, tree, commit, tag
+        GETSET(int64_t, Size, -1);
+        GETSET(bool, IsMissing, false);
+        GETSET(std::string, Content, ""); // raw bytes, empty for object info only
+
+        public:
+            GitObject() : BaseObject() {}
+            virtual ~GitObject() {}
+
+            virtual std::shared_ptr<IObject> clone() const override
+            {
+                return std::make_shared<GitObject>(*this);
+            }
+    };
+
+    // Keep one "git cat-file --batch" and one "git cat-file --batch-check" process per workspace, started on first request
+    // Requests from different threads are serialized, process is restarted if it exits
+    // Windows falls back to one git process per object
+    class GitObjectSession
+    {
+        private:
+            static std::mutex _SessionsMutex;
+            static std::map<std::wstring, std::shared_ptr<GitObjectSession>> _Sessions;
+
+            std::shared_ptr<LogConfig> _LogConfig = nullptr;
+            std::wstring _Workspace = L"";
+            std::mutex _Mutex;
+            std::unique_ptr<ProcessSession> _BatchSession = nullptr;
+            std::unique_ptr<ProcessSession> _BatchCheckSession = nullptr;
+
+            std::vector<std::shared_ptr<GitObject>> _Request(const std::vector<std::wstring> &names, const bool &isWithContent);
+            #ifdef _WIN32
+            std::shared_ptr<GitObject> _RequestByProcess(const std::wstring &name, const bool &isWithContent);
+            #endif
+
+        public:
+            GitObjectSession(std::shared_ptr<LogConfig> logConfig, const std::wstring &workspace);
+            ~GitObjectSession();
+
+            GitObjectSession(const GitObjectSession &) = delete;
+            GitObjectSession &operator=(const GitObjectSession &) = delete;
+
+            // Shared session of workspace
+            static std::shared_ptr<GitObjectSession> getSession(std::shared_ptr<LogConfig> logConfig, const std::wstring &workspace);
+            static void closeSession(const std::wstring &workspace);
+            static void closeAllSessions();
+
+            // "<oid> <type> <size>" and "<name> missing" / "<name> ambiguous"
+            static void parseObjectHeader(const std::wstring &name, const std::string &header, std::shared_ptr<GitObject> object);
+
+            std::shared_ptr<GitObject> getObject(const std::wstring &name);
+            std::shared_ptr<GitObject> getObjectInfo(const std::wstring &name);
+            // Requests are pipelined, result is in the same order as names
+            std::vector<std::shared_ptr<GitObject>> getObjects(const std::vector<std::wstring> &names);
+            std::vector<std::shared_ptr<GitObject>> getObjectInfos(const std::vector<std::wstring> &names);
+
+            void close();
+    };
+}
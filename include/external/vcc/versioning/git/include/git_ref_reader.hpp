@@ -0,0 +1,50 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base_object.hpp"
+#include "class_macro.hpp"
+
+namespace vcc
+{
+    class GitRef : public BaseObject
+    {
+        GETSET(std::wstring, Name, L""); // full name, e.g. refs/heads/main
+        GETSET(std::wstring, HashID, L""); // empty if symbolic
+        GETSET(std::wstring, SymbolicRef, L""); // e.g. refs/remotes/origin/main of refs/remotes/origin/HEAD
+        // Commit of annotated tag from packed-refs, only valid if IsPeeled
+        // IsPeeled and PeeledHashID is empty means ref does not point to tag object
+        GETSET(std::wstring, PeeledHashID, L"");
+        GETSET(bool, IsPeeled, false);
+
+        public:
+            GitRef() : BaseObject() {}
+            virtual ~GitRef() {}
+
+            virtual std::shared_ptr<IObject> clone() const override
+            {
+                return std::make_shared<GitRef>(*this);
+            }
+    };
+
+    // Read refs from .git/HEAD, .git/packed-refs and loose refs under .git/refs without git process
+    // Return false if repository layout is not supported (e.g. linked worktree, reftable, GIT_DIR, broken ref), then use git command instead
+    class GitRefReader
+    {
+        public:
+            GitRefReader() {}
+            ~GitRefReader() {}
+
+            // Git directory of repository containing workspace, empty if not supported
+            static std::wstring getGitDirectory(const std::wstring &workspace);
+
+            // symbolicRef is empty if HEAD is detached, hashID is empty if branch has no commit
+            static bool getHead(const std::wstring &workspace, std::wstring &symbolicRef, std::wstring &hashID);
+            // Refs starting with prefix (e.g. refs/tags/), sorted by name, loose ref overrides packed ref
+            static bool getRefs(const std::wstring &workspace, const std::wstring &prefix, std::vector<std::shared_ptr<GitRef>> &refs);
+            // Hash id of full ref name, symbolic ref is followed, hashID is empty if ref not exists
+            static bool resolveRef(const std::wstring &workspace, const std::wstring &name, std::wstring &hashID);
+    };
+}
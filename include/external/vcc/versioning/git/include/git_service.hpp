@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 
 #ifdef _WIN32
@@ -8,16 +9,25 @@
 
 #include "base_object.hpp"
 #include "base_service.hpp"
+#include "cancellation_token.hpp"
 #include "class_macro.hpp"
 #include "log_config.hpp"
 
 namespace vcc
 {
+    class GitObjectSession;
+
     constexpr auto GIT_LOG_ID = L"GIT";
+    // Record separator, hash id, tree hash id, parent hash ids, decoration, author, committer and raw message separated by unit separator, end with group separator
+    constexpr auto GIT_LOG_RECORD_FORMAT = L"%x1e%H%x1f%h%x1f%T%x1f%t%x1f%P%x1f%p%x1f%D%x1f%an%x1f%ae%x1f%ad%x1f%cn%x1f%ce%x1f%cd%x1f%B%x1d";
 
     class GitStatusSearchCriteria : public BaseObject
     {
         GETSET(bool, IsWithIgnoreFiles, false);
+        // git --no-optional-locks, status does not refresh and write index
+        GETSET(bool, IsNoOptionalLocks, false);
+        // Limit to paths relative to workspace, empty means whole working tree
+        VECTOR(std::wstring, Paths);
         public:
             GitStatusSearchCriteria() : BaseObject() {}
             virtual ~GitStatusSearchCriteria() {}
@@ -30,8 +40,13 @@ namespace vcc
     
     class GitCloneOption : public BaseObject
     {
-        GETSET(std::wstring, Branch, L"");
-        GETSET(int64_t, Depth, -1);
+        GETSET(std::wstring, Branch, L""); // branch or tag, HEAD is detached for tag
+        GETSET(int64_t, Depth, -1); // shallow clone, -1 means whole history
+        GETSET(bool, IsSingleBranch, false); // only fetch history of Branch or default branch, always true if Depth is set
+        GETSET(std::wstring, Filter, L""); // partial clone, e.g. blob:none downloads file content on checkout only
+        GETSET(std::wstring, Directory, L""); // directory under workspace, empty means name of repository in url
+        // Sparse checkout in cone mode, only files in root and these directories are checked out, empty means all
+        VECTOR(std::wstring, SparseCheckoutPaths);
         GETSET(bool, IsQuiet, false);
         
         public:
@@ -44,6 +59,29 @@ namespace vcc
             }
     };
 
+    // Progress of clone, fetch, pull and push from stderr of git --progress
+    // e.g. "Receiving objects:  45% (450/1000), 1.20 MiB | 2.40 MiB/s", "remote: Enumerating objects: 1234, done."
+    class GitProgress : public BaseObject
+    {
+        GETSET(std::wstring, Phase, L""); // e.g. Receiving objects, Resolving deltas
+        GETSET(bool, IsRemote, false); // phase runs on remote, line starts with "remote: "
+        GETSET(int64_t, Percent, -1); // -1 if total is unknown
+        GETSET(int64_t, Current, 0); // objects, deltas or files
+        GETSET(int64_t, Total, -1); // -1 if unknown
+        GETSET(std::wstring, Transferred, L""); // e.g. 1.20 MiB
+        GETSET(std::wstring, Throughput, L""); // e.g. 2.40 MiB/s
+        GETSET(bool, IsDone, false);
+
+        public:
+            GitProgress() : BaseObject() {}
+            virtual ~GitProgress() {}
+
+            virtual std::shared_ptr<IObject> clone() const override
+            {
+                return std::make_shared<GitProgress>(*this);
+            }
+    };
+
     enum class GitFileStatus
     {
         NA,
@@ -232,6 +270,11 @@ namespace vcc
         GETSET(std::wstring, Title, L"");
         GETSET(std::wstring, Message, L"");
         GETSET(std::wstring, FullMessage, L"");
+        // Lane layout by GitLogGraph, ColumnIndex is lane of commit
+        // Incoming: for each lane at top of row, lane of commit it joins, -1 if lane is free
+        // Outgoing: for each lane at bottom of row, lane of commit it starts from, -1 if lane is free
+        VECTOR(int64_t, GraphIncomingColumnIndexes);
+        VECTOR(int64_t, GraphOutgoingColumnIndexes);
 
         public:
             GitLog() : BaseObject() {}
@@ -243,6 +286,26 @@ namespace vcc
             }
     };
 
+    // Parse output of git log --pretty=tformat:GIT_LOG_RECORD_FORMAT line by line, graph is laid out by GitLogGraph instead
+    // Text before record separator is ignored and removed from message lines by its width, so output of git log --graph is parsed too
+    class GitLogRecordParser
+    {
+        private:
+            std::shared_ptr<GitLog> _Log = nullptr;
+            size_t _GraphWidth = 0;
+            std::wstring _FullMessage = L"";
+
+            void parseHeader(const std::wstring &line, const size_t &pos);
+            void parseMessage(const std::wstring &message);
+
+        public:
+            GitLogRecordParser() {}
+            ~GitLogRecordParser() {}
+
+            // Return log when end of commit is reached, otherwise nullptr
+            std::shared_ptr<GitLog> parseLine(const std::wstring &line);
+    };
+
     class GitTagSearchCriteria : public BaseObject
     {
         GETSET(std::wstring, Contains, L"");
@@ -362,6 +425,8 @@ namespace vcc
     {
         GETSET(int64_t, NoOfLines, -1);
         VECTOR(std::wstring, HashIDs);
+        // git diff --cached, index instead of working files
+        GETSET(bool, IsCached, false);
 
         public:
             GitDifferentSearchCriteria() : BaseObject() {}
@@ -449,25 +514,36 @@ namespace vcc
             static std::wstring getVersion(const LogConfig *logConfig);
             static bool IsGitResponse(const LogConfig *logConfig, const std::wstring &workspace);
             static std::shared_ptr<GitStatus> getStatus(const LogConfig *logConfig, const std::wstring &workspace, const GitStatusSearchCriteria *searchCriteria = nullptr);
+            // Untracked directories ignored as a whole, e.g. L"bin/", directory containing tracked file is not included
+            static std::vector<std::wstring> getIgnoredDirectories(const LogConfig *logConfig, const std::wstring &workspace);
+            // Path relative to workspace is ignored by .gitignore, .git/info/exclude or core.excludesFile
+            static bool isIgnored(const LogConfig *logConfig, const std::wstring &workspace, const std::wstring &path);
 
             // Initialize
             static void initializeGitResponse(const LogConfig *logConfig, const std::wstring &workspace);
-            static void cloneGitResponse(const LogConfig *logConfig, const std::wstring &workspace, const std::wstring &url, const GitCloneOption *option = nullptr);
+            // Directory of repository cloned by git clone without directory, e.g. "b" of "https://a/b.git"
+            static std::wstring getCloneDirectory(const std::wstring &url);
+            // onProgress is called in the same thread for each progress line of git --progress, no progress if IsQuiet
+            static void cloneGitResponse(const LogConfig *logConfig, const std::wstring &workspace, const std::wstring &url, const GitCloneOption *option = nullptr, const CancellationToken *cancellationToken = nullptr, const std::function<void(const GitProgress *)> &onProgress = nullptr);
 
             /*-----------------------------------*
             * ----------- Remote     -----------*
             * ----------------------------------*/
             // remote
+            // Note: Network operation can be cancelled by cancellationToken, child git process is terminated
+            // onProgress of network operation is called in the same thread for each progress line of git --progress
             static std::vector<std::shared_ptr<GitRemote>> getRemote(const LogConfig *logConfig, const std::wstring &workspace);
             static void AddRemote(const LogConfig *logConfig, const std::wstring &workspace, const std::wstring &name, const std::wstring &url, const GitRemoteMirror &mirror = GitRemoteMirror::NA);
             static void RenameRemote(const LogConfig *logConfig, const std::wstring &workspace, const std::wstring &oldName, const std::wstring &newName);
             static void RemoveRemote(const LogConfig *logConfig, const std::wstring &workspace, const std::wstring &name);
             // fetch
-            static void FetchAll(const LogConfig *logConfig, const std::wstring &workspace);
+            static void FetchAll(const LogConfig *logConfig, const std::wstring &workspace, const CancellationToken *cancellationToken = nullptr, const std::function<void(const GitProgress *)> &onProgress = nullptr);
             // pull
-            static void Pull(const LogConfig *logConfig, const std::wstring &workspace, const GitPullOption *option = nullptr);
+            static void Pull(const LogConfig *logConfig, const std::wstring &workspace, const GitPullOption *option = nullptr, const CancellationToken *cancellationToken = nullptr, const std::function<void(const GitProgress *)> &onProgress = nullptr);
             // push
-            static void Push(const LogConfig *logConfig, const std::wstring &workspace, const GitPushOption *option = nullptr);
+            static void Push(const LogConfig *logConfig, const std::wstring &workspace, const GitPushOption *option = nullptr, const CancellationToken *cancellationToken = nullptr, const std::function<void(const GitProgress *)> &onProgress = nullptr);
+            // Parse one progress line without carriage return, return false if line is not progress, e.g. "fatal: ..."
+            static bool parseGitProgress(const std::wstring &line, std::shared_ptr<GitProgress> progress);
 
             /*-----------------------------------*
             * -----------  WorkTree  -----------*
@@ -479,21 +555,34 @@ namespace vcc
             * ----------------------------------*/
             // only parse git log --graph --oneline --pretty=format:"(%H)(%h)(%T)(%t)(%P)(%p)"
             static std::vector<std::shared_ptr<GitLog>> parseGitLogGraph(const std::wstring &str);
+            // parse one line of above, return nullptr if line has no commit
+            static std::shared_ptr<GitLog> parseGitLogGraphLine(const std::wstring &line);
             // only parse pattern L"Thu Jan 25 22:47:35 2024 +0800"
             static time_t parseGitLogDatetime(const std::wstring &datimeStr);
             static void parseGitLog(const std::wstring &str, std::shared_ptr<GitLog> log);
-            // To draw graph, mark the point by column index first, then link nodes if having same ParentHashID and HashID
-            static std::vector<std::shared_ptr<GitLog>> getLogs(const LogConfig *logConfig, const std::wstring &workspace, const GitLogSearchCriteria *searchCriteria = nullptr);
+            // only parse git log --pretty=tformat:GIT_LOG_RECORD_FORMAT, see GitLogRecordParser
+            static std::vector<std::shared_ptr<GitLog>> parseGitLogRecords(const std::wstring &str);
+            // Graph is laid out by GitLogGraph from first log if history is read from head, i.e. Skip is not set and not Reverse,
+            // see ColumnIndex, GraphIncomingColumnIndexes and GraphOutgoingColumnIndexes of GitLog
+            // Otherwise lanes before first log are unknown and graph is not laid out, see GitManager::getLogPage
+            static std::vector<std::shared_ptr<GitLog>> getLogs(const LogConfig *logConfig, const std::wstring &workspace, const GitLogSearchCriteria *searchCriteria = nullptr, const CancellationToken *cancellationToken = nullptr);
+            // Same as getLogs without graph layout, for caller laying out with its own lanes
+            static std::vector<std::shared_ptr<GitLog>> getLogRecords(const LogConfig *logConfig, const std::wstring &workspace, const GitLogSearchCriteria *searchCriteria = nullptr, const CancellationToken *cancellationToken = nullptr);
+            // Hash id and parent hash ids only, to continue graph layout without loading logs
+            static void getLogParents(const LogConfig *logConfig, const std::wstring &workspace, const GitLogSearchCriteria *searchCriteria, const std::function<void(const std::wstring &, const std::vector<std::wstring> &)> &onCommit, const CancellationToken *cancellationToken = nullptr);
             static std::shared_ptr<GitLog> getCurrentLog(const LogConfig *logConfig, const std::wstring &workspace);
             //static void getLog(const LogConfig *logConfig, const std::wstring &workspace, const std::wstring &hashID, std::shared_ptr<GitLog> log);
             
             /*-----------------------------------*
             * -----------    Tag     -----------*
             * ----------------------------------*/
+            // Tags without search criteria are read from refs by GitRefReader, current tag is read from refs if HEAD is tagged by exactly one tag
             static std::vector<std::wstring> getTags(const LogConfig *logConfig, const std::wstring &workspace, const GitTagSearchCriteria *searchCriteria = nullptr);
             // Note: There is bug for Git, if using process, return string does not have branch and tags " (HEAD -> main, tag: v0.0.1)" after commit Hash ID. But it is normal if using terminal
             //static void getTag(const LogConfig *logConfig, const std::wstring &workspace, const std::wstring &tagName, std::shared_ptr<GitLog> log);
             static std::shared_ptr<GitTagCurrentTag> getCurrentTag(const LogConfig *logConfig, const std::wstring &workspace);
+            // Check tag of remote by git ls-remote without clone, throw if remote cannot be read
+            static bool isRemoteTagExists(const LogConfig *logConfig, const std::wstring &workspace, const std::wstring &url, const std::wstring &tagName);
             static void CreateTag(const LogConfig *logConfig, const std::wstring &workspace, const std::wstring &tagName, const GitTagCreateTagOption *option = nullptr);
             // Window behavior and Linux Behavior different, Window throw exception (tag will detach branch) while Linux will not
             // Can use GitService::SwitchReverse to switch back
@@ -511,8 +600,10 @@ namespace vcc
             // 3. L"  head -> orgin/master"
             static void ParseGitBranch(const std::wstring &str, std::shared_ptr<GitBranch> branch);
             // static void getCurrentBranch(const LogConfig *logConfig, const std::wstring &workspace, std::shared_ptr<GitBranch> branch);
+            // Branch name and branches are read from refs by GitRefReader, git command is used if repository layout is not supported
+            // HashID of branch is full hash id, title is read by objectSession, or by GitObjectSession closed before return if nullptr
             static std::wstring getCurrentBranchName(const LogConfig *logConfig, const std::wstring &workspace);
-            static std::vector<std::shared_ptr<GitBranch>> getBranches(const LogConfig *logConfig, const std::wstring &workspace);
+            static std::vector<std::shared_ptr<GitBranch>> getBranches(const LogConfig *logConfig, const std::wstring &workspace, GitObjectSession *objectSession = nullptr);
             static void CreateBranch(const LogConfig *logConfig, const std::wstring &workspace,  const std::wstring &branchName, const GitBranchCreateBranchOption *option = nullptr);
             static void SwitchBranch(const LogConfig *logConfig, const std::wstring &workspace, const std::wstring &branchName, const GitBranchSwitchBranchOption *option = nullptr);
             static void RenameBranch(const LogConfig *logConfig, const std::wstring &workspace, const std::wstring &oldBranchName, const std::wstring &newBranchName, bool isForce = false);
@@ -537,12 +628,19 @@ namespace vcc
             // hashIDs.size() == 1, then different from commit to current working files
             // hashIDs.size() > 1, then different between commit
             static std::shared_ptr<GitDifferenceSummary> getDifferenceSummary(const LogConfig *logConfig, const std::wstring &workspace, const std::vector<std::wstring> &hashIDs);
-            // filePath must be filled
+            // First file of diff, see GitDiffParser for diff of multiple files
             static std::shared_ptr<GitDifference> parseGitDiff(const std::wstring &str);
+            // Run git diff with streaming output parsed by GitDiffParser, return first file
+            static std::shared_ptr<GitDifference> executeGitDiff(const LogConfig *logConfig, const std::wstring &workspace, const std::wstring &command);
+            // filePath must be filled
             static std::shared_ptr<GitDifference> getDifferenceIndexFile(const LogConfig *logConfig, const std::wstring &workspace, const GitDifferentSearchCriteria *searchCriteria = nullptr);
             static std::shared_ptr<GitDifference> getDifferenceWorkingFile(const LogConfig *logConfig, const std::wstring &workspace, const std::wstring &filePath, const GitDifferentSearchCriteria *searchCriteria = nullptr);
             static std::shared_ptr<GitDifference> getDifferenceFile(const LogConfig *logConfig, const std::wstring &workspace, const std::wstring &filePath, const GitDifferentSearchCriteria *searchCriteria = nullptr);
             static std::shared_ptr<GitDifference> getDifferenceCommit(const LogConfig *logConfig, const std::wstring &workspace, const std::wstring &fromHashID, const std::wstring &toHashID, const std::wstring &filePath, const GitDifferentSearchCriteria *searchCriteria = nullptr);
+            // Differences of many files by one git diff instead of one process per file, filePaths empty means all changed files
+            // Result is one GitDifference per changed file in order of git output, unchanged file is not returned
+            // HashIDs of search criteria are the same as getDifferenceSummary
+            static std::vector<std::shared_ptr<GitDifference>> getDifferences(const LogConfig *logConfig, const std::wstring &workspace, const std::vector<std::wstring> &filePaths, const GitDifferentSearchCriteria *searchCriteria = nullptr, const CancellationToken *cancellationToken = nullptr);
 
             /*-----------------------------------*
             * ----------    Blame    -----------*
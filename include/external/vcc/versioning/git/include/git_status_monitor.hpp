@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+
+#include "class_macro.hpp"
+#include "git_service.hpp"
+#include "log_config.hpp"
+
+namespace vcc
+{
+    // Keep GitStatus of workspace up to date by watching working tree with inotify
+    // Changed paths are collected until no change for Debounce, then only these paths are queried by git status -- <paths>
+    // Change of .git/HEAD, .git/index, .git/packed-refs, any ref under .git/refs or .gitignore queries whole working tree
+    // Ignored directories such as build output are not watched, change inside them is not reported by git status
+    // Workspace must be root of working tree, without inotify (e.g. Windows) getStatus queries whole working tree every time
+    class GitStatusMonitor
+    {
+        GETSET(int64_t, Debounce, 200); // millisecond without change before query
+        GETSET(int64_t, MaxDelay, 2000); // millisecond, query even if paths keep changing
+        GETSET(int64_t, MaxDirtyPathCount, 256); // query whole working tree if more paths are changed
+
+        private:
+            struct GitStatusMonitorEntry
+            {
+                GitFileStatus IndexStatus = GitFileStatus::NA;
+                GitFileStatus WorkingTreeStatus = GitFileStatus::NA;
+            };
+
+            std::shared_ptr<LogConfig> _LogConfig = nullptr;
+            std::wstring _Workspace = L"";
+            std::shared_ptr<GitStatusSearchCriteria> _SearchCriteria = nullptr;
+            std::function<void(std::shared_ptr<GitStatus>)> _OnChanged = nullptr;
+
+            mutable std::mutex _Mutex;
+            std::wstring _Branch = L"";
+            std::wstring _RemoteBranch = L"";
+            // key is path in git status, e.g. "dir/", "a.txt -> b.txt"
+            std::map<std::wstring, GitStatusMonitorEntry> _Entries;
+            int64_t _QueryCount = 0;
+
+            std::atomic<bool> _IsRunning = false;
+            std::thread _Watcher;
+            int _InotifyFd = -1;
+            // watch descriptor to directory relative to workspace, "" is workspace
+            std::map<int, std::wstring> _WatchDirectories;
+            int _GitDirectoryWatch = -1;
+            // relative path without trailing "/", updated when .gitignore is changed
+            std::set<std::wstring> _IgnoredDirectories;
+
+            void loadIgnoredDirectories();
+            void addWatch(const std::wstring &relativeDirectory);
+            void addWatchRecursively(const std::wstring &relativeDirectory);
+            void run();
+
+            void refreshAll();
+            void refreshPaths(const std::set<std::wstring> &paths);
+            void applyStatus(std::shared_ptr<GitStatus> status);
+            std::shared_ptr<GitStatus> buildStatus() const;
+
+        public:
+            GitStatusMonitor(std::shared_ptr<LogConfig> logConfig, const std::wstring &workspace, const GitStatusSearchCriteria *searchCriteria = nullptr);
+            ~GitStatusMonitor();
+
+            GitStatusMonitor(const GitStatusMonitor &) = delete;
+            GitStatusMonitor &operator=(const GitStatusMonitor &) = delete;
+
+            // Called in watcher thread after status is changed
+            void setOnChanged(std::function<void(std::shared_ptr<GitStatus>)> onChanged);
+
+            // Query whole working tree and start watching
+            void start();
+            void stop();
+            bool isRunning() const;
+
+            // Cached status if watching, otherwise query whole working tree
+            std::shared_ptr<GitStatus> getStatus();
+            // Number of git status executed, for diagnosis
+            int64_t getQueryCount() const;
+            void refresh();
+    };
+}
@@ -14,6 +14,7 @@
 #include "vpg_git_log.hpp"
 
 // <vcc:customHeader sync="RESERVE" gen="RESERVE">
+#include <vector>
 // </vcc:customHeader>
 
 class VPGGitForm : public vcc::BaseForm, public vcc::BaseJsonObject
@@ -22,6 +23,7 @@ class VPGGitForm : public vcc::BaseForm, public vcc::BaseJsonObject
     MANAGER_SPTR_NULL(vcc::GitManager, GitManager, _LogConfig)
 
     // <vcc:customVPGGitFormProperties sync="RESERVE" gen="RESERVE">
+    GETSET(int64_t, LogPageSize, 100)
     // </vcc:customVPGGitFormProperties>
 
     private:
@@ -46,5 +48,7 @@ class VPGGitForm : public vcc::BaseForm, public vcc::BaseJsonObject
         virtual std::shared_ptr<vcc::IResult> doAction(const int64_t &formProperty, std::shared_ptr<vcc::IObject> argument) override;
 
         // <vcc:customVPGGitFormPublicFunctions sync="RESERVE" gen="RESERVE">
+        // History rows from firstRow, only pages of visible rows and next page are kept in GitManager
+        std::vector<std::shared_ptr<vcc::GitLog>> getVisibleLogs(const int64_t &firstRow, const int64_t &rowCount);
         // </vcc:customVPGGitFormPublicFunctions>
 };
@@ -18,6 +18,7 @@
 #include "vpg_workspace_form.hpp"
 
 // <vcc:customHeader sync="RESERVE" gen="RESERVE">
+#include "git_multi_repository_manager.hpp"
 // </vcc:customHeader>
 
 class VPGMainFormAddWorkspaceFormArgument : public vcc::BaseActionArgument
@@ -218,5 +219,7 @@ class VPGMainForm : public vcc::BaseForm, public vcc::BaseJsonObject
 
         // <vcc:customVPGMainFormPublicFunctions sync="RESERVE" gen="RESERVE">
         void saveConfig() const;
+        // Repositories of all git forms, fetch, pull and status run concurrently
+        std::shared_ptr<vcc::GitMultiRepositoryManager> getGitMultiRepositoryManager() const;
         // </vcc:customVPGMainFormPublicFunctions>
 };
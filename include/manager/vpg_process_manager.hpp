@@ -37,6 +37,8 @@ class VPGProcessManager : public vcc::BaseManager
         void initLogConfig();
         // Ensure VPG Generator have same version as Versioning Commond Codebase Response
         void verifyLocalResponse();
+        // Pull all repositories under local response folder concurrently
+        void pullLocalResponses();
 
         bool isUpdateAvaliable();
         
@@ -24,4 +24,6 @@ enum class VPGGitLogProperty
     , Title // GETSET(std::wstring, Title, L"") @@Inherit
     , Message // GETSET(std::wstring, Message, L"") @@Inherit
     , FullMessage // GETSET(std::wstring, FullMessage, L"") @@Inherit
+    , GraphIncomingColumnIndexes // VECTOR(int64_t, GraphIncomingColumnIndexes) @@Inherit
+    , GraphOutgoingColumnIndexes // VECTOR(int64_t, GraphOutgoingColumnIndexes) @@Inherit
 };
\ No newline at end of file
@@ -14,6 +14,8 @@
 #include "set_helper.hpp"
 
 // <vcc:customHeader sync="RESERVE" gen="RESERVE">
+#include "json_builder.hpp"
+#include "thread_manager.hpp"
 // </vcc:customHeader>
 
 void Application::initializeComponents()
@@ -273,4 +275,14 @@ bool Application::closeForm(vcc::IObject *form, const bool &isForce)
 }
 
 // <vcc:customApplicationFunctions sync="RESERVE" gen="RESERVE">
+std::wstring Application::getThreadManagerMetrics()
+{
+    TRY
+        if (application == nullptr || application->getThreadManager() == nullptr)
+            return L"";
+        auto jsonBuilder = std::make_unique<vcc::JsonBuilder>();
+        return application->getThreadManager()->getMetrics()->serializeJson(jsonBuilder.get());
+    CATCH
+    return L"";
+}
 // </vcc:customApplicationFunctions>
\ No newline at end of file
@@ -284,7 +284,7 @@ namespace vcc
         CATCH
     }
 
-    void copyDirectory(const std::wstring &srcDirectory, const std::wstring &destDirectory, const CopyDirectoryOption *option)
+    void copyDirectory(const std::wstring &srcDirectory, const std::wstring &destDirectory, const CopyDirectoryOption *option, const CancellationToken *cancellationToken)
     {
         assert(!isBlank(srcDirectory));
         assert(!isBlank(destDirectory));
@@ -292,6 +292,8 @@ namespace vcc
             bool isForce = option != nullptr && option->getIsForce();
             std::vector<std::wstring> srcFileList;
             for (auto &filePath : std::filesystem::recursive_directory_iterator(PATH(srcDirectory))) {
+                if (cancellationToken != nullptr)
+                    cancellationToken->throwIfCancelled();
                 if (option != nullptr && !option->getIsRecursive()) {
                     if (filePath.path().parent_path().wstring() != srcDirectory)
                         continue;
@@ -1,6 +1,7 @@
 #include "string_helper.hpp"
 
 #include <algorithm>
+#include <cstdint>
 #include <map>
 #include <math.h>
 #include <memory>
@@ -20,9 +21,43 @@ namespace vcc
 		if (str.empty())
 			return L"";
 		TRY
-			std::wstringstream wss;
-			wss << str.c_str();
-			return wss.str();
+			std::wstring wstr;
+			wstr.reserve(str.length());
+			size_t pos = 0;
+			while (pos < str.length()) {
+				uint8_t byte = (uint8_t)str[pos];
+				uint32_t codePoint = byte;
+				size_t continuation = 0;
+				if (byte >= 0xF0 && byte < 0xF5) {
+					codePoint = byte & 0x07;
+					continuation = 3;
+				} else if (byte >= 0xE0 && byte < 0xF0) {
+					codePoint = byte & 0x0F;
+					continuation = 2;
+				} else if (byte >= 0xC2 && byte < 0xE0) {
+					codePoint = byte & 0x1F;
+					continuation = 1;
+				}
+				size_t i = 1;
+				for (; i <= continuation && pos + i < str.length() && ((uint8_t)str[pos + i] & 0xC0) == 0x80; i++)
+					codePoint = (codePoint << 6) | ((uint8_t)str[pos + i] & 0x3F);
+				bool isValid = i > continuation
+					&& !(continuation == 2 && (codePoint < 0x800 || (codePoint >= 0xD800 && codePoint < 0xE000)))
+					&& !(continuation == 3 && (codePoint < 0x10000 || codePoint > 0x10FFFF));
+				// Byte which is not UTF-8 is kept as it is
+				if (!isValid) {
+					codePoint = byte;
+					i = 1;
+				}
+				if (sizeof(wchar_t) == 2 && codePoint >= 0x10000) {
+					codePoint -= 0x10000;
+					wstr += (wchar_t)(0xD800 | (codePoint >> 10));
+					wstr += (wchar_t)(0xDC00 | (codePoint & 0x3FF));
+				} else
+					wstr += (wchar_t)codePoint;
+				pos += i;
+			}
+			return wstr;
 		CATCH
 		return L"";
 	}
@@ -32,7 +67,32 @@ namespace vcc
 		if (wstr.empty())
 			return "";
 		TRY
-			std::string str(wstr.begin(), wstr.end());
+			std::string str;
+			str.reserve(wstr.length());
+			for (size_t pos = 0; pos < wstr.length(); pos++) {
+				uint32_t codePoint = (uint32_t)wstr[pos];
+				// UTF-16 surrogate pair if wchar_t is 16 bit
+				if (sizeof(wchar_t) == 2 && codePoint >= 0xD800 && codePoint < 0xDC00
+					&& pos + 1 < wstr.length() && (uint32_t)wstr[pos + 1] >= 0xDC00 && (uint32_t)wstr[pos + 1] < 0xE000) {
+					codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + ((uint32_t)wstr[pos + 1] - 0xDC00);
+					pos++;
+				}
+				if (codePoint < 0x80)
+					str += (char)codePoint;
+				else if (codePoint < 0x800) {
+					str += (char)(0xC0 | (codePoint >> 6));
+					str += (char)(0x80 | (codePoint & 0x3F));
+				} else if (codePoint < 0x10000) {
+					str += (char)(0xE0 | (codePoint >> 12));
+					str += (char)(0x80 | ((codePoint >> 6) & 0x3F));
+					str += (char)(0x80 | (codePoint & 0x3F));
+				} else {
+					str += (char)(0xF0 | (codePoint >> 18));
+					str += (char)(0x80 | ((codePoint >> 12) & 0x3F));
+					str += (char)(0x80 | ((codePoint >> 6) & 0x3F));
+					str += (char)(0x80 | (codePoint & 0x3F));
+				}
+			}
 			return str;
 		CATCH
 		return "";
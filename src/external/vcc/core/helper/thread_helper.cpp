@@ -1,7 +1,12 @@
 #include "thread_helper.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
 #include <sstream>
 #include <thread>
+#include <vector>
 
 #include "exception_macro.hpp"
 #include "string_helper.hpp"
@@ -18,4 +23,48 @@ namespace vcc
         CATCH
         return L"";
     }
+
+    void executeParallel(const size_t &count, const int64_t &parallelism, const std::function<void(const size_t &)> &action)
+    {
+        std::atomic<size_t> nextIndex = 0;
+        std::mutex exceptionMutex;
+        std::exception_ptr exception = nullptr;
+        auto worker = [&]() {
+            try {
+                for (size_t index = nextIndex++; index < count; index = nextIndex++)
+                    action(index);
+            } catch (...) {
+                nextIndex = count;
+                std::lock_guard<std::mutex> lock(exceptionMutex);
+                if (exception == nullptr)
+                    exception = std::current_exception();
+            }
+        };
+
+        {
+            // Started threads are joined on all paths, destroying joinable std::thread terminates process
+            struct ThreadJoiner
+            {
+                std::vector<std::thread> Threads;
+                ~ThreadJoiner()
+                {
+                    for (auto &thread : Threads) {
+                        if (thread.joinable())
+                            thread.join();
+                    }
+                }
+            } joiner;
+            size_t workerCount = std::min((size_t)std::max(parallelism, (int64_t)1), count);
+            try {
+                for (size_t i = 1; i < workerCount; i++)
+                    joiner.Threads.emplace_back(worker);
+            } catch (...) {
+                // Started threads and current thread take remaining indexes
+            }
+            if (workerCount > 0)
+                worker();
+        }
+        if (exception != nullptr)
+            std::rethrow_exception(exception);
+    }
 }
@@ -63,11 +63,60 @@ namespace vcc
 
     std::wstring getCurrentDatetimeString()
     {
-        auto ts = std::chrono::system_clock::now();
-        std::wstring dateTimeStr = getDatetimeString(std::chrono::system_clock::to_time_t(ts));
-        auto nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(ts.time_since_epoch()) % 1000;
-        auto nowMsStr = std::to_string(nowMs.count());
-        return dateTimeStr + str2wstr("." + padLeft(nowMsStr, 3, '0'));
+        return getCurrentDatetimeString(TimePrecision::Millisecond);
+    }
+
+    std::wstring getDatetimeString(const std::chrono::system_clock::time_point &time, const TimePrecision &precision)
+    {
+        thread_local time_t cachedTimer = -1;
+        thread_local std::wstring cachedDatetimeString;
+
+        time_t timer = std::chrono::system_clock::to_time_t(time);
+        if (timer != cachedTimer) {
+            cachedDatetimeString = getDatetimeString(timer);
+            cachedTimer = timer;
+        }
+
+        std::wstring result = cachedDatetimeString;
+        int64_t fraction = 0;
+        size_t width = 0;
+        switch (precision)
+        {
+        case TimePrecision::Millisecond:
+            fraction = std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count() % 1000;
+            width = 3;
+            break;
+        case TimePrecision::Microsecond:
+            fraction = std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count() % 1000000;
+            width = 6;
+            break;
+        default:
+            return result;
+        }
+        std::wstring fractionStr = std::to_wstring(fraction);
+        result += L".";
+        result.append(width > fractionStr.length() ? width - fractionStr.length() : 0, L'0');
+        result += fractionStr;
+        return result;
+    }
+
+    std::wstring getCurrentDatetimeString(const TimePrecision &precision)
+    {
+        return getDatetimeString(std::chrono::system_clock::now(), precision);
+    }
+
+    int64_t getMonotonicTime(const TimePrecision &precision)
+    {
+        auto now = std::chrono::steady_clock::now().time_since_epoch();
+        switch (precision)
+        {
+        case TimePrecision::Second:
+            return std::chrono::duration_cast<std::chrono::seconds>(now).count();
+        case TimePrecision::Millisecond:
+            return std::chrono::duration_cast<std::chrono::milliseconds>(now).count();
+        default:
+            return std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+        }
     }
 
     time_t ParseDatetime(const std::wstring &timeStr, const std::wstring &format)
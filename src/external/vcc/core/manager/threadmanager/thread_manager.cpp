@@ -1,10 +1,10 @@
 #include "thread_manager.hpp"
 
+#include <algorithm>
 #include <assert.h>
+#include <chrono>
 
 #include "exception_macro.hpp"
-#include "terminal_service.hpp"
-#include "time_helper.hpp"
 #include "thread.hpp"
 #include "thread_service.hpp"
 
@@ -13,22 +13,58 @@ namespace vcc
     ThreadManager::~ThreadManager()
     {
         stop();
+        // Threads left running by Immediately or Force mode still hold pointer to this manager
+        waitThreadExit(-1);
     }
 
-    std::vector<std::shared_ptr<Thread>> &ThreadManager::getThreads() const
+    std::vector<std::shared_ptr<Thread>> ThreadManager::getThreads() const
     {
+        std::lock_guard<std::mutex> lock(_QueueMutex);
         return _Threads;
     }
 
-    std::vector<std::shared_ptr<Thread>> &ThreadManager::getActiveThreads() const
+    std::vector<std::shared_ptr<Thread>> ThreadManager::getActiveThreads() const
     {
+        std::lock_guard<std::mutex> lock(_QueueMutex);
         return _ActiveThreads;
     }
 
+    namespace
+    {
+        int64_t toMillisecond(const std::chrono::steady_clock::time_point &time)
+        {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
+        }
+
+        // Max heap comparator, front() is the thread with smallest key, FIFO if same key
+        bool isLaterThread(const std::shared_ptr<Thread> &a, const std::shared_ptr<Thread> &b)
+        {
+            if (a->getScheduleKey() != b->getScheduleKey())
+                return a->getScheduleKey() > b->getScheduleKey();
+            return a->getSeqNo() > b->getSeqNo();
+        }
+    }
+
     void ThreadManager::queue(std::shared_ptr<Thread> thread) const
     {
         TRY
-            _Threads.push_back(thread);
+            {
+                std::lock_guard<std::mutex> lock(_QueueMutex);
+                auto now = std::chrono::steady_clock::now();
+                int64_t queueTime = toMillisecond(now);
+                // Key is due time fixed when queued while all waiting threads age at the same rate,
+                // so low priority thread runs after at most Priority difference * PriorityAgingInterval
+                // and deadline thread overtakes thread without deadline queued less than DefaultDeadline - Deadline earlier
+                int64_t key = queueTime + std::max(_DefaultDeadline, (int64_t)0) - thread->getPriority() * std::max(_PriorityAgingInterval, (int64_t)0);
+                if (thread->getDeadline() >= 0)
+                    key = std::min(key, queueTime + thread->getDeadline());
+                thread->setQueueTime(now);
+                thread->setScheduleKey(key);
+                thread->setSeqNo(_NextSeqNo++);
+                _Threads.push_back(thread);
+                std::push_heap(_Threads.begin(), _Threads.end(), isLaterThread);
+                recordThreadQueued(_Threads.size());
+            }
             trigger();
         CATCH
     }
@@ -36,7 +72,20 @@ namespace vcc
     void ThreadManager::urgent(std::shared_ptr<Thread> thread) const
     {
         TRY
-            _Threads.insert(_Threads.begin(), thread);
+            {
+                std::lock_guard<std::mutex> lock(_QueueMutex);
+                auto now = std::chrono::steady_clock::now();
+                // Before all waiting threads, last urgent thread runs first
+                int64_t key = toMillisecond(now);
+                if (!_Threads.empty())
+                    key = std::min(key, _Threads.front()->getScheduleKey());
+                thread->setQueueTime(now);
+                thread->setScheduleKey(key - 1);
+                thread->setSeqNo(_NextSeqNo++);
+                _Threads.push_back(thread);
+                std::push_heap(_Threads.begin(), _Threads.end(), isLaterThread);
+                recordThreadQueued(_Threads.size());
+            }
             trigger();
         CATCH
     }
@@ -44,45 +93,65 @@ namespace vcc
     void ThreadManager::trigger() const
     {
         TRY
-            // cannot use lock, or it will be dead lock
-            // std::unique_lock lock(*_Mutex);
-            switch (_State)
-            {
-            case ProcessState::Suspend:
-            case ProcessState::Stop:
-                return;            
-            default:
-                break;
-            }
-            if (!_ActiveThreads.empty()) {
-                // remove all terminated Threads
-                _ActiveThreads.erase(
-                    std::remove_if(_ActiveThreads.begin(), _ActiveThreads.end(), 
-                    [](std::shared_ptr<Thread> thread) {
-                        return thread->getState() == ProcessState::Complete
-                        || thread->getState() == ProcessState::Stop;
-                    }));
-            }
-            if (!_Threads.empty() && _MaxThreadPoolSize > 0 && _ActiveThreads.size() < (size_t)_MaxThreadPoolSize) {
-                auto firstElement = _Threads.front();
-                firstElement->setManager(this);
-                firstElement->setState(ProcessState::Idle);
-                _ActiveThreads.push_back(firstElement);
-                _Threads.erase(_Threads.begin());
-                switch (_ThreadManagementMode)
+            // Lock only when picking thread, Join mode calls trigger() recursively from executing thread
+            while (true) {
+                std::shared_ptr<Thread> nextThread = nullptr;
                 {
-                case ThreadManagementMode::Detach:
-                    ThreadService::detach(firstElement);
-                    break;
-                case ThreadManagementMode::Join:
-                    ThreadService::join(firstElement);
-                    break;
-                default:
-                    assert(false);
+                    std::lock_guard<std::mutex> lock(_QueueMutex);
+                    switch (_State)
+                    {
+                    case ProcessState::Suspend:
+                    case ProcessState::Stop:
+                        return;            
+                    default:
+                        break;
+                    }
+                    if (!_ActiveThreads.empty()) {
+                        // remove all terminated Threads
+                        _ActiveThreads.erase(
+                            std::remove_if(_ActiveThreads.begin(), _ActiveThreads.end(), 
+                            [](std::shared_ptr<Thread> thread) {
+                                return thread->getState() == ProcessState::Complete
+                                || thread->getState() == ProcessState::Stop;
+                            }), _ActiveThreads.end());
+                    }
+                    if (!_Threads.empty() && _MaxThreadPoolSize > 0 && _ActiveThreads.size() < (size_t)_MaxThreadPoolSize) {
+                        std::pop_heap(_Threads.begin(), _Threads.end(), isLaterThread);
+                        nextThread = _Threads.back();
+                        _Threads.pop_back();
+                        nextThread->setManager(this);
+                        nextThread->setState(ProcessState::Idle);
+                        _ActiveThreads.push_back(nextThread);
+                        recordThreadStarted();
+                        // Count before _QueueMutex is released, stop() must wait for thread not executing yet
+                        std::lock_guard<std::mutex> exitLock(_ThreadExitMutex);
+                        _OutstandingThreadCount++;
+                    }
+                    _State = _ActiveThreads.empty() ? ProcessState::Idle : ProcessState::Busy;
+                }
+                if (nextThread == nullptr)
                     break;
+
+                try {
+                    switch (_ThreadManagementMode)
+                    {
+                    case ThreadManagementMode::Detach:
+                        ThreadService::detach(nextThread);
+                        break;
+                    case ThreadManagementMode::Join:
+                        ThreadService::join(nextThread);
+                        break;
+                    default:
+                        assert(false);
+                        break;
+                    }
+                } catch (...) {
+                    // std::thread not created, thread never releases manager
+                    if (!nextThread->isExecuting())
+                        releaseThread();
+                    throw;
                 }
             }
-            _State = this->_ActiveThreads.empty() ? ProcessState::Idle : ProcessState::Busy;
         CATCH
     }
 
@@ -108,6 +177,7 @@ namespace vcc
     void ThreadManager::suspend() const
     {
         TRY
+            std::lock_guard<std::mutex> lock(_QueueMutex);
             _State = ProcessState::Suspend;
         CATCH        
     }
@@ -115,59 +185,189 @@ namespace vcc
     void ThreadManager::resume() const
     {
         TRY
-            _State = ProcessState::Idle;
+            {
+                std::lock_guard<std::mutex> lock(_QueueMutex);
+                _State = ProcessState::Idle;
+            }
             trigger();
         CATCH
     }
 
-    void ThreadManager::stop() const
+    void ThreadManager::recordThreadQueued(const size_t &queueDepth) const
+    {
+        std::lock_guard<std::mutex> lock(_MetricsMutex);
+        _QueuedCount++;
+        _MaxQueueDepth = std::max(_MaxQueueDepth, (int64_t)queueDepth);
+    }
+
+    void ThreadManager::recordThreadStarted() const
+    {
+        std::lock_guard<std::mutex> lock(_MetricsMutex);
+        _StartedCount++;
+    }
+
+    void ThreadManager::notifyThreadExit(const Thread *thread) const
+    {
+        if (thread != nullptr && thread->getQueueTime() != std::chrono::steady_clock::time_point()) {
+            int64_t waitTime = std::chrono::duration_cast<std::chrono::milliseconds>(thread->getStartTime() - thread->getQueueTime()).count();
+            int64_t runTime = std::chrono::duration_cast<std::chrono::milliseconds>(thread->getEndTime() - thread->getStartTime()).count();
+            bool isDeadlineMissed = thread->getDeadline() >= 0
+                && thread->getEndTime() > thread->getQueueTime() + std::chrono::milliseconds(thread->getDeadline());
+
+            std::lock_guard<std::mutex> lock(_MetricsMutex);
+            if (thread->isFailed())
+                _FailedCount++;
+            else if (thread->isCancelled())
+                _CancelledCount++;
+            else
+                _CompletedCount++;
+            _BusyTime += runTime;
+            _WaitLatency->record(waitTime);
+            _ExecutionLatency->record(runTime);
+
+            auto &metrics = _PriorityMetrics[thread->getPriority()];
+            if (metrics == nullptr) {
+                metrics = std::make_shared<ThreadPriorityMetrics>();
+                metrics->setPriority(thread->getPriority());
+            }
+            metrics->setCompletedCount(metrics->getCompletedCount() + 1);
+            metrics->setTotalWaitTime(metrics->getTotalWaitTime() + waitTime);
+            metrics->setMaxWaitTime(std::max(metrics->getMaxWaitTime(), waitTime));
+            metrics->setTotalRunTime(metrics->getTotalRunTime() + runTime);
+            metrics->setMaxRunTime(std::max(metrics->getMaxRunTime(), runTime));
+            if (isDeadlineMissed)
+                metrics->setDeadlineMissedCount(metrics->getDeadlineMissedCount() + 1);
+        }
+    }
+
+    void ThreadManager::releaseThread() const
+    {
+        // Notify under lock, waiting destructor may destroy condition variable once lock is released
+        std::lock_guard<std::mutex> lock(_ThreadExitMutex);
+        _OutstandingThreadCount--;
+        _ThreadExitCondition.notify_all();
+    }
+
+    std::shared_ptr<ThreadManagerMetrics> ThreadManager::getMetrics() const
     {
         TRY
-            clearWaitingThread();
-            for (auto &thread : _ActiveThreads)
-                thread->setState(ProcessState::Stop);
-            
-            // Remove Complete thread
-            trigger();
-            if (_ActiveThreads.empty())
-                return;
-
-            if (_TerminateMode != ThreadManagerTerminateMode::Immediately) {
-                if (_TerminateMode == ThreadManagerTerminateMode::Force) {
-                    for (auto &thread : _ActiveThreads) {
-                        TRY
-                        #ifdef _WIN32
-                            TerminalService::execute(_LogConfig.get(), L"Thread", L"taskkill /PID " + thread->getPid() + L" /F");
-                        #else
-                            TerminalService::execute(_LogConfig.get(), L"Thread", L"kill " + thread->getPid());
-                        #endif
-                        // wait 1s
-                        Sleep(1000);
-                        CATCH_SLIENT
-                    }
-                    // Remove Complete thread
-                    trigger();
-                } else if (_TerminateMode == ThreadManagerTerminateMode::Wait) {
-                    auto tmpThread = std::make_shared<Thread>(_LogConfig, L"ThreadTerminate", L"Start", L"Complete",
-                        [this](const Thread * /*thread*/) {
-                        while (true) {
-                            this->trigger();
-                            if (this->getActiveThreads().empty())
-                                break;
-                            Sleep(500); // wait 0.5s
-                        }
-                    });
-                    ThreadService::join(tmpThread);
+            auto now = std::chrono::steady_clock::now();
+            auto result = std::make_shared<ThreadManagerMetrics>();
+            int64_t executingTime = 0;
+            {
+                std::lock_guard<std::mutex> lock(_QueueMutex);
+                result->setQueueDepth(_Threads.size());
+                result->setActiveCount(_ActiveThreads.size());
+                // Busy time of executing threads is not recorded yet
+                for (auto const &thread : _ActiveThreads) {
+                    if (thread->isExecuting())
+                        executingTime += std::chrono::duration_cast<std::chrono::milliseconds>(now - thread->getStartTime()).count();
                 }
             }
+            result->setMaxThreadPoolSize(_MaxThreadPoolSize);
+
+            std::lock_guard<std::mutex> lock(_MetricsMutex);
+            result->setQueuedCount(_QueuedCount);
+            result->setStartedCount(_StartedCount);
+            result->setCompletedCount(_CompletedCount);
+            result->setFailedCount(_FailedCount);
+            result->setCancelledCount(_CancelledCount);
+            result->setMaxQueueDepth(_MaxQueueDepth);
+            result->setElapsedTime(std::chrono::duration_cast<std::chrono::milliseconds>(now - _MetricsStartTime).count());
+            result->setBusyTime(_BusyTime + executingTime);
+            if (result->getElapsedTime() > 0 && _MaxThreadPoolSize > 0)
+                result->setWorkerUtilization(std::min(1.0, (double)result->getBusyTime() / ((double)result->getElapsedTime() * _MaxThreadPoolSize)));
+            result->cloneWaitLatency(_WaitLatency.get());
+            result->cloneExecutionLatency(_ExecutionLatency.get());
+            for (auto const &metrics : _PriorityMetrics)
+                result->insertPriorityMetrics(std::static_pointer_cast<ThreadPriorityMetrics>(metrics.second->clone()));
+            return result;
+        CATCH
+        return nullptr;
+    }
+
+    std::map<int64_t, std::shared_ptr<ThreadPriorityMetrics>> ThreadManager::getPriorityMetrics() const
+    {
+        std::map<int64_t, std::shared_ptr<ThreadPriorityMetrics>> result;
+        TRY
+            std::lock_guard<std::mutex> lock(_MetricsMutex);
+            for (auto const &metrics : _PriorityMetrics)
+                result.insert(std::make_pair(metrics.first, std::static_pointer_cast<ThreadPriorityMetrics>(metrics.second->clone())));
+        CATCH
+        return result;
+    }
+
+    void ThreadManager::resetMetrics() const
+    {
+        TRY
+            std::lock_guard<std::mutex> lock(_MetricsMutex);
+            _MetricsStartTime = std::chrono::steady_clock::now();
+            _QueuedCount = 0;
+            _StartedCount = 0;
+            _CompletedCount = 0;
+            _FailedCount = 0;
+            _CancelledCount = 0;
+            _MaxQueueDepth = 0;
+            _BusyTime = 0;
+            _WaitLatency = std::make_shared<ThreadLatencyHistogram>();
+            _ExecutionLatency = std::make_shared<ThreadLatencyHistogram>();
+            _PriorityMetrics.clear();
+        CATCH
+    }
+
+    void ThreadManager::waitThreadExit(const int64_t &timeout) const
+    {
+        TRY
+            auto isAllExit = [this]() {
+                return _OutstandingThreadCount == 0;
+            };
+            std::unique_lock<std::mutex> lock(_ThreadExitMutex);
+            if (timeout < 0)
+                _ThreadExitCondition.wait(lock, isAllExit);
+            else
+                _ThreadExitCondition.wait_for(lock, std::chrono::milliseconds(timeout), isAllExit);
+        CATCH
+    }
+
+    void ThreadManager::stop() const
+    {
+        TRY
+            // Stop first so that no new thread is started by trigger()
+            std::vector<std::shared_ptr<Thread>> activeThreads;
+            {
+                std::lock_guard<std::mutex> lock(_QueueMutex);
+                _State = ProcessState::Stop;
+                _Threads.clear();
+                activeThreads = _ActiveThreads;
+            }
+
+            // Thread not executing yet is cancelled too, it skips action and releases manager
+            for (auto &thread : activeThreads)
+                thread->cancel();
+
+            switch (_TerminateMode)
+            {
+            case ThreadManagerTerminateMode::Immediately:
+                break;
+            case ThreadManagerTerminateMode::Force:
+                waitThreadExit(_ForceTerminateTimeout);
+                break;
+            case ThreadManagerTerminateMode::Wait:
+                waitThreadExit(-1);
+                break;
+            default:
+                assert(false);
+                break;
+            }
+            std::lock_guard<std::mutex> lock(_QueueMutex);
             _ActiveThreads.clear();
-            _State = ProcessState::Stop;
         CATCH
     }
     
     void ThreadManager::clearWaitingThread() const
     {
         TRY
+            std::lock_guard<std::mutex> lock(_QueueMutex);
             _Threads.clear();
         CATCH
     }
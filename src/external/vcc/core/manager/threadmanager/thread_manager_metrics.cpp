@@ -0,0 +1,200 @@
+#include "thread_manager_metrics.hpp"
+
+#include <algorithm>
+#include <assert.h>
+#include <memory>
+#include <string>
+
+#include "exception_macro.hpp"
+#include "i_document.hpp"
+#include "json.hpp"
+
+namespace vcc
+{
+    ThreadLatencyHistogram::ThreadLatencyHistogram() : BaseObject()
+    {
+        _BucketCounts.resize(getBucketUpperBounds().size() + 1, 0);
+    }
+
+    const std::vector<int64_t> &ThreadLatencyHistogram::getBucketUpperBounds()
+    {
+        static const std::vector<int64_t> bucketUpperBounds = { 1, 5, 10, 50, 100, 500, 1000, 5000, 10000, 60000 };
+        return bucketUpperBounds;
+    }
+
+    void ThreadLatencyHistogram::record(const int64_t &value)
+    {
+        TRY
+            const auto &bucketUpperBounds = getBucketUpperBounds();
+            size_t index = std::lower_bound(bucketUpperBounds.begin(), bucketUpperBounds.end(), value) - bucketUpperBounds.begin();
+            if (_BucketCounts.size() <= index)
+                _BucketCounts.resize(index + 1, 0);
+            _BucketCounts[index]++;
+            _Count++;
+            _Total += value;
+            _Max = std::max(_Max, value);
+        CATCH
+    }
+
+    int64_t ThreadLatencyHistogram::getAverage() const
+    {
+        return _Count > 0 ? _Total / _Count : 0;
+    }
+
+    std::shared_ptr<Json> ThreadLatencyHistogram::ToJson() const
+    {
+        TRY
+            auto json = std::make_shared<Json>();
+            json->addInt(L"Count", _Count);
+            json->addInt(L"Total", _Total);
+            json->addInt(L"Max", _Max);
+            json->addInt(L"Average", getAverage());
+            // UpperBound -1 means no upper bound
+            auto buckets = std::make_shared<Json>();
+            json->addArray(L"Buckets", buckets);
+            const auto &bucketUpperBounds = getBucketUpperBounds();
+            for (size_t i = 0; i < _BucketCounts.size(); i++) {
+                auto bucket = std::make_shared<Json>();
+                bucket->addInt(L"UpperBound", i < bucketUpperBounds.size() ? bucketUpperBounds[i] : -1);
+                bucket->addInt(L"Count", _BucketCounts[i]);
+                buckets->addArrayObject(bucket);
+            }
+            return json;
+        CATCH
+        return nullptr;
+    }
+
+    void ThreadLatencyHistogram::deserializeJson(std::shared_ptr<IDocument> document)
+    {
+        TRY
+            auto json = std::dynamic_pointer_cast<Json>(document);
+            assert(json != nullptr);
+            if (json->isContainKey(L"Count"))
+                _Count = json->getInt64(L"Count");
+            if (json->isContainKey(L"Total"))
+                _Total = json->getInt64(L"Total");
+            if (json->isContainKey(L"Max"))
+                _Max = json->getInt64(L"Max");
+            if (json->isContainKey(L"Buckets")) {
+                _BucketCounts.clear();
+                for (auto const &element : json->getArray(L"Buckets"))
+                    _BucketCounts.push_back(element->getArrayElementObject()->getInt64(L"Count"));
+            }
+        CATCH
+    }
+
+    std::shared_ptr<Json> ThreadPriorityMetrics::ToJson() const
+    {
+        TRY
+            auto json = std::make_shared<Json>();
+            json->addInt(L"Priority", _Priority);
+            json->addInt(L"CompletedCount", _CompletedCount);
+            json->addInt(L"TotalWaitTime", _TotalWaitTime);
+            json->addInt(L"MaxWaitTime", _MaxWaitTime);
+            json->addInt(L"TotalRunTime", _TotalRunTime);
+            json->addInt(L"MaxRunTime", _MaxRunTime);
+            json->addInt(L"DeadlineMissedCount", _DeadlineMissedCount);
+            return json;
+        CATCH
+        return nullptr;
+    }
+
+    void ThreadPriorityMetrics::deserializeJson(std::shared_ptr<IDocument> document)
+    {
+        TRY
+            auto json = std::dynamic_pointer_cast<Json>(document);
+            assert(json != nullptr);
+            if (json->isContainKey(L"Priority"))
+                _Priority = json->getInt64(L"Priority");
+            if (json->isContainKey(L"CompletedCount"))
+                _CompletedCount = json->getInt64(L"CompletedCount");
+            if (json->isContainKey(L"TotalWaitTime"))
+                _TotalWaitTime = json->getInt64(L"TotalWaitTime");
+            if (json->isContainKey(L"MaxWaitTime"))
+                _MaxWaitTime = json->getInt64(L"MaxWaitTime");
+            if (json->isContainKey(L"TotalRunTime"))
+                _TotalRunTime = json->getInt64(L"TotalRunTime");
+            if (json->isContainKey(L"MaxRunTime"))
+                _MaxRunTime = json->getInt64(L"MaxRunTime");
+            if (json->isContainKey(L"DeadlineMissedCount"))
+                _DeadlineMissedCount = json->getInt64(L"DeadlineMissedCount");
+        CATCH
+    }
+
+    std::shared_ptr<Json> ThreadManagerMetrics::ToJson() const
+    {
+        TRY
+            auto json = std::make_shared<Json>();
+            json->addInt(L"QueuedCount", _QueuedCount);
+            json->addInt(L"StartedCount", _StartedCount);
+            json->addInt(L"CompletedCount", _CompletedCount);
+            json->addInt(L"FailedCount", _FailedCount);
+            json->addInt(L"CancelledCount", _CancelledCount);
+            json->addInt(L"QueueDepth", _QueueDepth);
+            json->addInt(L"MaxQueueDepth", _MaxQueueDepth);
+            json->addInt(L"ActiveCount", _ActiveCount);
+            json->addInt(L"MaxThreadPoolSize", _MaxThreadPoolSize);
+            json->addInt(L"ElapsedTime", _ElapsedTime);
+            json->addInt(L"BusyTime", _BusyTime);
+            json->addDouble(L"WorkerUtilization", _WorkerUtilization, 4);
+            if (_WaitLatency != nullptr)
+                json->addObject(L"WaitLatency", _WaitLatency->ToJson());
+            if (_ExecutionLatency != nullptr)
+                json->addObject(L"ExecutionLatency", _ExecutionLatency->ToJson());
+            auto priorityMetrics = std::make_shared<Json>();
+            json->addArray(L"PriorityMetrics", priorityMetrics);
+            for (auto const &element : _PriorityMetrics)
+                priorityMetrics->addArrayObject(element->ToJson());
+            return json;
+        CATCH
+        return nullptr;
+    }
+
+    void ThreadManagerMetrics::deserializeJson(std::shared_ptr<IDocument> document)
+    {
+        TRY
+            auto json = std::dynamic_pointer_cast<Json>(document);
+            assert(json != nullptr);
+            if (json->isContainKey(L"QueuedCount"))
+                _QueuedCount = json->getInt64(L"QueuedCount");
+            if (json->isContainKey(L"StartedCount"))
+                _StartedCount = json->getInt64(L"StartedCount");
+            if (json->isContainKey(L"CompletedCount"))
+                _CompletedCount = json->getInt64(L"CompletedCount");
+            if (json->isContainKey(L"FailedCount"))
+                _FailedCount = json->getInt64(L"FailedCount");
+            if (json->isContainKey(L"CancelledCount"))
+                _CancelledCount = json->getInt64(L"CancelledCount");
+            if (json->isContainKey(L"QueueDepth"))
+                _QueueDepth = json->getInt64(L"QueueDepth");
+            if (json->isContainKey(L"MaxQueueDepth"))
+                _MaxQueueDepth = json->getInt64(L"MaxQueueDepth");
+            if (json->isContainKey(L"ActiveCount"))
+                _ActiveCount = json->getInt64(L"ActiveCount");
+            if (json->isContainKey(L"MaxThreadPoolSize"))
+                _MaxThreadPoolSize = json->getInt64(L"MaxThreadPoolSize");
+            if (json->isContainKey(L"ElapsedTime"))
+                _ElapsedTime = json->getInt64(L"ElapsedTime");
+            if (json->isContainKey(L"BusyTime"))
+                _BusyTime = json->getInt64(L"BusyTime");
+            if (json->isContainKey(L"WorkerUtilization"))
+                _WorkerUtilization = json->getDouble(L"WorkerUtilization");
+            if (json->isContainKey(L"WaitLatency")) {
+                _WaitLatency = std::make_shared<ThreadLatencyHistogram>();
+                _WaitLatency->deserializeJson(json->getObject(L"WaitLatency"));
+            }
+            if (json->isContainKey(L"ExecutionLatency")) {
+                _ExecutionLatency = std::make_shared<ThreadLatencyHistogram>();
+                _ExecutionLatency->deserializeJson(json->getObject(L"ExecutionLatency"));
+            }
+            clearPriorityMetrics();
+            if (json->isContainKey(L"PriorityMetrics")) {
+                for (auto const &element : json->getArray(L"PriorityMetrics")) {
+                    auto tmpPriorityMetrics = std::make_shared<ThreadPriorityMetrics>();
+                    tmpPriorityMetrics->deserializeJson(element->getArrayElementObject());
+                    insertPriorityMetrics(tmpPriorityMetrics);
+                }
+            }
+        CATCH
+    }
+}
@@ -1,5 +1,6 @@
 #include "thread.hpp"
 
+#include <exception>
 #include <thread>
 
 #include "exception_macro.hpp"
@@ -10,6 +11,38 @@
 
 namespace vcc
 {
+    class Thread::ExitGuard
+    {
+        private:
+            const Thread *_Thread = nullptr;
+            int _UncaughtExceptionCount = std::uncaught_exceptions();
+
+        public:
+            ExitGuard(const Thread *thread) : _Thread(thread) {}
+            ~ExitGuard()
+            {
+                if (std::uncaught_exceptions() > _UncaughtExceptionCount)
+                    _Thread->_IsFailed = true;
+                _Thread->exit();
+            }
+    };
+
+    ProcessState Thread::getState() const
+    {
+        return _State.load();
+    }
+
+    void Thread::setState(const ProcessState &state) const
+    {
+        _State = state;
+    }
+
+    void Thread::updateState(const ProcessState &state) const
+    {
+        ProcessState current = _State.load();
+        while (current != ProcessState::Stop && !_State.compare_exchange_weak(current, state)) {}
+    }
+
     const ThreadManager *Thread::getManager() const
     {
         return _Manager;
@@ -25,12 +58,88 @@ namespace vcc
         return ToString(_Pid);
     }
 
+    std::shared_ptr<CancellationToken> Thread::getCancellationToken() const
+    {
+        return _CancellationToken;
+    }
+
+    bool Thread::isCancelled() const
+    {
+        return _CancellationToken->isCancelled();
+    }
+
+    void Thread::cancel() const
+    {
+        _State = ProcessState::Stop;
+        _CancellationToken->cancel();
+    }
+
+    void Thread::exit() const
+    {
+        updateState(ProcessState::Complete);
+        _EndTime = std::chrono::steady_clock::now();
+        _IsExecuting = false;
+        if (_Manager == nullptr)
+            return;
+
+        // Called in destructor, manager may be waiting for this thread in stop() and waiting threads must not stall
+        TRY
+            _Manager->notifyThreadExit(this);
+            _Manager->trigger();
+        CATCH_SLIENT
+        // Last access, manager may be destroyed once released
+        _Manager->releaseThread();
+    }
+
+    bool Thread::isExecuting() const
+    {
+        return _IsExecuting.load();
+    }
+
+    bool Thread::isFailed() const
+    {
+        return _IsFailed.load();
+    }
+
+    int64_t Thread::getScheduleKey() const
+    {
+        return _ScheduleKey;
+    }
+
+    void Thread::setScheduleKey(const int64_t &key) const
+    {
+        _ScheduleKey = key;
+    }
+
+    std::chrono::steady_clock::time_point Thread::getQueueTime() const
+    {
+        return _QueueTime;
+    }
+
+    void Thread::setQueueTime(const std::chrono::steady_clock::time_point &time) const
+    {
+        _QueueTime = time;
+    }
+
+    std::chrono::steady_clock::time_point Thread::getStartTime() const
+    {
+        return _StartTime;
+    }
+
+    std::chrono::steady_clock::time_point Thread::getEndTime() const
+    {
+        return _EndTime;
+    }
+
     void Thread::execute() const
     {
+        _Pid = std::this_thread::get_id();
+        _StartTime = std::chrono::steady_clock::now();
+        _IsExecuting = true;
         TRY
-            _Pid = std::this_thread::get_id();
-            if (_Action) {
-                _State = ProcessState::Busy;
+            ExitGuard exitGuard(this);
+            if (_Action && !isCancelled()) {
+                updateState(ProcessState::Busy);
                 std::wstring id = isBlank(_Id) ? (L"Thread." + getPid()) : _Id;
                 LogService::LogThread(_LogConfig.get(), id, isBlank(_MessageStart) ? L"Thread Start" : _MessageStart);
                 if (!isBlank(_DebugMessage))
@@ -38,14 +147,10 @@ namespace vcc
 
                 _Action(this);
                 LogService::LogThread(_LogConfig.get(), id, isBlank(_MessageComplete) ? L"Thread Terminated" : _MessageComplete);
-                if (_State == ProcessState::Busy || _State == ProcessState::Idle)
-                    _State = ProcessState::Complete;
+                updateState(ProcessState::Complete);
             }
             if (_Callback)
                 _Callback(this);
-
-            if (_Manager)
-                _Manager->trigger();
         CATCH
     }
 };
\ No newline at end of file
@@ -0,0 +1,171 @@
+#include "async_log_writer.hpp"
+
+#include <chrono>
+#include <iostream>
+
+#include "string_helper.hpp"
+
+namespace vcc
+{
+	AsyncLogWriter::AsyncLogWriter(const size_t &capacity) : _Buffer(capacity)
+	{
+		_Writer = std::thread(&AsyncLogWriter::run, this);
+	}
+
+	AsyncLogWriter::~AsyncLogWriter()
+	{
+		// Set before writer can see _IsStop, so no producer pushes after writer checks _PushingCount
+		_IsStopped = true;
+		{
+			std::lock_guard<std::mutex> lock(_Mutex);
+			_IsStop = true;
+		}
+		_WriterCondition.notify_all();
+		if (_Writer.joinable())
+			_Writer.join();
+	}
+
+	AsyncLogWriter &AsyncLogWriter::getInstance()
+	{
+		// Destructed at exit, writer thread writes remaining messages before join
+		static AsyncLogWriter instance(8192);
+		return instance;
+	}
+
+	LogFileWriter *AsyncLogWriter::getFileWriter(const std::wstring &filePath)
+	{
+		auto it = _FileWriters.find(filePath);
+		if (it != _FileWriters.end())
+			return it->second.get();
+		return _FileWriters.insert(std::make_pair(filePath, std::make_unique<LogFileWriter>(filePath, true))).first->second.get();
+	}
+
+	size_t AsyncLogWriter::drain()
+	{
+		size_t count = 0;
+		bool isConsoleWritten = false;
+		std::map<std::wstring, LogFileWriter *> writtenFileWriters;
+		AsyncLogEntry entry;
+		while (_Buffer.tryPop(entry)) {
+			count++;
+			try {
+				if (entry.IsConsoleLog) {
+					std::wcout << entry.Message << L"\n";
+					isConsoleWritten = true;
+				}
+				if (!isBlank(entry.FilePath)) {
+					LogFileWriter *fileWriter = getFileWriter(entry.FilePath);
+					fileWriter->write(entry.FileOption, entry.Message, entry.Record);
+					writtenFileWriters.insert(std::make_pair(entry.FilePath, fileWriter));
+				}
+			} catch (...) {
+				// Logging must not stop writer thread
+			}
+		}
+		if (isConsoleWritten)
+			std::wcout.flush();
+		for (auto &fileWriter : writtenFileWriters)
+			fileWriter.second->flush();
+
+		if (count > 0) {
+			_WrittenCount += count;
+			{
+				std::lock_guard<std::mutex> lock(_Mutex);
+			}
+			_FlushCondition.notify_all();
+		}
+		return count;
+	}
+
+	void AsyncLogWriter::run()
+	{
+		while (true) {
+			bool isStop = false;
+			{
+				std::unique_lock<std::mutex> lock(_Mutex);
+				_WriterCondition.wait_for(lock, std::chrono::milliseconds(_FlushInterval.load()), [this]() {
+					return _IsStop || _IsFlushRequested
+						|| _Buffer.getPushedCount() - _WrittenCount.load() >= (size_t)_BatchSize.load();
+				});
+				isStop = _IsStop;
+				_IsFlushRequested = false;
+			}
+			drain();
+			if (isStop) {
+				// Wait for producers which are still in push() or claimed slot but not yet finished writing
+				while (_PushingCount.load() > 0 || _WrittenCount.load() < _Buffer.getPushedCount()) {
+					if (drain() == 0)
+						std::this_thread::yield();
+				}
+				break;
+			}
+		}
+		_FileWriters.clear();
+		{
+			std::lock_guard<std::mutex> lock(_Mutex);
+			_IsWriterExited = true;
+		}
+		_FlushCondition.notify_all();
+	}
+
+	void AsyncLogWriter::configure(const int64_t &flushInterval, const int64_t &batchSize)
+	{
+		_IsConfigured = true;
+		_FlushInterval = flushInterval > 0 ? flushInterval : 1;
+		_BatchSize = batchSize > 0 ? batchSize : 1;
+		_WriterCondition.notify_one();
+	}
+
+	bool AsyncLogWriter::push(const LogConfig *logConfig, const std::wstring &filePath, const LogFileOption &fileOption, const std::wstring &message, const LogRecord &record)
+	{
+		if (logConfig == nullptr)
+			return true;
+		AsyncLogEntry entry;
+		entry.IsConsoleLog = logConfig->getIsConsoleLog();
+		entry.FilePath = filePath;
+		entry.FileOption = fileOption;
+		entry.Message = message;
+		entry.Record = record;
+		// Counted before _IsStopped is checked, writer sets _IsStopped before it waits for _PushingCount
+		_PushingCount++;
+		if (_IsStopped.load()) {
+			_PushingCount--;
+			return false;
+		}
+		// First LogConfig wins, later LogConfig with different setting does not override
+		bool isConfigured = false;
+		if (!_IsConfigured.load() && _IsConfigured.compare_exchange_strong(isConfigured, true)) {
+			_FlushInterval = logConfig->getAsyncFlushInterval() > 0 ? logConfig->getAsyncFlushInterval() : 1;
+			_BatchSize = logConfig->getAsyncBatchSize() > 0 ? logConfig->getAsyncBatchSize() : 1;
+		}
+
+		// Buffer full, wake up writer and wait until it drains, writer keeps draining until _PushingCount is 0
+		// Wait is bounded in case notification is missed
+		while (!_Buffer.tryPush(std::move(entry))) {
+			std::unique_lock<std::mutex> lock(_Mutex);
+			_IsFlushRequested = true;
+			_WriterCondition.notify_one();
+			size_t pushedCount = _Buffer.getPushedCount();
+			_FlushCondition.wait_for(lock, std::chrono::milliseconds(_FlushInterval.load()), [this, pushedCount]() {
+				return _WrittenCount.load() + _Buffer.getCapacity() > pushedCount;
+			});
+		}
+		if (_Buffer.getPushedCount() - _WrittenCount.load() >= (size_t)_BatchSize.load())
+			_WriterCondition.notify_one();
+		_PushingCount--;
+		return true;
+	}
+
+	void AsyncLogWriter::flush()
+	{
+		size_t target = _Buffer.getPushedCount();
+		std::unique_lock<std::mutex> lock(_Mutex);
+		if (_WrittenCount.load() >= target)
+			return;
+		_IsFlushRequested = true;
+		_WriterCondition.notify_one();
+		_FlushCondition.wait(lock, [this, target]() {
+			return _WrittenCount.load() >= target || _IsWriterExited;
+		});
+	}
+}
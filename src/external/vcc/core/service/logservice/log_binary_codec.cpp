@@ -0,0 +1,116 @@
+#include "log_binary_codec.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "exception_macro.hpp"
+#include "string_helper.hpp"
+
+namespace vcc
+{
+	namespace
+	{
+		void encodeVarint(uint64_t value, std::string &buffer)
+		{
+			while (value >= 0x80) {
+				buffer += (char)((value & 0x7F) | 0x80);
+				value >>= 7;
+			}
+			buffer += (char)value;
+		}
+
+		bool decodeVarint(const std::string &data, size_t &pos, uint64_t &value)
+		{
+			value = 0;
+			for (size_t shift = 0; shift < 64 && pos < data.length(); shift += 7) {
+				uint8_t byte = (uint8_t)data[pos++];
+				value |= (uint64_t)(byte & 0x7F) << shift;
+				if ((byte & 0x80) == 0)
+					return true;
+			}
+			return false;
+		}
+
+		void encodeString(const std::wstring &str, std::string &buffer)
+		{
+			std::string utf8 = wstr2str(str);
+			encodeVarint(utf8.length(), buffer);
+			buffer += utf8;
+		}
+
+		bool decodeString(const std::string &data, size_t &pos, std::wstring &str)
+		{
+			uint64_t length = 0;
+			if (!decodeVarint(data, pos, length) || data.length() - pos < length)
+				return false;
+			str = str2wstr(data.substr(pos, length));
+			pos += length;
+			return true;
+		}
+	}
+
+	const std::string &LogBinaryCodec::getFileHeader()
+	{
+		static const std::string fileHeader("VCCLOG\x02", 7);
+		return fileHeader;
+	}
+
+	bool LogBinaryCodec::decodeFileHeader(const std::string &data, size_t &pos)
+	{
+		const std::string &fileHeader = getFileHeader();
+		if (data.compare(pos, fileHeader.length(), fileHeader) != 0)
+			return false;
+		pos += fileHeader.length();
+		return true;
+	}
+
+	void LogBinaryCodec::encode(const LogRecord &record, std::string &buffer)
+	{
+		encodeVarint((uint64_t)record.Type, buffer);
+		encodeVarint((uint64_t)record.Category, buffer);
+		encodeVarint((uint64_t)record.Timestamp, buffer);
+		encodeString(record.ThreadId, buffer);
+		encodeString(record.Id, buffer);
+		encodeString(record.UserID, buffer);
+		encodeString(record.Message, buffer);
+	}
+
+	bool LogBinaryCodec::decode(const std::string &data, size_t &pos, LogRecord &record)
+	{
+		size_t currentPos = pos;
+		uint64_t type = 0, category = 0, timestamp = 0;
+		if (!decodeVarint(data, currentPos, type)
+			|| !decodeVarint(data, currentPos, category)
+			|| !decodeVarint(data, currentPos, timestamp)
+			|| !decodeString(data, currentPos, record.ThreadId)
+			|| !decodeString(data, currentPos, record.Id)
+			|| !decodeString(data, currentPos, record.UserID)
+			|| !decodeString(data, currentPos, record.Message))
+			return false;
+		record.Type = (LogType)type;
+		record.Category = (LogCategory)category;
+		record.Timestamp = (int64_t)timestamp;
+		pos = currentPos;
+		return true;
+	}
+
+	void LogBinaryCodec::decodeFile(const std::wstring &filePath, std::vector<LogRecord> &records)
+	{
+		TRY
+			std::ifstream fileStream(std::filesystem::path(filePath), std::ios_base::binary);
+			if (!fileStream.is_open())
+				THROW_EXCEPTION_MSG(ExceptionType::FileNotFound, filePath + L": File not found.");
+			std::string data((std::istreambuf_iterator<char>(fileStream)), std::istreambuf_iterator<char>());
+			size_t pos = 0;
+			if (!decodeFileHeader(data, pos))
+				THROW_EXCEPTION_MSG(ExceptionType::ParserError, filePath + L": Not a binary log file.");
+			LogRecord record;
+			while (decode(data, pos, record))
+				records.push_back(record);
+		CATCH
+	}
+}
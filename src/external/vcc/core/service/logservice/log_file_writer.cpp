@@ -0,0 +1,124 @@
+#include "log_file_writer.hpp"
+
+#include <filesystem>
+#include <string>
+
+#include "file_helper.hpp"
+#include "log_binary_codec.hpp"
+#include "log_json_line_codec.hpp"
+#include "string_helper.hpp"
+
+namespace vcc
+{
+	LogFileOption::LogFileOption(const LogConfig *logConfig)
+	{
+		if (logConfig == nullptr)
+			return;
+		FileFormat = logConfig->getFileFormat();
+		MaxFileSize = logConfig->getMaxFileSize();
+		RotationInterval = logConfig->getRotationInterval();
+		MaxRetainedFileCount = logConfig->getMaxRetainedFileCount();
+	}
+
+	LogFileWriter::LogFileWriter(const std::wstring &filePath, const bool &isKeepOpen)
+		: _FilePath(filePath), _IsKeepOpen(isKeepOpen)
+	{
+	}
+
+	LogFileWriter::~LogFileWriter()
+	{
+		close();
+	}
+
+	std::wstring LogFileWriter::getRotatedFilePath(const std::wstring &filePath, const int64_t &index)
+	{
+		return index > 0 ? (filePath + L"." + std::to_wstring(index)) : filePath;
+	}
+
+	void LogFileWriter::open()
+	{
+		if (_FileStream.is_open())
+			return;
+		PATH filePath(_FilePath);
+		PATH dir = filePath.parent_path();
+		if (!dir.empty() && !isDirectoryExists(dir.wstring()))
+			std::filesystem::create_directories(dir);
+		// Size is read again for sync log, file may be changed by others
+		std::error_code errorCode;
+		auto fileSize = std::filesystem::file_size(filePath, errorCode);
+		_FileSize = errorCode ? 0 : (int64_t)fileSize;
+		_FileStream.open(filePath, std::ios_base::binary | std::ios_base::app);
+	}
+
+	void LogFileWriter::close()
+	{
+		if (_FileStream.is_open())
+			_FileStream.close();
+	}
+
+	bool LogFileWriter::isRotationNeeded(const LogFileOption &option, const size_t &size) const
+	{
+		if (_FileSize <= 0)
+			return false;
+		if (option.MaxFileSize > 0 && _FileSize + (int64_t)size > option.MaxFileSize)
+			return true;
+		if (option.RotationInterval > 0
+			&& std::chrono::steady_clock::now() - _StartTime >= std::chrono::seconds(option.RotationInterval))
+			return true;
+		return false;
+	}
+
+	void LogFileWriter::rotate(const LogFileOption &option)
+	{
+		close();
+		std::error_code errorCode;
+		if (option.MaxRetainedFileCount <= 0)
+			std::filesystem::remove(PATH(_FilePath), errorCode);
+		else {
+			std::filesystem::remove(PATH(getRotatedFilePath(_FilePath, option.MaxRetainedFileCount)), errorCode);
+			for (int64_t i = option.MaxRetainedFileCount - 1; i >= 0; i--) {
+				PATH from(getRotatedFilePath(_FilePath, i));
+				if (std::filesystem::exists(from, errorCode))
+					std::filesystem::rename(from, PATH(getRotatedFilePath(_FilePath, i + 1)), errorCode);
+			}
+		}
+		_StartTime = std::chrono::steady_clock::now();
+		open();
+	}
+
+	void LogFileWriter::write(const LogFileOption &option, const std::wstring &text, const LogRecord &record)
+	{
+		std::string buffer;
+		if (option.FileFormat == LogFileFormat::Binary)
+			LogBinaryCodec::encode(record, buffer);
+		else {
+			if (option.FileFormat == LogFileFormat::JsonLines)
+				LogJsonLineCodec::encode(record, buffer);
+			else
+				buffer = wstr2str(text);
+			// File is opened in binary mode for byte accurate size, same line ending on all platforms
+			buffer += "\n";
+		}
+
+		open();
+		if (isRotationNeeded(option, buffer.length()))
+			rotate(option);
+		if (!_FileStream.is_open())
+			return;
+		if (option.FileFormat == LogFileFormat::Binary && _FileSize == 0) {
+			const std::string &fileHeader = LogBinaryCodec::getFileHeader();
+			_FileStream.write(fileHeader.c_str(), fileHeader.length());
+			_FileSize += fileHeader.length();
+		}
+		_FileStream.write(buffer.c_str(), buffer.length());
+		_FileSize += buffer.length();
+		if (!_IsKeepOpen)
+			close();
+	}
+
+	void LogFileWriter::flush()
+	{
+		if (_FileStream.is_open())
+			_FileStream.flush();
+	}
+}
@@ -0,0 +1,127 @@
+#include "log_json_line_codec.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace vcc
+{
+	namespace
+	{
+		void appendHex(uint32_t value, std::string &buffer)
+		{
+			static const char *hexDigits = "0123456789abcdef";
+			buffer += "\\u";
+			for (int shift = 12; shift >= 0; shift -= 4)
+				buffer += hexDigits[(value >> shift) & 0xF];
+		}
+
+		// wchar_t is treated as code point, code point above 0xFFFF is written as surrogate pair
+		void appendString(const std::wstring &str, std::string &buffer)
+		{
+			buffer += '"';
+			for (wchar_t ch : str) {
+				uint32_t codePoint = (uint32_t)ch;
+				switch (codePoint)
+				{
+				case '"':
+					buffer += "\\\"";
+					break;
+				case '\\':
+					buffer += "\\\\";
+					break;
+				case '\b':
+					buffer += "\\b";
+					break;
+				case '\f':
+					buffer += "\\f";
+					break;
+				case '\n':
+					buffer += "\\n";
+					break;
+				case '\r':
+					buffer += "\\r";
+					break;
+				case '\t':
+					buffer += "\\t";
+					break;
+				default:
+					if (codePoint < 0x20 || (codePoint >= 0x7F && codePoint < 0x10000))
+						appendHex(codePoint, buffer);
+					else if (codePoint >= 0x10000) {
+						codePoint -= 0x10000;
+						appendHex(0xD800 | (codePoint >> 10), buffer);
+						appendHex(0xDC00 | (codePoint & 0x3FF), buffer);
+					} else
+						buffer += (char)codePoint;
+					break;
+				}
+			}
+			buffer += '"';
+		}
+
+		void appendName(const wchar_t *name, std::string &buffer)
+		{
+			buffer += '"';
+			for (const wchar_t *ch = name; *ch != L'\0'; ch++)
+				buffer += (char)*ch;
+			buffer += '"';
+		}
+	}
+
+	const wchar_t *LogJsonLineCodec::getLogTypeName(const LogType &logType)
+	{
+		switch (logType)
+		{
+		case LogType::Error:
+			return L"Error";
+		case LogType::Warning:
+			return L"Warning";
+		case LogType::Debug:
+			return L"Debug";
+		default:
+			return L"Info";
+		}
+	}
+
+	const wchar_t *LogJsonLineCodec::getLogCategoryName(const LogCategory &logCategory)
+	{
+		switch (logCategory)
+		{
+		case LogCategory::Thread:
+			return L"Thread";
+		case LogCategory::Terminal:
+			return L"Terminal";
+		case LogCategory::TerminalResult:
+			return L"TerminalResult";
+		case LogCategory::Process:
+			return L"Process";
+		case LogCategory::ProcessResult:
+			return L"ProcessResult";
+		case LogCategory::SQL:
+			return L"SQL";
+		case LogCategory::SQLResult:
+			return L"SQLResult";
+		default:
+			return L"General";
+		}
+	}
+
+	void LogJsonLineCodec::encode(const LogRecord &record, std::string &buffer)
+	{
+		buffer += "{\"Type\":";
+		appendName(getLogTypeName(record.Type), buffer);
+		buffer += ",\"Timestamp\":";
+		buffer += std::to_string(record.Timestamp);
+		buffer += ",\"ThreadId\":";
+		appendString(record.ThreadId, buffer);
+		buffer += ",\"UserID\":";
+		appendString(record.UserID, buffer);
+		buffer += ",\"Category\":";
+		appendName(getLogCategoryName(record.Category), buffer);
+		buffer += ",\"Id\":";
+		appendString(record.Id, buffer);
+		buffer += ",\"Message\":";
+		appendString(record.Message, buffer);
+		buffer += '}';
+	}
+}
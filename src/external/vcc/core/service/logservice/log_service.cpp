@@ -1,13 +1,21 @@
 #include "log_service.hpp"
 
+#include <chrono>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
 
+#include "async_log_writer.hpp"
+#include "log_file_writer.hpp"
+#include "log_record.hpp"
 #include "time_helper.hpp"
+#include "thread_helper.hpp"
 #include "file_helper.hpp"
 
 namespace vcc
 {
-	std::wstring LogService::_logMessage(const LogConfig *logConfig, const LogType &logType, const std::wstring &id, const std::wstring &message)
+	std::wstring LogService::_logMessage(const LogConfig *logConfig, const LogType &logType, const LogCategory &logCategory, const std::wstring &id, const std::wstring &message)
 	{
 		if (logConfig == nullptr)
 			return L"";
@@ -32,89 +40,142 @@ namespace vcc
 			break;
 		}
 
-		logMessage += L" " + getCurrentDatetimeString();
+		auto now = std::chrono::system_clock::now();
+		logMessage += L" " + getDatetimeString(now, logConfig->getTimestampPrecision());
+		if (logConfig->getIsLogMonotonicTime())
+			logMessage += L" (" + std::to_wstring(getMonotonicTime(TimePrecision::Microsecond)) + L")";
 		if (!isBlank(id))
 			logMessage += L" [" + id + L"]";
 		if (!isBlank(logConfig->getUserID()))
 			logMessage += L" [" + logConfig->getUserID() + L"] ";
 		logMessage += L" " + message;
+		if (!isLogEnabled(logConfig))
+			return logMessage;
+
+		std::wstring filePath = logConfig->getFilePath();
+		LogFileOption fileOption(logConfig);
+		if (!isBlank(filePath) && logConfig->getBinaryCategories().contains(logCategory)) {
+			if (!isBlank(logConfig->getBinaryFilePath()))
+				filePath = logConfig->getBinaryFilePath();
+			else
+				filePath += L".bin";
+			fileOption.FileFormat = LogFileFormat::Binary;
+		}
+
+		LogRecord record;
+		if (!isBlank(filePath) && fileOption.FileFormat != LogFileFormat::Text) {
+			thread_local std::wstring threadId = ToString(std::this_thread::get_id());
+			record.Type = logType;
+			record.Category = logCategory;
+			record.Timestamp = std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count();
+			record.ThreadId = threadId;
+			record.Id = id;
+			record.UserID = logConfig->getUserID();
+			record.Message = message;
+		}
+		// Write synchronously if async writer is already stopped at exit
+		if (logConfig->getIsAsync() && AsyncLogWriter::getInstance().push(logConfig, filePath, fileOption, logMessage, record))
+			return logMessage;
+
 		if (logConfig->getIsConsoleLog())
 			std::wcout << logMessage << std::endl;
 
-		if (!isBlank(logConfig->getFilePath())) {
-			appendFileOneLine(logConfig->getFilePath(), logMessage, true);
+		if (!isBlank(filePath)) {
+			// Keep rotation state per file, file is closed after each write
+			static std::mutex fileWritersMutex;
+			static std::map<std::wstring, std::unique_ptr<LogFileWriter>> fileWriters;
+			std::lock_guard<std::mutex> lock(fileWritersMutex);
+			auto &fileWriter = fileWriters[filePath];
+			if (fileWriter == nullptr)
+				fileWriter = std::make_unique<LogFileWriter>(filePath, false);
+			fileWriter->write(fileOption, logMessage, record);
 		}
 		return logMessage;
 	}
 
+	void LogService::flush()
+	{
+		AsyncLogWriter::getInstance().flush();
+	}
+
+	void LogService::configureAsync(const int64_t &flushInterval, const int64_t &batchSize)
+	{
+		AsyncLogWriter::getInstance().configure(flushInterval, batchSize);
+	}
+
+	bool LogService::isLogEnabled(const LogConfig *logConfig)
+	{
+		return logConfig != nullptr && (logConfig->getIsConsoleLog() || !isBlank(logConfig->getFilePath()));
+	}
+
 	std::wstring LogService::logInfo(const LogConfig *logConfig, const std::wstring &id, const std::wstring &message)
 	{
-		return LogService::_logMessage(logConfig, LogType::Info, id, message);
+		return LogService::_logMessage(logConfig, LogType::Info, LogCategory::General, id, message);
 	}
 
 	std::wstring LogService::LogDebug(const LogConfig *logConfig, const std::wstring &id, const std::wstring &message)
 	{
-		if (!logConfig->getIsLogDebug())
+		if (logConfig == nullptr || !logConfig->getIsLogDebug())
 			return L"";
-		return LogService::_logMessage(logConfig, LogType::Debug, id, message);
+		return LogService::_logMessage(logConfig, LogType::Debug, LogCategory::General, id, message);
 	}
 
 	std::wstring LogService::LogWarning(const LogConfig *logConfig, const std::wstring &id, const std::wstring &message)
 	{
-		return LogService::_logMessage(logConfig, LogType::Warning, id, message);
+		return LogService::_logMessage(logConfig, LogType::Warning, LogCategory::General, id, message);
 	}
 
 	std::wstring LogService::LogError(const LogConfig *logConfig, const std::wstring &id, const std::wstring &message)
 	{
-		return LogService::_logMessage(logConfig, LogType::Error, id, message);
+		return LogService::_logMessage(logConfig, LogType::Error, LogCategory::General, id, message);
 	}
 
 	std::wstring LogService::LogThread(const LogConfig *logConfig, const std::wstring &id, const std::wstring &message)
 	{
 		if (logConfig == nullptr || !logConfig->getIsLogThread())
 			return L"";
-		return LogService::_logMessage(logConfig, LogType::Info, id, message);
+		return LogService::_logMessage(logConfig, LogType::Info, LogCategory::Thread, id, message);
 	}
 
 	std::wstring LogService::LogTerminal(const LogConfig *logConfig, const std::wstring &id, const std::wstring &message)
 	{
 		if (logConfig == nullptr || !logConfig->getIsLogTerminal())
 			return L"";
-		return LogService::_logMessage(logConfig, LogType::Info, id, message);
+		return LogService::_logMessage(logConfig, LogType::Info, LogCategory::Terminal, id, message);
 	}
 
 	std::wstring LogService::LogTerminalResult(const LogConfig *logConfig, const std::wstring &id, const std::wstring &message)
 	{
 		if (logConfig == nullptr || !logConfig->getIsLogTerminalResult())
 			return L"";
-		return LogService::_logMessage(logConfig, LogType::Info, id, message);
+		return LogService::_logMessage(logConfig, LogType::Info, LogCategory::TerminalResult, id, message);
 	}
 
 	std::wstring LogService::LogProcess(const LogConfig *logConfig, const std::wstring &id, const std::wstring &message)
 	{
 		if (logConfig == nullptr || !logConfig->getIsLogProcess())
 			return L"";
-		return LogService::_logMessage(logConfig, LogType::Info, id, message);
+		return LogService::_logMessage(logConfig, LogType::Info, LogCategory::Process, id, message);
 	}
 
 	std::wstring LogService::LogProcessResult(const LogConfig *logConfig, const std::wstring &id, const std::wstring &message)
 	{
 		if (logConfig == nullptr || !logConfig->getIsLogProcessResult())
 			return L"";
-		return LogService::_logMessage(logConfig, LogType::Info, id, message);
+		return LogService::_logMessage(logConfig, LogType::Info, LogCategory::ProcessResult, id, message);
 	}
 
 	std::wstring LogService::LogSQL(const LogConfig *logConfig, const std::wstring &id, const std::wstring &message)
 	{
 		if (logConfig == nullptr || !logConfig->getIsLogSQL())
 			return L"";
-		return LogService::_logMessage(logConfig, LogType::Info, id, message);
+		return LogService::_logMessage(logConfig, LogType::Info, LogCategory::SQL, id, message);
 	}
 
 	std::wstring LogService::LogSQLResult(const LogConfig *logConfig, const std::wstring &id, const std::wstring &message)
 	{
 		if (logConfig == nullptr || !logConfig->getIsLogSQLResult())
 			return L"";
-		return LogService::_logMessage(logConfig, LogType::Info, id, message);
+		return LogService::_logMessage(logConfig, LogType::Info, LogCategory::SQLResult, id, message);
 	}
 }
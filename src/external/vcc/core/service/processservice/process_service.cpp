@@ -1,6 +1,10 @@
 #include "process_service.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
+#include <functional>
+#include <memory>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string>
@@ -10,8 +14,20 @@
 // win process is implemented in process_service_win.hpp
 #include "process_service_win.hpp"
 #else
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <string.h>
+#include <sys/resource.h>
 #include <sys/wait.h>
 #include <unistd.h>
+
+// posix_spawn can set child working directory since glibc 2.29, otherwise fork and chdir in child
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 29))
+#define VCC_PROCESS_SPAWN_CHDIR
+#endif
 #endif
 
 #include "exception_macro.hpp"
@@ -19,21 +35,201 @@
 #include "log_config.hpp"
 #include "log_service.hpp"
 #include "string_helper.hpp"
+#include "thread_helper.hpp"
 
 namespace vcc
 {
+        #ifndef _WIN32
+        namespace
+        {
+            // Start child with stdout and stderr redirected, working directory is set for child only
+            // Pipes are created with O_CLOEXEC so children started by other threads do not hold them
+            pid_t spawnProcess(std::vector<char *> &tokens, const std::string &workspace, const ProcessOption *option, int stdoutFd, int stderrFd)
+            {
+                int64_t cpuTimeLimit = option != nullptr ? option->getCpuTimeLimit() : -1;
+                int64_t addressSpaceLimit = option != nullptr ? option->getAddressSpaceLimit() : -1;
+                #ifdef VCC_PROCESS_SPAWN_CHDIR
+                // posix_spawn cannot set resource limit of child, use fork in that case
+                if (cpuTimeLimit < 0 && addressSpaceLimit < 0) {
+                    posix_spawn_file_actions_t fileActions;
+                    posix_spawn_file_actions_init(&fileActions);
+                    posix_spawn_file_actions_adddup2(&fileActions, stdoutFd, STDOUT_FILENO);
+                    posix_spawn_file_actions_adddup2(&fileActions, stderrFd, STDERR_FILENO);
+                    if (!workspace.empty())
+                        posix_spawn_file_actions_addchdir_np(&fileActions, workspace.c_str());
+                    pid_t pid = -1;
+                    int errorCode = posix_spawnp(&pid, tokens[0], &fileActions, nullptr, tokens.data(), environ);
+                    posix_spawn_file_actions_destroy(&fileActions);
+                    if (errorCode != 0)
+                        throw std::runtime_error("posix_spawn: " + std::string(tokens[0]) + ": " + strerror(errorCode));
+                    return pid;
+                }
+                #endif
+                pid_t pid = fork();
+                if (pid < 0)
+                    throw std::runtime_error("fork: " + std::string(strerror(errno)));
+                if (pid == 0) {
+                    // child process
+                    dup2(stdoutFd, STDOUT_FILENO);
+                    dup2(stderrFd, STDERR_FILENO);
+                    if (!workspace.empty() && chdir(workspace.c_str()) != 0) {
+                        perror("chdir: ");
+                        _exit(127);
+                    }
+                    if (cpuTimeLimit >= 0) {
+                        struct rlimit limit = { (rlim_t)cpuTimeLimit, (rlim_t)cpuTimeLimit };
+                        if (setrlimit(RLIMIT_CPU, &limit) != 0) {
+                            perror("setrlimit: ");
+                            _exit(127);
+                        }
+                    }
+                    if (addressSpaceLimit >= 0) {
+                        struct rlimit limit = { (rlim_t)addressSpaceLimit, (rlim_t)addressSpaceLimit };
+                        if (setrlimit(RLIMIT_AS, &limit) != 0) {
+                            perror("setrlimit: ");
+                            _exit(127);
+                        }
+                    }
+                    execvp(tokens[0], tokens.data());
+                    perror("execvp: ");
+                    _exit(127);
+                }
+                return pid;
+            }
+
+            // Send SIGTERM when timeout or cancelled, then SIGKILL if child is still alive after grace period
+            class ProcessTerminator
+            {
+                private:
+                    pid_t _Pid = -1;
+                    const CancellationToken *_CancellationToken = nullptr;
+                    bool _IsDeadline = false;
+                    std::chrono::steady_clock::time_point _Deadline;
+                    std::chrono::milliseconds _KillGracePeriod = std::chrono::milliseconds(2000);
+                    std::chrono::steady_clock::time_point _KillTime;
+                    bool _IsTimeout = false;
+                    bool _IsTerminated = false;
+                    bool _IsKilled = false;
+
+                public:
+                    ProcessTerminator(pid_t pid, const ProcessOption *option, const CancellationToken *cancellationToken)
+                        : _Pid(pid), _CancellationToken(cancellationToken)
+                    {
+                        if (option != nullptr) {
+                            if (option->getTimeout() >= 0) {
+                                _IsDeadline = true;
+                                _Deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(option->getTimeout());
+                            }
+                            _KillGracePeriod = std::chrono::milliseconds(std::max(option->getKillGracePeriod(), (int64_t)0));
+                        }
+                    }
+
+                    bool isTimeout() const { return _IsTimeout; }
+                    bool isKilled() const { return _IsKilled; }
+
+                    // Millisecond for poll before next check, -1 means wait until output
+                    int getWaitTime() const
+                    {
+                        if (_IsKilled)
+                            return 0;
+                        auto now = std::chrono::steady_clock::now();
+                        int64_t waitTime = -1;
+                        if (_IsTerminated)
+                            waitTime = std::chrono::duration_cast<std::chrono::milliseconds>(_KillTime - now).count();
+                        else if (_IsDeadline)
+                            waitTime = std::chrono::duration_cast<std::chrono::milliseconds>(_Deadline - now).count();
+                        // cancellation callback sends SIGTERM, check regularly to escalate
+                        if (!_IsTerminated && _CancellationToken != nullptr && (waitTime < 0 || waitTime > 100))
+                            waitTime = 100;
+                        return waitTime < 0 && (_IsTerminated || _IsDeadline) ? 0 : (int)waitTime;
+                    }
+
+                    void check()
+                    {
+                        auto now = std::chrono::steady_clock::now();
+                        if (!_IsTerminated) {
+                            bool isCancelled = _CancellationToken != nullptr && _CancellationToken->isCancelled();
+                            if (_IsDeadline && now >= _Deadline && !isCancelled)
+                                _IsTimeout = true;
+                            if (_IsTimeout || isCancelled) {
+                                kill(_Pid, SIGTERM);
+                                _IsTerminated = true;
+                                _KillTime = now + _KillGracePeriod;
+                            }
+                        } else if (!_IsKilled && now >= _KillTime) {
+                            kill(_Pid, SIGKILL);
+                            _IsKilled = true;
+                        }
+                    }
+            };
+
+            // Read stdout and stderr together until both reach EOF
+            // Reading one pipe to EOF first blocks when child fills the other pipe buffer
+            // onOutput and onError are called after each stdout and stderr read, they may consume and erase the beginning of buffer
+            // Stop reading when child is killed, pipes may still be held by grandchild
+            void readPipes(int stdoutFd, int stderrFd, std::string &output, std::string &error, const std::function<void(std::string &)> &onOutput, const std::function<void(std::string &)> &onError, ProcessTerminator &terminator)
+            {
+                const size_t chunkSize = 64 * 1024;
+                struct pollfd fds[2];
+                fds[0].fd = stdoutFd;
+                fds[0].events = POLLIN;
+                fds[1].fd = stderrFd;
+                fds[1].events = POLLIN;
+                std::string *buffers[2] = { &output, &error };
+                int openCount = 2;
+                while (openCount > 0) {
+                    int readyCount = poll(fds, 2, terminator.getWaitTime());
+                    if (readyCount < 0 && errno != EINTR)
+                        break;
+                    terminator.check();
+                    if (terminator.isKilled())
+                        break;
+                    if (readyCount <= 0)
+                        continue;
+                    for (size_t i = 0; i < 2; i++) {
+                        if (fds[i].fd < 0 || fds[i].revents == 0)
+                            continue;
+                        // read into the end of growable buffer directly
+                        std::string &buffer = *buffers[i];
+                        size_t size = buffer.size();
+                        buffer.resize(size + chunkSize);
+                        ssize_t count = read(fds[i].fd, buffer.data() + size, chunkSize);
+                        buffer.resize(size + (count > 0 ? count : 0));
+                        if (i == 0 && count > 0 && onOutput != nullptr)
+                            onOutput(buffer);
+                        else if (i == 1 && count > 0 && onError != nullptr)
+                            onError(buffer);
+                        if (count == 0 || (count < 0 && errno != EINTR && errno != EAGAIN)) {
+                            fds[i].fd = -1;
+                            openCount--;
+                        }
+                    }
+                }
+            }
+        }
+        #endif
 
         #ifdef _WIN32
-        std::wstring ProcessService::_ExecuteWindow(const std::wstring &command)
+        std::shared_ptr<ProcessResult> ProcessService::_ExecuteWindow(const std::wstring &command, const std::wstring &workspace)
         {
-            return ProcessServiceWin(command);
+            auto result = std::make_shared<ProcessResult>();
+            try {
+                result->setOutput(ProcessServiceWin(command, workspace));
+                result->setExitCode(0);
+            } catch (std::exception &e) {
+                result->setExitCode(1);
+                result->setError(str2wstr(e.what()));
+            }
+            return result;
         }
         #else
-        std::wstring ProcessService::_ExecuteLinux(const std::string &command)
+        std::shared_ptr<ProcessResult> ProcessService::_ExecuteLinux(const std::string &command, const std::string &workspace, const ProcessOption *option, const std::function<void(std::string &)> &onOutput, const std::function<void(std::string &)> &onError, const CancellationToken *cancellationToken)
         {
-            std::wstring result = L"";
+            auto result = std::make_shared<ProcessResult>();
             // convert to token
             std::vector<std::string> cmdTokens = ProcessService::ParseCmdLinux(command);
+            if (cmdTokens.empty())
+                throw std::runtime_error("Command is empty.");
             std::vector<char *> tokens;
             for (size_t i = 0; i < cmdTokens.size(); i++) {
                 tokens.push_back((char *)(cmdTokens[i].c_str()));
@@ -43,66 +239,170 @@ namespace vcc
             // process
             int pipefd_stdout[2];
             int pipefd_stderr[2];
-            int status;
+            int status = 0;
 
             // pipe
-            if (pipe(pipefd_stdout) < 0)
-                perror("pipe: ");
-            if (pipe(pipefd_stderr) < 0)
-                perror("pipe: ");
-
-            pid_t pid = fork();
-            if (pid < 0) {
-                perror("fork: ");
-            } else if (pid == 0) {
-                // child process
-                // duplicate writing end to stdout
-                dup2(pipefd_stdout[1], STDOUT_FILENO);
-                dup2(pipefd_stderr[1], STDERR_FILENO);
+            if (pipe2(pipefd_stdout, O_CLOEXEC) < 0)
+                throw std::runtime_error("pipe: " + std::string(strerror(errno)));
+            if (pipe2(pipefd_stderr, O_CLOEXEC) < 0) {
+                int errorCode = errno;
+                close(pipefd_stdout[0]);
+                close(pipefd_stdout[1]);
+                throw std::runtime_error("pipe: " + std::string(strerror(errorCode)));
+            }
+
+            pid_t pid = -1;
+            try {
+                pid = spawnProcess(tokens, workspace, option, pipefd_stdout[1], pipefd_stderr[1]);
+            } catch (...) {
                 close(pipefd_stdout[0]);
                 close(pipefd_stdout[1]);
                 close(pipefd_stderr[0]);
                 close(pipefd_stderr[1]);
-                if (execvp(tokens[0], tokens.data())) {
-                    perror("execvp: ");
-                    exit(-1);
-                }
+                throw;
             }
             // parent process
             // close writing end of pipe
             close(pipefd_stdout[1]);
             close(pipefd_stderr[1]);
 
-            FILE *fStdout = fdopen(pipefd_stdout[0], "r");
-            FILE *fStderr = fdopen(pipefd_stderr[0], "r");
+            // terminate child when cancelled, pipes reach EOF after child exit
+            int64_t cancelCallbackID = -1;
+            if (cancellationToken != nullptr && pid > 0)
+                cancelCallbackID = cancellationToken->registerCallback([pid]() { kill(pid, SIGTERM); });
 
-            char ch;
-            std::string tmpResult;
-            while (!feof(fStdout)) {
-                ch = fgetc(fStdout);
-                tmpResult += ch;
+            ProcessTerminator terminator(pid, option, cancellationToken);
+            std::string tmpResult, error;
+            try {
+                readPipes(pipefd_stdout[0], pipefd_stderr[0], tmpResult, error, onOutput, onError, terminator);
+            } catch (...) {
+                // callback failed, child is not needed anymore
+                kill(pid, SIGKILL);
+                close(pipefd_stdout[0]);
+                close(pipefd_stderr[0]);
+                if (cancellationToken != nullptr)
+                    cancellationToken->unregisterCallback(cancelCallbackID);
+                waitpid(pid, &status, 0);
+                throw;
             }
-            result = str2wstr(tmpResult);
+            close(pipefd_stdout[0]);
+            close(pipefd_stderr[0]);
 
-            std::string error;
-            while (!feof(fStderr)) {
-                ch = fgetc(fStderr);
-                error += ch;
-            }
-            wait(&status);
-            if (status != 0)
-                throw std::runtime_error(error);
+            // unregister before reaping child, pid may be reused afterward, unregisterCallback waits for kill already running
+            if (cancellationToken != nullptr)
+                cancellationToken->unregisterCallback(cancelCallbackID);
+            waitpid(pid, &status, 0);
+            if (cancellationToken != nullptr)
+                cancellationToken->throwIfCancelled();
+
+            result->setOutput(str2wstr(tmpResult));
+            result->setError(str2wstr(error));
+            result->setIsTimeout(terminator.isTimeout());
+            if (WIFEXITED(status))
+                result->setExitCode(WEXITSTATUS(status));
+            else if (WIFSIGNALED(status))
+                result->setSignal(WTERMSIG(status));
             return result;
         }
         #endif
 
-        std::wstring ProcessService::_Execute(const std::wstring &command)
+        std::shared_ptr<ProcessResult> ProcessService::_Execute(const std::wstring &command, const std::wstring &workspace, const ProcessOption *option, const CancellationToken *cancellationToken)
+        {
+            if (cancellationToken != nullptr)
+                cancellationToken->throwIfCancelled();
+            #ifdef _WIN32
+            return ProcessService::_ExecuteWindow(command, workspace);
+            #else
+            return ProcessService::_ExecuteLinux(wstr2str(command), wstr2str(workspace), option, nullptr, nullptr, cancellationToken);
+            #endif
+        }
+
+        std::shared_ptr<ProcessResult> ProcessService::_ExecuteStreaming(const std::wstring &command, const std::wstring &workspace, const ProcessOption *option, const std::function<void(const std::wstring &)> &onLine, const CancellationToken *cancellationToken)
+        {
+            if (cancellationToken != nullptr)
+                cancellationToken->throwIfCancelled();
+            auto emitLine = [&onLine](std::wstring &line) {
+                if (!line.empty() && line.back() == L'\r')
+                    line.pop_back();
+                onLine(line);
+            };
+            std::shared_ptr<ProcessResult> result = nullptr;
+            #ifdef _WIN32
+            result = ProcessService::_ExecuteWindow(command, workspace);
+            std::wstring remaining = result->getOutput();
+            size_t start = 0;
+            size_t end = remaining.find(L'\n');
+            while (end != std::wstring::npos) {
+                std::wstring line = remaining.substr(start, end - start);
+                emitLine(line);
+                start = end + 1;
+                end = remaining.find(L'\n', start);
+            }
+            remaining = remaining.substr(start);
+            #else
+            // complete lines are converted and delivered as soon as they are read, partial line is kept in output buffer
+            result = ProcessService::_ExecuteLinux(wstr2str(command), wstr2str(workspace), option, [&emitLine](std::string &output) {
+                size_t start = 0;
+                size_t end = output.find('\n');
+                while (end != std::string::npos) {
+                    std::wstring line = str2wstr(output.substr(start, end - start));
+                    emitLine(line);
+                    start = end + 1;
+                    end = output.find('\n', start);
+                }
+                output.erase(0, start);
+            }, nullptr, cancellationToken);
+            std::wstring remaining = result->getOutput();
+            #endif
+            if (!remaining.empty())
+                emitLine(remaining);
+            result->setOutput(L"");
+            return result;
+        }
+
+        std::shared_ptr<ProcessResult> ProcessService::_ExecuteErrorStreaming(const std::wstring &command, const std::wstring &workspace, const ProcessOption *option, const std::function<void(const std::wstring &)> &onErrorLine, const CancellationToken *cancellationToken)
         {
+            if (cancellationToken != nullptr)
+                cancellationToken->throwIfCancelled();
+            std::shared_ptr<ProcessResult> result = nullptr;
             #ifdef _WIN32
-            return ProcessService::_ExecuteWindow(command);
+            (void)option;
+            (void)onErrorLine;
+            result = ProcessService::_ExecuteWindow(command, workspace);
             #else
-            return ProcessService::_ExecuteLinux(wstr2str(command));
+            // progress is redrawn by carriage return, only lines ended by line feed are kept for error message
+            std::string errorLines = "";
+            auto emitLine = [&onErrorLine](const std::string &line) {
+                if (!line.empty())
+                    onErrorLine(str2wstr(line));
+            };
+            result = ProcessService::_ExecuteLinux(wstr2str(command), wstr2str(workspace), option, nullptr, [&](std::string &error) {
+                size_t start = 0;
+                size_t end = error.find_first_of("\r\n");
+                while (end != std::string::npos) {
+                    std::string line = error.substr(start, end - start);
+                    if (error[end] == '\n')
+                        errorLines += line + "\n";
+                    emitLine(line);
+                    start = end + 1;
+                    end = error.find_first_of("\r\n", start);
+                }
+                error.erase(0, start);
+            }, cancellationToken);
+            std::string remaining = wstr2str(result->getError());
+            emitLine(remaining);
+            result->setError(str2wstr(errorLines + remaining));
             #endif
+            return result;
+        }
+
+        void ProcessService::_ThrowIfFailed(const ProcessResult *result, const ProcessOption *option)
+        {
+            if (result == nullptr || result->isSuccess())
+                return;
+            if (result->getIsTimeout())
+                throw std::runtime_error("Process timeout after " + std::to_string(option != nullptr ? option->getTimeout() : 0) + " ms. " + wstr2str(result->getError()));
+            throw std::runtime_error(wstr2str(result->getError()));
         }
 
         std::vector<std::string> ProcessService::ParseCmdLinux(const std::string &cmd)
@@ -146,47 +446,105 @@ namespace vcc
 
         std::wstring ProcessService::execute(const LogConfig *logConfig, const std::wstring &id, const std::wstring &command)
         {
-            LogService::LogProcess(logConfig, id, command);
+            return ProcessService::execute(logConfig, id, L"", command);
+        }
 
+        std::wstring ProcessService::execute(const LogConfig *logConfig, const std::wstring &id, const std::wstring &workspace, const std::wstring &command, const CancellationToken *cancellationToken)
+        {
             std::wstring result = L"";
             try {
-                result = ProcessService::_Execute(command);
+                auto processResult = ProcessService::executeWithResult(logConfig, id, workspace, command, nullptr, cancellationToken);
+                ProcessService::_ThrowIfFailed(processResult.get(), nullptr);
+                result = processResult->getOutput();
             } catch (std::exception &e) {
                 THROW_EXCEPTION(e);
             }
-            LogService::LogProcessResult(logConfig, id, result);
-            trim(result);
             return result;
         }
 
-        std::wstring ProcessService::execute(const LogConfig *logConfig, const std::wstring &id, const std::wstring &workspace, const std::wstring &command)
+        std::shared_ptr<ProcessResult> ProcessService::executeWithResult(const LogConfig *logConfig, const std::wstring &id, const std::wstring &workspace, const std::wstring &command, const ProcessOption *option, const CancellationToken *cancellationToken)
         {
-            std::wstring currentDirectory = L"";
-            std::wstring result = L"";
+            std::shared_ptr<ProcessResult> result = nullptr;
             try {
-                currentDirectory = std::filesystem::current_path().wstring();
-                if (!isBlank(workspace))
-                    std::filesystem::current_path(workspace);
+                // working directory is set for child process only, current directory of this process is not changed
+                if (!isBlank(workspace) && !std::filesystem::is_directory(workspace))
+                    THROW_EXCEPTION_MSG(ExceptionType::DirectoryNotFound, workspace + L": Directory not found.");
+                LogService::LogProcess(logConfig, id, command);
+                result = ProcessService::_Execute(command, workspace, option, cancellationToken);
+                std::wstring output = result->getOutput();
+                LogService::LogProcessResult(logConfig, id, output);
+                trim(output);
+                result->setOutput(output);
             } catch (std::exception &e) {
-                if (!isBlank(workspace))
-                    std::filesystem::current_path(currentDirectory);
                 THROW_EXCEPTION(e);
-                return result;
             }
+            return result;
+        }
+
+        void ProcessService::executeStreaming(const LogConfig *logConfig, const std::wstring &id, const std::wstring &workspace, const std::wstring &command, const std::function<void(const std::wstring &)> &onLine, const CancellationToken *cancellationToken, const ProcessOption *option)
+        {
             try {
-                result = ProcessService::execute(logConfig, id, command);
+                if (!isBlank(workspace) && !std::filesystem::is_directory(workspace))
+                    THROW_EXCEPTION_MSG(ExceptionType::DirectoryNotFound, workspace + L": Directory not found.");
+                LogService::LogProcess(logConfig, id, command);
+                bool isLogResult = logConfig != nullptr && logConfig->getIsLogProcessResult();
+                auto result = ProcessService::_ExecuteStreaming(command, workspace, option, [&](const std::wstring &line) {
+                    if (isLogResult)
+                        LogService::LogProcessResult(logConfig, id, line);
+                    onLine(line);
+                }, cancellationToken);
+                ProcessService::_ThrowIfFailed(result.get(), option);
             } catch (std::exception &e) {
-                if (!isBlank(workspace))
-                    std::filesystem::current_path(currentDirectory);
                 THROW_EXCEPTION(e);
             }
+        }
+
+        std::wstring ProcessService::executeErrorStreaming(const LogConfig *logConfig, const std::wstring &id, const std::wstring &workspace, const std::wstring &command, const std::function<void(const std::wstring &)> &onErrorLine, const CancellationToken *cancellationToken, const ProcessOption *option)
+        {
+            std::wstring result = L"";
             try {
-                if (!isBlank(workspace))
-                    std::filesystem::current_path(currentDirectory);
+                if (!isBlank(workspace) && !std::filesystem::is_directory(workspace))
+                    THROW_EXCEPTION_MSG(ExceptionType::DirectoryNotFound, workspace + L": Directory not found.");
+                LogService::LogProcess(logConfig, id, command);
+                auto processResult = ProcessService::_ExecuteErrorStreaming(command, workspace, option, onErrorLine, cancellationToken);
+                ProcessService::_ThrowIfFailed(processResult.get(), option);
+                result = processResult->getOutput();
+                LogService::LogProcessResult(logConfig, id, result);
+                trim(result);
             } catch (std::exception &e) {
                 THROW_EXCEPTION(e);
-                return result;
-            }            
+            }
             return result;
         }
+
+        std::vector<std::shared_ptr<ProcessResult>> ProcessService::executeBatch(const LogConfig *logConfig, const std::wstring &id, const std::wstring &workspace, const std::vector<std::wstring> &commands, const int64_t &parallelism, const ProcessOption *option, const CancellationToken *cancellationToken)
+        {
+            std::vector<std::shared_ptr<ProcessResult>> results(commands.size());
+            try {
+                if (!isBlank(workspace) && !std::filesystem::is_directory(workspace))
+                    THROW_EXCEPTION_MSG(ExceptionType::DirectoryNotFound, workspace + L": Directory not found.");
+                // result is stored at index of command
+                executeParallel(commands.size(), parallelism, [&](const size_t &index) {
+                    if (cancellationToken != nullptr && cancellationToken->isCancelled())
+                        return;
+                    try {
+                        results[index] = ProcessService::executeWithResult(logConfig, id, workspace, commands[index], option, cancellationToken);
+                    } catch (std::exception &e) {
+                        auto result = std::make_shared<ProcessResult>();
+                        const IException *ie = dynamic_cast<const IException *>(&e);
+                        result->setError(ie != nullptr ? ie->getErrorMessage() : str2wstr(e.what()));
+                        results[index] = result;
+                    } catch (...) {
+                        auto result = std::make_shared<ProcessResult>();
+                        result->setError(L"Unknown exception.");
+                        results[index] = result;
+                    }
+                });
+                if (cancellationToken != nullptr)
+                    cancellationToken->throwIfCancelled();
+            } catch (std::exception &e) {
+                THROW_EXCEPTION(e);
+            }
+            return results;
+        }
 }
\ No newline at end of file
@@ -22,12 +22,12 @@ namespace vcc
 
     // HANDLE hFile = NULL;
     
-    void CreateChildProcess(const std::wstring &command); 
+    void CreateChildProcess(const std::wstring &command, const std::wstring &workspace); 
     //void WriteToPipe(void); 
     std::wstring ReadStdOut(void);
     std::wstring ReadStdError(void);
     
-    std::wstring ProcessServiceWin(const std::wstring &command)
+    std::wstring ProcessServiceWin(const std::wstring &command, const std::wstring &workspace)
     {
         // ref to https://learn.microsoft.com/en-us/windows/win32/procthread/creating-a-child-process-with-redirected-input-and-output
         SECURITY_ATTRIBUTES saAttr;
@@ -54,7 +54,7 @@ namespace vcc
         //     throw std::runtime_error("SetHandleInformation: " + std::to_string(GetLastError()));
         
         // Child Process
-        CreateChildProcess(command);
+        CreateChildProcess(command, workspace);
 
         // TODO: std-in
         // hFile = CreateFileW(
@@ -76,7 +76,7 @@ namespace vcc
         return ReadStdOut();
     } 
     
-    void CreateChildProcess(const std::wstring &command)
+    void CreateChildProcess(const std::wstring &command, const std::wstring &workspace)
     { 
         PROCESS_INFORMATION pi; 
         STARTUPINFOW si;
@@ -101,7 +101,7 @@ namespace vcc
             TRUE,           // handles are inherited 
             0,              // creation flags 
             NULL,           // use parent's environment 
-            NULL,           // use parent's current directory 
+            workspace.empty() ? NULL : workspace.c_str(), // child current directory, empty means parent's current directory
             &si,            // STARTUPINFOW pointer 
             &pi))           // receives PROCESS_INFORMATION
             throw std::runtime_error("Create Process: " + std::to_string(GetLastError()));
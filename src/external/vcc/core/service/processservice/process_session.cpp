@@ -0,0 +1,258 @@
+#include "process_session.hpp"
+
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <spawn.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+// posix_spawn can set child working directory since glibc 2.29, otherwise fork and chdir in child, same as ProcessService
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 29))
+#define VCC_PROCESS_SPAWN_CHDIR
+#endif
+#endif
+
+#include "exception_macro.hpp"
+#include "exception_type.hpp"
+#include "process_service.hpp"
+#include "string_helper.hpp"
+
+namespace vcc
+{
+    ProcessSession::ProcessSession(const std::wstring &workspace, const std::wstring &command)
+    {
+        TRY
+            #ifdef _WIN32
+            THROW_EXCEPTION_MSG(ExceptionType::NotSupport, L"ProcessSession is not supported on Windows.");
+            #else
+            std::vector<std::string> cmdTokens = ProcessService::ParseCmdLinux(wstr2str(command));
+            if (cmdTokens.empty())
+                THROW_EXCEPTION_MSG(ExceptionType::ArgumentNotValid, L"Command is empty.");
+            std::vector<char *> tokens;
+            for (auto &token : cmdTokens)
+                tokens.push_back(token.data());
+            tokens.push_back(nullptr);
+
+            int pipefd_stdin[2];
+            int pipefd_stdout[2];
+            if (pipe2(pipefd_stdin, O_CLOEXEC) < 0)
+                THROW_EXCEPTION_MSG(ExceptionType::CustomError, L"pipe: " + str2wstr(strerror(errno)));
+            if (pipe2(pipefd_stdout, O_CLOEXEC) < 0) {
+                int errorCode = errno;
+                ::close(pipefd_stdin[0]);
+                ::close(pipefd_stdin[1]);
+                THROW_EXCEPTION_MSG(ExceptionType::CustomError, L"pipe: " + str2wstr(strerror(errorCode)));
+            }
+
+            std::string workspaceStr = wstr2str(workspace);
+            pid_t pid = -1;
+            #ifdef VCC_PROCESS_SPAWN_CHDIR
+            std::wstring spawnFunction = L"posix_spawn";
+            posix_spawn_file_actions_t fileActions;
+            posix_spawn_file_actions_init(&fileActions);
+            posix_spawn_file_actions_adddup2(&fileActions, pipefd_stdin[0], STDIN_FILENO);
+            posix_spawn_file_actions_adddup2(&fileActions, pipefd_stdout[1], STDOUT_FILENO);
+            posix_spawn_file_actions_addopen(&fileActions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+            if (!workspaceStr.empty())
+                posix_spawn_file_actions_addchdir_np(&fileActions, workspaceStr.c_str());
+            int errorCode = posix_spawnp(&pid, tokens[0], &fileActions, nullptr, tokens.data(), environ);
+            posix_spawn_file_actions_destroy(&fileActions);
+            #else
+            // Child cannot report chdir failure, check before fork so that command never runs in wrong directory
+            std::wstring spawnFunction = L"fork";
+            int errorCode = 0;
+            struct stat workspaceStat;
+            if (!workspaceStr.empty() && (stat(workspaceStr.c_str(), &workspaceStat) != 0 || !S_ISDIR(workspaceStat.st_mode))) {
+                spawnFunction = L"chdir";
+                errorCode = ENOTDIR;
+            } else {
+                pid = fork();
+                if (pid < 0)
+                    errorCode = errno;
+                else if (pid == 0) {
+                    // child process
+                    dup2(pipefd_stdin[0], STDIN_FILENO);
+                    dup2(pipefd_stdout[1], STDOUT_FILENO);
+                    int nullFd = open("/dev/null", O_WRONLY);
+                    if (nullFd >= 0)
+                        dup2(nullFd, STDERR_FILENO);
+                    if (!workspaceStr.empty() && chdir(workspaceStr.c_str()) != 0)
+                        _exit(127);
+                    execvp(tokens[0], tokens.data());
+                    _exit(127);
+                }
+            }
+            #endif
+            ::close(pipefd_stdin[0]);
+            ::close(pipefd_stdout[1]);
+            if (errorCode != 0) {
+                ::close(pipefd_stdin[1]);
+                ::close(pipefd_stdout[0]);
+                THROW_EXCEPTION_MSG(ExceptionType::CustomError, spawnFunction + L": " + command + L": " + str2wstr(strerror(errorCode)));
+            }
+            _Pid = pid;
+            _StdinFd = pipefd_stdin[1];
+            _StdoutFd = pipefd_stdout[0];
+            #endif
+        CATCH
+    }
+
+    ProcessSession::~ProcessSession()
+    {
+        try {
+            close();
+        } catch (...) {
+        }
+    }
+
+    bool ProcessSession::isRunning() const
+    {
+        return _Pid > 0 && _StdoutFd >= 0;
+    }
+
+    bool ProcessSession::fill()
+    {
+        #ifndef _WIN32
+        if (_StdoutFd < 0)
+            return false;
+        // drop returned part before reading more
+        if (_BufferPos > 0) {
+            _Buffer.erase(0, _BufferPos);
+            _BufferPos = 0;
+        }
+        const size_t chunkSize = 64 * 1024;
+        size_t size = _Buffer.size();
+        _Buffer.resize(size + chunkSize);
+        ssize_t count = -1;
+        do {
+            count = ::read(_StdoutFd, _Buffer.data() + size, chunkSize);
+        } while (count < 0 && errno == EINTR);
+        _Buffer.resize(size + (count > 0 ? count : 0));
+        if (count <= 0) {
+            ::close(_StdoutFd);
+            _StdoutFd = -1;
+            return false;
+        }
+        return true;
+        #else
+        return false;
+        #endif
+    }
+
+    void ProcessSession::write(const std::string &data)
+    {
+        TRY
+            #ifndef _WIN32
+            if (_StdinFd < 0)
+                THROW_EXCEPTION_MSG(ExceptionType::CustomError, L"Process session is closed.");
+            // block SIGPIPE in this thread, child may have exited
+            sigset_t pipeSet, oldSet;
+            sigemptyset(&pipeSet);
+            sigaddset(&pipeSet, SIGPIPE);
+            pthread_sigmask(SIG_BLOCK, &pipeSet, &oldSet);
+            size_t pos = 0;
+            int errorCode = 0;
+            while (pos < data.length()) {
+                ssize_t count = ::write(_StdinFd, data.c_str() + pos, data.length() - pos);
+                if (count < 0) {
+                    if (errno == EINTR)
+                        continue;
+                    errorCode = errno;
+                    break;
+                }
+                pos += count;
+            }
+            if (errorCode == EPIPE) {
+                // consume pending SIGPIPE before unblock
+                struct timespec zeroTimeout = { 0, 0 };
+                sigtimedwait(&pipeSet, nullptr, &zeroTimeout);
+            }
+            pthread_sigmask(SIG_SETMASK, &oldSet, nullptr);
+            if (errorCode != 0)
+                THROW_EXCEPTION_MSG(ExceptionType::CustomError, L"write: " + str2wstr(strerror(errorCode)));
+            #else
+            (void)data;
+            #endif
+        CATCH
+    }
+
+    std::string ProcessSession::readLine()
+    {
+        TRY
+            size_t searchPos = _BufferPos;
+            while (true) {
+                size_t end = _Buffer.find('\n', searchPos);
+                if (end != std::string::npos) {
+                    std::string line = _Buffer.substr(_BufferPos, end - _BufferPos);
+                    _BufferPos = end + 1;
+                    return line;
+                }
+                searchPos = _Buffer.size() - _BufferPos;
+                if (!fill())
+                    THROW_EXCEPTION_MSG(ExceptionType::CustomError, L"Process session ended.");
+                // fill moves unread part to the beginning
+                searchPos += _BufferPos;
+            }
+        CATCH
+        return "";
+    }
+
+    std::string ProcessSession::read(const size_t &size)
+    {
+        TRY
+            while (_Buffer.size() - _BufferPos < size) {
+                if (!fill())
+                    THROW_EXCEPTION_MSG(ExceptionType::CustomError, L"Process session ended.");
+            }
+            std::string result = _Buffer.substr(_BufferPos, size);
+            _BufferPos += size;
+            return result;
+        CATCH
+        return "";
+    }
+
+    void ProcessSession::close(const int64_t &gracePeriod)
+    {
+        #ifndef _WIN32
+        if (_StdinFd >= 0) {
+            ::close(_StdinFd);
+            _StdinFd = -1;
+        }
+        if (_StdoutFd >= 0) {
+            ::close(_StdoutFd);
+            _StdoutFd = -1;
+        }
+        _Buffer.clear();
+        _BufferPos = 0;
+        if (_Pid <= 0)
+            return;
+        // child exits after stdin is closed
+        pid_t pid = (pid_t)_Pid;
+        _Pid = -1;
+        int status = 0;
+        auto killTime = std::chrono::steady_clock::now() + std::chrono::milliseconds(gracePeriod);
+        while (waitpid(pid, &status, WNOHANG) == 0) {
+            if (std::chrono::steady_clock::now() >= killTime) {
+                kill(pid, SIGKILL);
+                waitpid(pid, &status, 0);
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        #else
+        (void)gracePeriod;
+        #endif
+    }
+}
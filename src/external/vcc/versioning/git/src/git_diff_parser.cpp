@@ -0,0 +1,249 @@
+#include "git_diff_parser.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "exception_macro.hpp"
+#include "git_service.hpp"
+#include "string_helper.hpp"
+
+namespace vcc
+{
+    namespace
+    {
+        const std::string diffGitPrefix = "diff --git ";
+        const std::string filePathOldPrefix = "--- ";
+        const std::string filePathNewPrefix = "+++ ";
+        const std::string renameFromPrefix = "rename from ";
+        const std::string renameToPrefix = "rename to ";
+        const std::string binaryFilesPrefix = "Binary files ";
+        const std::string hunkPrefix = "@@";
+        const std::string devNull = "/dev/null";
+
+        // "a/path", "/dev/null", path may end with tab if it has space
+        std::wstring getHeaderFilePath(const std::string &str, const std::string &prefix)
+        {
+            std::string path = str;
+            while (!path.empty() && (path.back() == '\t' || path.back() == '\r' || path.back() == ' '))
+                path.pop_back();
+            if (path == devNull)
+                return L"";
+            if (path.starts_with(prefix))
+                path = path.substr(prefix.length());
+            return str2wstr(path);
+        }
+
+        size_t parseHunkRange(const std::string &str, const char &sign, size_t &lineCount)
+        {
+            if (str.length() < 2 || str[0] != sign)
+                THROW_EXCEPTION_MSG(ExceptionType::ParserError, L"Unexpected hunk range: " + str2wstr(str));
+            size_t commaPos = str.find(',');
+            lineCount = commaPos != std::string::npos ? (size_t)std::stoull(str.substr(commaPos + 1)) : 0;
+            return (size_t)std::stoull(str.substr(1, commaPos != std::string::npos ? commaPos - 1 : std::string::npos));
+        }
+    }
+
+    void GitDiffParser::parseDiffGitLine(const std::string &line, std::shared_ptr<GitDiffFile> file)
+    {
+        TRY
+            // "diff --git a/path b/path", paths are the same unless renamed, then --- and +++ or rename lines give exact paths
+            std::string paths = line.substr(diffGitPrefix.length());
+            while (!paths.empty() && paths.back() == '\r')
+                paths.pop_back();
+            size_t separatorPos = std::string::npos;
+            if (paths.length() > 5 && (paths.length() - 5) % 2 == 0) {
+                size_t length = (paths.length() - 5) / 2;
+                if (paths.substr(2, length) == paths.substr(length + 5) && paths.substr(length + 2, 3) == " b/")
+                    separatorPos = length + 2;
+            }
+            if (separatorPos == std::string::npos)
+                separatorPos = paths.find(" b/");
+            if (separatorPos == std::string::npos)
+                return;
+            file->setFilePathOld(getHeaderFilePath(paths.substr(0, separatorPos), "a/"));
+            file->setFilePathNew(getHeaderFilePath(paths.substr(separatorPos + 1), "b/"));
+        CATCH
+    }
+
+    void GitDiffParser::parseHunkHeader(const std::string &line, std::shared_ptr<GitDiffHunk> hunk)
+    {
+        TRY
+            // sample new: @@ -1 +1,2 @@
+            // sample modify: @@ -116,10 +116,10 @@ xxxx
+            size_t endPos = line.find(hunkPrefix, hunkPrefix.length());
+            if (endPos == std::string::npos)
+                THROW_EXCEPTION_MSG(ExceptionType::ParserError, L"Unexpected pattern: " + str2wstr(line));
+            std::string ranges = line.substr(hunkPrefix.length(), endPos - hunkPrefix.length());
+            size_t start = ranges.find_first_not_of(' ');
+            size_t middle = start != std::string::npos ? ranges.find(' ', start) : std::string::npos;
+            if (middle == std::string::npos)
+                THROW_EXCEPTION_MSG(ExceptionType::ParserError, L"Unexpected pattern: " + str2wstr(line));
+            size_t end = ranges.find(' ', middle + 1);
+            size_t lineCount = 0;
+            hunk->setLineNumberOld(parseHunkRange(ranges.substr(start, middle - start), '-', lineCount));
+            hunk->setLineCountOld(lineCount);
+            hunk->setLineNumberNew(parseHunkRange(ranges.substr(middle + 1, end != std::string::npos ? end - middle - 1 : std::string::npos), '+', lineCount));
+            hunk->setLineCountNew(lineCount);
+        CATCH
+    }
+
+    void GitDiffParser::parseLine(const std::wstring &line)
+    {
+        TRY
+            size_t offset = _Buffer.length();
+            std::string str = wstr2str(line);
+            _Buffer += str;
+            _Buffer += "\n";
+            size_t end = _Buffer.length();
+
+            // content of hunk always starts with space, +, - or "\ No newline at end of file"
+            if (_CurrentHunk != nullptr) {
+                char prefix = str.empty() ? ' ' : str[0];
+                if (prefix == ' ' || prefix == '+' || prefix == '-' || prefix == '\\' || prefix == '\r') {
+                    if (prefix == '+')
+                        _CurrentHunk->setAddLineCount(_CurrentHunk->getAddLineCount() + 1);
+                    else if (prefix == '-')
+                        _CurrentHunk->setDeleteLineCount(_CurrentHunk->getDeleteLineCount() + 1);
+                    _CurrentHunk->setLength(end - _CurrentHunk->getOffset());
+                    _Files.back()->setLength(end - _Files.back()->getOffset());
+                    return;
+                }
+                _CurrentHunk = nullptr;
+            }
+
+            if (str.starts_with(diffGitPrefix)) {
+                auto file = std::make_shared<GitDiffFile>();
+                file->setOffset(offset);
+                file->setLength(end - offset);
+                parseDiffGitLine(str, file);
+                _Files.push_back(file);
+                _IsFileHeader = true;
+                return;
+            }
+            // text before first file, e.g. --stat
+            if (_Files.empty())
+                return;
+
+            auto file = _Files.back();
+            if (str.starts_with(hunkPrefix)) {
+                auto hunk = std::make_shared<GitDiffHunk>();
+                parseHunkHeader(str, hunk);
+                hunk->setOffset(end);
+                file->insertHunks(hunk);
+                _CurrentHunk = hunk;
+                _IsFileHeader = false;
+            } else if (_IsFileHeader) {
+                if (str.starts_with(filePathOldPrefix))
+                    file->setFilePathOld(getHeaderFilePath(str.substr(filePathOldPrefix.length()), "a/"));
+                else if (str.starts_with(filePathNewPrefix))
+                    file->setFilePathNew(getHeaderFilePath(str.substr(filePathNewPrefix.length()), "b/"));
+                else if (str.starts_with(renameFromPrefix))
+                    file->setFilePathOld(getHeaderFilePath(str.substr(renameFromPrefix.length()), ""));
+                else if (str.starts_with(renameToPrefix))
+                    file->setFilePathNew(getHeaderFilePath(str.substr(renameToPrefix.length()), ""));
+                else if (str.starts_with("new file mode"))
+                    file->setFilePathOld(L"");
+                else if (str.starts_with("deleted file mode"))
+                    file->setFilePathNew(L"");
+                else if (str.starts_with(binaryFilesPrefix))
+                    file->setIsBinary(true);
+                else
+                    return;
+            } else
+                return;
+            file->setLength(end - file->getOffset());
+        CATCH
+    }
+
+    void GitDiffParser::parse(const std::wstring &str)
+    {
+        TRY
+            size_t pos = 0;
+            while (pos < str.length()) {
+                size_t end = str.find(L'\n', pos);
+                if (end == std::wstring::npos) {
+                    parseLine(str.substr(pos));
+                    break;
+                }
+                parseLine(str.substr(pos, end - pos));
+                pos = end + 1;
+            }
+        CATCH
+    }
+
+    void GitDiffParser::clear()
+    {
+        _Buffer.clear();
+        _Buffer.shrink_to_fit();
+        _Files.clear();
+        _CurrentHunk = nullptr;
+        _IsFileHeader = false;
+    }
+
+    const std::vector<std::shared_ptr<GitDiffFile>> &GitDiffParser::getFiles() const
+    {
+        return _Files;
+    }
+
+    std::shared_ptr<GitDiffFile> GitDiffParser::getFile(const std::wstring &filePath) const
+    {
+        TRY
+            for (auto const &file : _Files) {
+                if (file->getFilePathNew() == filePath || (file->getFilePathNew().empty() && file->getFilePathOld() == filePath))
+                    return file;
+            }
+        CATCH
+        return nullptr;
+    }
+
+    size_t GitDiffParser::getBufferSize() const
+    {
+        return _Buffer.length();
+    }
+
+    std::wstring GitDiffParser::getText(const size_t &offset, const size_t &length) const
+    {
+        TRY
+            if (offset >= _Buffer.length())
+                return L"";
+            return str2wstr(_Buffer.substr(offset, length));
+        CATCH
+        return L"";
+    }
+
+    std::wstring GitDiffParser::getFileText(const GitDiffFile *file) const
+    {
+        TRY
+            return file != nullptr ? getText(file->getOffset(), file->getLength()) : L"";
+        CATCH
+        return L"";
+    }
+
+    std::wstring GitDiffParser::getHunkText(const GitDiffHunk *hunk) const
+    {
+        TRY
+            return hunk != nullptr ? getText(hunk->getOffset(), hunk->getLength()) : L"";
+        CATCH
+        return L"";
+    }
+
+    std::shared_ptr<GitDifference> GitDiffParser::getDifference(const GitDiffFile *file) const
+    {
+        auto difference = std::make_shared<GitDifference>();
+        TRY
+            if (file == nullptr)
+                return difference;
+            difference->setFilePathOld(file->getFilePathOld());
+            difference->setFilePathNew(file->getFilePathNew());
+            for (auto const &hunk : file->getHunks()) {
+                difference->insertLineNumberOld(hunk->getLineNumberOld());
+                difference->insertLineCountOld(hunk->getLineCountOld());
+                difference->insertLineNumberNew(hunk->getLineNumberNew());
+                difference->insertLineCountNew(hunk->getLineCountNew());
+                difference->insertChangedLines(getHunkText(hunk.get()));
+            }
+        CATCH
+        return difference;
+    }
+}
@@ -0,0 +1,113 @@
+#include "git_log_graph.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "exception_macro.hpp"
+#include "git_service.hpp"
+
+namespace vcc
+{
+    int64_t GitLogGraph::findLane(const std::wstring &hashID) const
+    {
+        for (size_t i = 0; i < _Lanes.size(); i++) {
+            if (_Lanes[i] == hashID)
+                return (int64_t)i;
+        }
+        return -1;
+    }
+
+    int64_t GitLogGraph::findFreeLane() const
+    {
+        for (size_t i = 0; i < _Lanes.size(); i++) {
+            if (_Lanes[i].empty())
+                return (int64_t)i;
+        }
+        return (int64_t)_Lanes.size();
+    }
+
+    int64_t GitLogGraph::layout(const std::wstring &hashID, const std::vector<std::wstring> &parentHashIDs, std::vector<int64_t> *incomingColumnIndexes, std::vector<int64_t> *outgoingColumnIndexes)
+    {
+        TRY
+            // commit without child lane is tip of branch, start at free lane
+            int64_t column = findLane(hashID);
+            if (column < 0)
+                column = findFreeLane();
+
+            // lanes expecting commit join the commit
+            if (incomingColumnIndexes != nullptr) {
+                incomingColumnIndexes->clear();
+                for (size_t i = 0; i < _Lanes.size(); i++)
+                    incomingColumnIndexes->push_back(_Lanes[i].empty() ? -1 : (_Lanes[i] == hashID ? column : (int64_t)i));
+            }
+            for (auto &lane : _Lanes) {
+                if (lane == hashID)
+                    lane.clear();
+            }
+
+            // first parent continues lane of commit, other parents start from free lanes
+            std::vector<bool> isFromCommit;
+            for (size_t i = 0; i < parentHashIDs.size(); i++) {
+                int64_t lane = i == 0 ? column : findFreeLane();
+                if (lane >= (int64_t)_Lanes.size())
+                    _Lanes.resize(lane + 1);
+                if (lane >= (int64_t)isFromCommit.size())
+                    isFromCommit.resize(lane + 1, false);
+                _Lanes[lane] = parentHashIDs[i];
+                isFromCommit[lane] = true;
+            }
+            while (!_Lanes.empty() && _Lanes.back().empty())
+                _Lanes.pop_back();
+
+            if (outgoingColumnIndexes != nullptr) {
+                outgoingColumnIndexes->clear();
+                for (size_t i = 0; i < _Lanes.size(); i++) {
+                    if (_Lanes[i].empty())
+                        outgoingColumnIndexes->push_back(-1);
+                    else
+                        outgoingColumnIndexes->push_back(i < isFromCommit.size() && isFromCommit[i] ? column : (int64_t)i);
+                }
+            }
+            return column;
+        CATCH
+        return -1;
+    }
+
+    const std::vector<std::wstring> &GitLogGraph::getLanes() const
+    {
+        return _Lanes;
+    }
+
+    void GitLogGraph::setLanes(const std::vector<std::wstring> &lanes)
+    {
+        _Lanes = lanes;
+    }
+
+    void GitLogGraph::clear()
+    {
+        _Lanes.clear();
+    }
+
+    void GitLogGraph::addLog(std::shared_ptr<GitLog> log)
+    {
+        TRY
+            log->setColumnIndex(layout(log->getHashID(), log->getParentHashIDs(), &log->getGraphIncomingColumnIndexes(), &log->getGraphOutgoingColumnIndexes()));
+        CATCH
+    }
+
+    void GitLogGraph::addLogs(const std::vector<std::shared_ptr<GitLog>> &logs)
+    {
+        TRY
+            for (auto const &log : logs)
+                addLog(log);
+        CATCH
+    }
+
+    void GitLogGraph::addCommit(const std::wstring &hashID, const std::vector<std::wstring> &parentHashIDs)
+    {
+        TRY
+            layout(hashID, parentHashIDs, nullptr, nullptr);
+        CATCH
+    }
+}
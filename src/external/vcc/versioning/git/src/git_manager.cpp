@@ -1,17 +1,85 @@
 #include "git_manager.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "exception_macro.hpp"
+#include "git_log_graph.hpp"
+#include "git_object_session.hpp"
 #include "git_service.hpp"
+#include "string_helper.hpp"
 
 namespace vcc
 {
+    namespace
+    {
+        void appendFileStamp(std::wstring &stamp, const std::filesystem::path &path)
+        {
+            std::error_code errorCode;
+            auto fileStatus = std::filesystem::status(path, errorCode);
+            stamp += path.wstring() + L"|";
+            if (errorCode || !std::filesystem::exists(fileStatus)) {
+                stamp += L"-\n";
+                return;
+            }
+            stamp += std::to_wstring(std::filesystem::last_write_time(path, errorCode).time_since_epoch().count());
+            if (std::filesystem::is_regular_file(fileStatus))
+                stamp += L"|" + std::to_wstring(std::filesystem::file_size(path, errorCode));
+            stamp += L"\n";
+        }
+
+        void appendEnvironmentFileStamp(std::wstring &stamp, const char *name, const std::wstring &subPath)
+        {
+            const char *value = std::getenv(name);
+            if (value != nullptr && *value != '\0')
+                appendFileStamp(stamp, std::filesystem::path(str2wstr(value)) / subPath);
+        }
+
+        template <typename T>
+        std::vector<std::shared_ptr<T>> cloneObjects(const std::vector<std::shared_ptr<T>> &objects)
+        {
+            std::vector<std::shared_ptr<T>> result;
+            for (auto const &object : objects)
+                result.push_back(std::dynamic_pointer_cast<T>(object->clone()));
+            return result;
+        }
+
+        std::wstring getTagSearchCriteriaKey(const GitTagSearchCriteria *searchCriteria)
+        {
+            if (searchCriteria == nullptr)
+                return L"";
+            return searchCriteria->getContains() + L"\n" + searchCriteria->getNoContains() + L"\n" + searchCriteria->getOrderBy();
+        }
+    }
+
     GitManager::GitManager(std::shared_ptr<LogConfig> logConfig, const std::wstring &workspace) : BaseManager(logConfig)
     {
         _Workspace = workspace;
     }
 
+    GitManager::~GitManager()
+    {
+        // cancel and wait for pending prefetch here, members it uses are destroyed before _LogPages
+        try {
+            clearLogPageCache();
+            std::lock_guard<std::mutex> lock(_ObjectSessionMutex);
+            if (_ObjectSession != nullptr)
+                _ObjectSession->close();
+        } catch (...) {
+        }
+    }
+
     void GitManager::validate() const
     {
         TRY
@@ -19,6 +87,87 @@ namespace vcc
         CATCH
     }
 
+    std::wstring GitManager::getResultCacheStamp()
+    {
+        std::wstring stamp = L"";
+        TRY
+            // .git as file (worktree, submodule) is not supported, no cache
+            std::filesystem::path gitDirectory = std::filesystem::path(_Workspace) / L".git";
+            std::error_code errorCode;
+            if (!std::filesystem::is_directory(gitDirectory, errorCode))
+                return L"";
+            appendFileStamp(stamp, gitDirectory / L"HEAD");
+            appendFileStamp(stamp, gitDirectory / L"packed-refs");
+            appendFileStamp(stamp, gitDirectory / L"config");
+            // loose ref is created, updated and deleted by rename of lock file in its directory, so modified time of directories covers loose refs
+            // directories are listed again only if one of them is changed, cache hit does not read entries of refs with many tags or remote refs
+            std::wstring refDirectoryStamp = L"";
+            for (auto const &directory : _ResultCacheRefDirectories)
+                appendFileStamp(refDirectoryStamp, directory);
+            if (_ResultCacheRefDirectories.empty() || refDirectoryStamp != _ResultCacheRefDirectoryStamp) {
+                // directory is stamped before its entries are read, directory created afterward changes stamp of parent
+                _ResultCacheRefDirectories.clear();
+                refDirectoryStamp.clear();
+                std::filesystem::path refsDirectory = gitDirectory / L"refs";
+                _ResultCacheRefDirectories.push_back(refsDirectory.wstring());
+                appendFileStamp(refDirectoryStamp, refsDirectory);
+                std::filesystem::recursive_directory_iterator it(refsDirectory, errorCode);
+                for (; !errorCode && it != std::filesystem::recursive_directory_iterator(); it.increment(errorCode)) {
+                    if (!it->is_directory(errorCode) || it->is_symlink(errorCode))
+                        continue;
+                    _ResultCacheRefDirectories.push_back(it->path().wstring());
+                    appendFileStamp(refDirectoryStamp, it->path());
+                }
+                _ResultCacheRefDirectoryStamp = refDirectoryStamp;
+            }
+            stamp += refDirectoryStamp;
+
+            // global and system config
+            appendEnvironmentFileStamp(stamp, "GIT_CONFIG_GLOBAL", L"");
+            #ifdef _WIN32
+            appendEnvironmentFileStamp(stamp, "USERPROFILE", L".gitconfig");
+            #else
+            appendEnvironmentFileStamp(stamp, "HOME", L".gitconfig");
+            appendEnvironmentFileStamp(stamp, "HOME", L".config/git/config");
+            appendEnvironmentFileStamp(stamp, "XDG_CONFIG_HOME", L"git/config");
+            appendFileStamp(stamp, L"/etc/gitconfig");
+            #endif
+        CATCH
+        return stamp;
+    }
+
+    bool GitManager::checkResultCache()
+    {
+        TRY
+            if (!_IsResultCache)
+                return false;
+            std::wstring stamp = getResultCacheStamp();
+            if (stamp != _ResultCacheStamp) {
+                _CachedTags.clear();
+                _CachedCurrentTag = nullptr;
+                _CachedCurrentBranchName.reset();
+                _CachedBranches.reset();
+                _CachedRemotes.reset();
+                _CachedConfig = nullptr;
+                _CachedConfigValues.clear();
+                _CachedGlobalConfig = nullptr;
+                _CachedGlobalConfigValues.clear();
+                _ResultCacheStamp = stamp;
+            }
+            return !stamp.empty();
+        CATCH
+        return false;
+    }
+
+    void GitManager::clearResultCache()
+    {
+        TRY
+            std::lock_guard<std::mutex> lock(_ResultCacheMutex);
+            // next check sees different stamp
+            _ResultCacheStamp = L"";
+        CATCH
+    }
+
     std::wstring GitManager::getVersion() const
     {
         TRY
@@ -50,22 +199,44 @@ namespace vcc
         TRY
             validate();
             GitService::initializeGitResponse(_LogConfig.get(), _Workspace);
+            clearResultCache();
+        CATCH
+    }
+
+    void GitManager::cloneGitResponse(const std::wstring &url, const GitCloneOption *option, const CancellationToken *cancellationToken, const std::function<void(const GitProgress *)> &onProgress)
+    {
+        TRY
+            validate();
+            GitService::cloneGitResponse(_LogConfig.get(), _Workspace, url, option, cancellationToken, onProgress);
+            clearResultCache();
         CATCH
     }
 
-    void GitManager::cloneGitResponse(const std::wstring &url, const GitCloneOption *option)
+    std::shared_ptr<GitObjectSession> GitManager::getObjectSession() const
     {
         TRY
             validate();
-            GitService::cloneGitResponse(_LogConfig.get(), _Workspace, url, option);
+            std::lock_guard<std::mutex> lock(_ObjectSessionMutex);
+            // session of previous workspace is closed when last user releases it
+            if (_ObjectSession == nullptr || _ObjectSessionWorkspace != _Workspace) {
+                _ObjectSession = std::make_shared<GitObjectSession>(_LogConfig, _Workspace);
+                _ObjectSessionWorkspace = _Workspace;
+            }
+            return _ObjectSession;
         CATCH
+        return nullptr;
     }
 
     std::vector<std::shared_ptr<GitRemote>> GitManager::getRemote()
     {
         TRY
             validate();
-            return GitService::getRemote(_LogConfig.get(), _Workspace);
+            std::lock_guard<std::mutex> lock(_ResultCacheMutex);
+            if (!checkResultCache())
+                return GitService::getRemote(_LogConfig.get(), _Workspace);
+            if (!_CachedRemotes.has_value())
+                _CachedRemotes = GitService::getRemote(_LogConfig.get(), _Workspace);
+            return cloneObjects(_CachedRemotes.value());
         CATCH
         return {};
     }
@@ -75,6 +246,7 @@ namespace vcc
         TRY
             validate();
             GitService::AddRemote(_LogConfig.get(), _Workspace, name, url, mirror);
+            clearResultCache();
         CATCH
     }
     
@@ -83,6 +255,7 @@ namespace vcc
         TRY
             validate();
             GitService::RenameRemote(_LogConfig.get(), _Workspace, oldName, newName);
+            clearResultCache();
         CATCH
     }
     
@@ -91,47 +264,251 @@ namespace vcc
         TRY
             validate();
             GitService::RemoveRemote(_LogConfig.get(), _Workspace, name);
+            clearResultCache();
         CATCH
     }
     
-    void GitManager::FetchAll()
+    void GitManager::FetchAll(const CancellationToken *cancellationToken, const std::function<void(const GitProgress *)> &onProgress)
     {
         TRY
             validate();
-            GitService::FetchAll(_LogConfig.get(), _Workspace);
+            GitService::FetchAll(_LogConfig.get(), _Workspace, cancellationToken, onProgress);
+            clearResultCache();
         CATCH
     }
     
-    void GitManager::Pull(const GitPullOption *option)
+    void GitManager::Pull(const GitPullOption *option, const CancellationToken *cancellationToken, const std::function<void(const GitProgress *)> &onProgress)
     {
         TRY
             validate();
-            GitService::Pull(_LogConfig.get(), _Workspace, option);
+            GitService::Pull(_LogConfig.get(), _Workspace, option, cancellationToken, onProgress);
+            clearResultCache();
         CATCH
     }
     
-    void GitManager::Push(const GitPushOption *option)
+    void GitManager::Push(const GitPushOption *option, const CancellationToken *cancellationToken, const std::function<void(const GitProgress *)> &onProgress)
     {
         TRY
             validate();
-            GitService::Push(_LogConfig.get(), _Workspace, option);
+            GitService::Push(_LogConfig.get(), _Workspace, option, cancellationToken, onProgress);
+            clearResultCache();
         CATCH
     }
     
-    std::vector<std::shared_ptr<GitLog>> GitManager::getLogs(const GitLogSearchCriteria *searchCriteria)
+    std::vector<std::shared_ptr<GitLog>> GitManager::getLogs(const GitLogSearchCriteria *searchCriteria, const CancellationToken *cancellationToken)
     {
         TRY
             validate();
-            return GitService::getLogs(_LogConfig.get(), _Workspace, searchCriteria);
+            return GitService::getLogs(_LogConfig.get(), _Workspace, searchCriteria, cancellationToken);
         CATCH
         return {};
     }
     
+    std::vector<std::shared_ptr<GitLog>> GitManager::loadLogPage(const int64_t &offset, const int64_t &count, std::shared_ptr<GitLogSearchCriteria> searchCriteria, std::shared_ptr<CancellationToken> cancellationToken)
+    {
+        TRY
+            auto pageSearchCriteria = searchCriteria != nullptr ? std::dynamic_pointer_cast<GitLogSearchCriteria>(searchCriteria->clone()) : std::make_shared<GitLogSearchCriteria>();
+            int64_t pageCount = count;
+            if (pageSearchCriteria->getLogCount() > 0)
+                pageCount = std::min(pageCount, pageSearchCriteria->getLogCount() - offset);
+            if (pageCount <= 0)
+                return {};
+            pageSearchCriteria->setSkip(std::max((int64_t)0, pageSearchCriteria->getSkip()) + offset);
+            pageSearchCriteria->setLogCount(pageCount);
+            // laid out by lanes of GitManager instead of GitService::getLogs
+            auto logs = GitService::getLogRecords(_LogConfig.get(), _Workspace, pageSearchCriteria.get(), cancellationToken.get());
+            if (pageSearchCriteria->getOrderBy() != GitLogOrderBy::Reverse)
+                layoutLogPage(offset, count, logs, searchCriteria, cancellationToken);
+            return logs;
+        CATCH
+        return {};
+    }
+
+    void GitManager::layoutLogPage(const int64_t &offset, const int64_t &count, const std::vector<std::shared_ptr<GitLog>> &logs, std::shared_ptr<GitLogSearchCriteria> searchCriteria, std::shared_ptr<CancellationToken> cancellationToken)
+    {
+        TRY
+            GitLogGraph graph;
+            int64_t laneOffset = 0;
+            int64_t generation = 0;
+            {
+                std::lock_guard<std::mutex> lock(_LogGraphMutex);
+                generation = _LogGraphGeneration;
+                // nearest saved lanes before page, history starts with no lane
+                auto it = _LogGraphLanes.upper_bound(offset);
+                if (it != _LogGraphLanes.begin()) {
+                    it--;
+                    laneOffset = it->first;
+                    graph.setLanes(it->second);
+                }
+            }
+
+            // walk gap without lock, save lanes at every page boundary so that later jump into gap starts nearby
+            std::map<int64_t, std::vector<std::wstring>> lanes;
+            if (laneOffset < offset) {
+                auto gapSearchCriteria = searchCriteria != nullptr ? std::dynamic_pointer_cast<GitLogSearchCriteria>(searchCriteria->clone()) : std::make_shared<GitLogSearchCriteria>();
+                gapSearchCriteria->setSkip(std::max((int64_t)0, gapSearchCriteria->getSkip()) + laneOffset);
+                gapSearchCriteria->setLogCount(offset - laneOffset);
+                int64_t row = laneOffset;
+                GitService::getLogParents(_LogConfig.get(), _Workspace, gapSearchCriteria.get(), [&graph, &lanes, &row, count](const std::wstring &hashID, const std::vector<std::wstring> &parentHashIDs) {
+                    graph.addCommit(hashID, parentHashIDs);
+                    row++;
+                    if (row % count == 0)
+                        lanes[row] = graph.getLanes();
+                }, cancellationToken.get());
+                lanes[offset] = graph.getLanes();
+            }
+            graph.addLogs(logs);
+            lanes[offset + (int64_t)logs.size()] = graph.getLanes();
+
+            std::lock_guard<std::mutex> lock(_LogGraphMutex);
+            if (generation != _LogGraphGeneration)
+                return;
+            for (auto &lane : lanes)
+                _LogGraphLanes[lane.first] = std::move(lane.second);
+        CATCH
+    }
+
+    void GitManager::touchLogPage(const int64_t &offset)
+    {
+        _LogPageOrder.remove(offset);
+        _LogPageOrder.push_back(offset);
+    }
+
+    void GitManager::evictLogPages(const int64_t &requestedOffset, const int64_t &prefetchOffset, std::vector<std::shared_future<std::vector<std::shared_ptr<GitLog>>>> &discardedPages)
+    {
+        auto it = _LogPageOrder.begin();
+        while ((int64_t)_LogPages.size() > std::max(_LogPageCacheSize, (int64_t)1) && it != _LogPageOrder.end()) {
+            auto page = _LogPages.find(*it);
+            // loading page cannot be dropped without waiting
+            if (*it == requestedOffset || *it == prefetchOffset || page == _LogPages.end()
+                || page->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                it++;
+                continue;
+            }
+            discardedPages.push_back(page->second);
+            _LogPages.erase(page);
+            it = _LogPageOrder.erase(it);
+        }
+    }
+
+    void GitManager::setLogPageSearchCriteria(const GitLogSearchCriteria *searchCriteria)
+    {
+        TRY
+            clearLogPageCache();
+            std::lock_guard<std::mutex> lock(_LogPageMutex);
+            _LogPageSearchCriteria = searchCriteria != nullptr ? std::dynamic_pointer_cast<GitLogSearchCriteria>(searchCriteria->clone()) : nullptr;
+        CATCH
+    }
+
+    std::vector<std::shared_ptr<GitLog>> GitManager::getLogPage(const int64_t &offset, const int64_t &count)
+    {
+        TRY
+            validate();
+            VALIDATE(L"Offset is negative", offset >= 0)
+            VALIDATE(L"Count is not positive", count > 0)
+            std::shared_future<std::vector<std::shared_ptr<GitLog>>> page;
+            std::unique_ptr<std::promise<std::vector<std::shared_ptr<GitLog>>>> promise = nullptr;
+            std::shared_ptr<GitLogSearchCriteria> searchCriteria = nullptr;
+            std::shared_ptr<CancellationToken> cancellationToken = nullptr;
+            // destroyed after lock is released, see evictLogPages
+            std::vector<std::shared_future<std::vector<std::shared_ptr<GitLog>>>> discardedPages;
+            {
+                std::lock_guard<std::mutex> lock(_LogPageMutex);
+                if (count != _LogPageSize) {
+                    // pages of different size cannot be reused
+                    _LogPageCancellationToken->cancel();
+                    _LogPageCancellationToken = std::make_shared<CancellationToken>();
+                    for (auto &loadingPage : _LogPages)
+                        discardedPages.push_back(loadingPage.second);
+                    _LogPages.clear();
+                    _LogPageOrder.clear();
+                    _LogPageSize = count;
+                }
+                auto it = _LogPages.find(offset);
+                // failed or cancelled prefetch is loaded again
+                if (it != _LogPages.end() && it->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+                    try {
+                        it->second.get();
+                    } catch (...) {
+                        discardedPages.push_back(it->second);
+                        _LogPages.erase(it);
+                        it = _LogPages.end();
+                    }
+                }
+                if (it == _LogPages.end()) {
+                    // load outside lock, other callers of same page wait for the future
+                    promise = std::make_unique<std::promise<std::vector<std::shared_ptr<GitLog>>>>();
+                    it = _LogPages.insert(std::make_pair(offset, promise->get_future().share())).first;
+                }
+                page = it->second;
+                searchCriteria = _LogPageSearchCriteria;
+                cancellationToken = _LogPageCancellationToken;
+                touchLogPage(offset);
+            }
+            if (promise != nullptr) {
+                try {
+                    promise->set_value(loadLogPage(offset, count, searchCriteria, cancellationToken));
+                } catch (...) {
+                    promise->set_exception(std::current_exception());
+                }
+            }
+            std::vector<std::shared_ptr<GitLog>> logs = page.get();
+
+            std::lock_guard<std::mutex> lock(_LogPageMutex);
+            int64_t prefetchOffset = -1;
+            // next page exists only if this page is full
+            if (_IsLogPagePrefetch && (int64_t)logs.size() == count && count == _LogPageSize && cancellationToken == _LogPageCancellationToken
+                && _LogPages.find(offset + count) == _LogPages.end()) {
+                prefetchOffset = offset + count;
+                _LogPages.insert(std::make_pair(prefetchOffset, std::async(std::launch::async, &GitManager::loadLogPage, this,
+                    prefetchOffset, count, _LogPageSearchCriteria, _LogPageCancellationToken).share()));
+                touchLogPage(prefetchOffset);
+            }
+            evictLogPages(offset, prefetchOffset, discardedPages);
+            return logs;
+        CATCH
+        return {};
+    }
+
+    size_t GitManager::getCachedLogPageCount() const
+    {
+        std::lock_guard<std::mutex> lock(_LogPageMutex);
+        return _LogPages.size();
+    }
+
+    void GitManager::clearLogPageCache()
+    {
+        TRY
+            std::map<int64_t, std::shared_future<std::vector<std::shared_ptr<GitLog>>>> pages;
+            {
+                std::lock_guard<std::mutex> lock(_LogPageMutex);
+                // cancel pending prefetch, new token for later pages
+                _LogPageCancellationToken->cancel();
+                _LogPageCancellationToken = std::make_shared<CancellationToken>();
+                pages.swap(_LogPages);
+                _LogPageOrder.clear();
+            }
+            // wait for cancelled prefetch outside lock
+            pages.clear();
+            // history may be changed
+            std::lock_guard<std::mutex> lock(_LogGraphMutex);
+            _LogGraphLanes.clear();
+            _LogGraphGeneration++;
+        CATCH
+    }
+
     std::vector<std::wstring> GitManager::getTags(const GitTagSearchCriteria *searchCriteria)
     {
         TRY
             validate();
-            return GitService::getTags(_LogConfig.get(), _Workspace, searchCriteria);
+            std::lock_guard<std::mutex> lock(_ResultCacheMutex);
+            if (!checkResultCache())
+                return GitService::getTags(_LogConfig.get(), _Workspace, searchCriteria);
+            std::wstring key = getTagSearchCriteriaKey(searchCriteria);
+            auto it = _CachedTags.find(key);
+            if (it == _CachedTags.end())
+                it = _CachedTags.insert(std::make_pair(key, GitService::getTags(_LogConfig.get(), _Workspace, searchCriteria))).first;
+            return it->second;
         CATCH
         return {};
     }
@@ -140,7 +517,12 @@ namespace vcc
     {
         TRY
             validate();
-            return GitService::getCurrentTag(_LogConfig.get(), _Workspace);
+            std::lock_guard<std::mutex> lock(_ResultCacheMutex);
+            if (!checkResultCache())
+                return GitService::getCurrentTag(_LogConfig.get(), _Workspace);
+            if (_CachedCurrentTag == nullptr)
+                _CachedCurrentTag = GitService::getCurrentTag(_LogConfig.get(), _Workspace);
+            return _CachedCurrentTag != nullptr ? std::dynamic_pointer_cast<GitTagCurrentTag>(_CachedCurrentTag->clone()) : nullptr;
         CATCH
         return nullptr;
     }
@@ -150,6 +532,7 @@ namespace vcc
         TRY
             validate();
             GitService::CreateTag(_LogConfig.get(), _Workspace, tagName, option);
+            clearResultCache();
         CATCH
     }
     
@@ -158,6 +541,7 @@ namespace vcc
         TRY
             validate();
             GitService::Switch(_LogConfig.get(), _Workspace, tagName, isForce);
+            clearResultCache();
         CATCH
     }
     
@@ -166,6 +550,7 @@ namespace vcc
         TRY
             validate();
             GitService::DeleteTag(_LogConfig.get(), _Workspace, tagName);
+            clearResultCache();
         CATCH
     }
     
@@ -173,7 +558,12 @@ namespace vcc
     {
         TRY
             validate();
-            return GitService::getCurrentBranchName(_LogConfig.get(), _Workspace);
+            std::lock_guard<std::mutex> lock(_ResultCacheMutex);
+            if (!checkResultCache())
+                return GitService::getCurrentBranchName(_LogConfig.get(), _Workspace);
+            if (!_CachedCurrentBranchName.has_value())
+                _CachedCurrentBranchName = GitService::getCurrentBranchName(_LogConfig.get(), _Workspace);
+            return _CachedCurrentBranchName.value();
         CATCH
         return L"";
     }
@@ -182,7 +572,12 @@ namespace vcc
     {
         TRY
             validate();
-            return GitService::getBranches(_LogConfig.get(), _Workspace);
+            std::lock_guard<std::mutex> lock(_ResultCacheMutex);
+            if (!checkResultCache())
+                return GitService::getBranches(_LogConfig.get(), _Workspace, getObjectSession().get());
+            if (!_CachedBranches.has_value())
+                _CachedBranches = GitService::getBranches(_LogConfig.get(), _Workspace, getObjectSession().get());
+            return cloneObjects(_CachedBranches.value());
         CATCH
         return {};
     }
@@ -192,6 +587,7 @@ namespace vcc
         TRY
             validate();
             GitService::CreateBranch(_LogConfig.get(), _Workspace, branchName, option);
+            clearResultCache();
         CATCH
     }
     
@@ -200,6 +596,7 @@ namespace vcc
         TRY
             validate();
             GitService::SwitchBranch(_LogConfig.get(), _Workspace, branchName, option);
+            clearResultCache();
         CATCH
     }
     
@@ -208,6 +605,7 @@ namespace vcc
         TRY
             validate();
             GitService::RenameBranch(_LogConfig.get(), _Workspace, oldBranchName, newBranchName, isForce);
+            clearResultCache();
         CATCH
     }
     
@@ -216,6 +614,7 @@ namespace vcc
         TRY
             validate();
             GitService::CopyBranch(_LogConfig.get(), _Workspace, oldBranchName, newBranchName, isForce);
+            clearResultCache();
         CATCH
     }
     
@@ -224,6 +623,7 @@ namespace vcc
         TRY
             validate();
             GitService::DeleteBranch(_LogConfig.get(), _Workspace, branchName, isForce);
+            clearResultCache();
         CATCH
     }
     
@@ -271,6 +671,15 @@ namespace vcc
         CATCH
         return nullptr;
     }
+
+    std::vector<std::shared_ptr<GitDifference>> GitManager::getDifferences(const std::vector<std::wstring> &filePaths, const GitDifferentSearchCriteria *searchCriteria, const CancellationToken *cancellationToken)
+    {
+        TRY
+            validate();
+            return GitService::getDifferences(_LogConfig.get(), _Workspace, filePaths, searchCriteria, cancellationToken);
+        CATCH
+        return {};
+    }
     
     void GitManager::stage(const std::wstring &filePath)
     {
@@ -309,6 +718,7 @@ namespace vcc
         TRY
             validate();
             GitService::Commit(_LogConfig.get(), _Workspace, command);
+            clearResultCache();
         CATCH
     }
     
@@ -317,7 +727,77 @@ namespace vcc
         TRY
             validate();
             GitService::Amend(_LogConfig.get(), _Workspace);
+            clearResultCache();
         CATCH
     }
-    
+
+    void GitManager::getConfig(std::shared_ptr<GitConfig> config)
+    {
+        TRY
+            validate();
+            std::lock_guard<std::mutex> lock(_ResultCacheMutex);
+            if (!checkResultCache()) {
+                GitService::getConfig(_LogConfig.get(), _Workspace, config);
+                return;
+            }
+            if (_CachedConfig == nullptr) {
+                auto result = std::make_shared<GitConfig>();
+                GitService::getConfig(_LogConfig.get(), _Workspace, result);
+                _CachedConfig = result;
+            }
+            config->setUserName(_CachedConfig->getUserName());
+            config->setUserEmail(_CachedConfig->getUserEmail());
+            config->cloneConfigs(_CachedConfig->getConfigs());
+        CATCH
+    }
+
+    std::wstring GitManager::getConfig(const std::wstring &key)
+    {
+        TRY
+            validate();
+            std::lock_guard<std::mutex> lock(_ResultCacheMutex);
+            if (!checkResultCache())
+                return GitService::getConfig(_LogConfig.get(), _Workspace, key);
+            auto it = _CachedConfigValues.find(key);
+            if (it == _CachedConfigValues.end())
+                it = _CachedConfigValues.insert(std::make_pair(key, GitService::getConfig(_LogConfig.get(), _Workspace, key))).first;
+            return it->second;
+        CATCH
+        return L"";
+    }
+
+    void GitManager::getGlobalConfig(std::shared_ptr<GitConfig> config)
+    {
+        TRY
+            validate();
+            std::lock_guard<std::mutex> lock(_ResultCacheMutex);
+            if (!checkResultCache()) {
+                GitService::getGlobalConfig(_LogConfig.get(), config);
+                return;
+            }
+            if (_CachedGlobalConfig == nullptr) {
+                auto result = std::make_shared<GitConfig>();
+                GitService::getGlobalConfig(_LogConfig.get(), result);
+                _CachedGlobalConfig = result;
+            }
+            config->setUserName(_CachedGlobalConfig->getUserName());
+            config->setUserEmail(_CachedGlobalConfig->getUserEmail());
+            config->cloneConfigs(_CachedGlobalConfig->getConfigs());
+        CATCH
+    }
+
+    std::wstring GitManager::getGlobalConfig(const std::wstring &key)
+    {
+        TRY
+            validate();
+            std::lock_guard<std::mutex> lock(_ResultCacheMutex);
+            if (!checkResultCache())
+                return GitService::getGlobalConfig(_LogConfig.get(), key);
+            auto it = _CachedGlobalConfigValues.find(key);
+            if (it == _CachedGlobalConfigValues.end())
+                it = _CachedGlobalConfigValues.insert(std::make_pair(key, GitService::getGlobalConfig(_LogConfig.get(), key))).first;
+            return it->second;
+        CATCH
+        return L"";
+    }
 }
@@ -0,0 +1,220 @@
+#include "git_multi_repository_manager.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "exception_macro.hpp"
+#include "git_manager.hpp"
+#include "git_service.hpp"
+#include "i_exception.hpp"
+#include "log_service.hpp"
+#include "string_helper.hpp"
+#include "thread_helper.hpp"
+
+namespace vcc
+{
+    bool GitMultiRepositoryManager::isRepositoryRoot(const std::wstring &workspace)
+    {
+        TRY
+            if (isBlank(workspace))
+                return false;
+            // .git is directory for repository and file for submodule or linked worktree
+            std::error_code errorCode;
+            return std::filesystem::exists(std::filesystem::path(workspace) / L".git", errorCode);
+        CATCH
+        return false;
+    }
+
+    std::vector<std::wstring> GitMultiRepositoryManager::findRepositories(const std::wstring &directory)
+    {
+        std::vector<std::wstring> result;
+        TRY
+            std::error_code errorCode;
+            if (!std::filesystem::is_directory(directory, errorCode))
+                return result;
+            std::filesystem::directory_iterator it(directory, errorCode);
+            for (; !errorCode && it != std::filesystem::directory_iterator(); it.increment(errorCode)) {
+                if (it->is_directory(errorCode) && isRepositoryRoot(it->path().wstring()))
+                    result.push_back(it->path().wstring());
+            }
+            std::sort(result.begin(), result.end());
+        CATCH
+        return result;
+    }
+
+    std::wstring GitMultiRepositoryManager::getErrorMessage(const std::vector<std::shared_ptr<GitRepositoryResult>> &results)
+    {
+        std::wstring result = L"";
+        TRY
+            for (auto const &repositoryResult : results) {
+                if (repositoryResult == nullptr || repositoryResult->getIsSuccess())
+                    continue;
+                if (!result.empty())
+                    result += L"\n";
+                result += repositoryResult->getWorkspace() + L": " + repositoryResult->getError();
+            }
+        CATCH
+        return result;
+    }
+
+    void GitMultiRepositoryManager::addWorkspace(const std::wstring &workspace)
+    {
+        TRY
+            // otherwise git walks up and runs on repository containing workspace
+            VALIDATE(L"Workspace is not top level of git repository: " + workspace, isRepositoryRoot(workspace))
+            std::lock_guard<std::mutex> lock(_Mutex);
+            for (auto const &gitManager : _GitManagers) {
+                if (gitManager->getWorkspace() == workspace)
+                    return;
+            }
+            _GitManagers.push_back(std::make_shared<GitManager>(_LogConfig, workspace));
+        CATCH
+    }
+
+    void GitMultiRepositoryManager::addGitManager(std::shared_ptr<GitManager> gitManager)
+    {
+        TRY
+            VALIDATE(L"GitManager is null", gitManager != nullptr)
+            VALIDATE(L"Workspace is not top level of git repository: " + gitManager->getWorkspace(), isRepositoryRoot(gitManager->getWorkspace()))
+            std::lock_guard<std::mutex> lock(_Mutex);
+            for (auto const &existingGitManager : _GitManagers) {
+                if (existingGitManager->getWorkspace() == gitManager->getWorkspace())
+                    return;
+            }
+            _GitManagers.push_back(gitManager);
+        CATCH
+    }
+
+    void GitMultiRepositoryManager::addWorkspaces(const std::wstring &directory)
+    {
+        TRY
+            for (auto const &workspace : findRepositories(directory))
+                addWorkspace(workspace);
+        CATCH
+    }
+
+    void GitMultiRepositoryManager::clearWorkspaces()
+    {
+        TRY
+            std::lock_guard<std::mutex> lock(_Mutex);
+            _GitManagers.clear();
+        CATCH
+    }
+
+    std::vector<std::wstring> GitMultiRepositoryManager::getWorkspaces() const
+    {
+        std::vector<std::wstring> result;
+        TRY
+            std::lock_guard<std::mutex> lock(_Mutex);
+            for (auto const &gitManager : _GitManagers)
+                result.push_back(gitManager->getWorkspace());
+        CATCH
+        return result;
+    }
+
+    std::shared_ptr<GitManager> GitMultiRepositoryManager::getGitManager(const std::wstring &workspace) const
+    {
+        TRY
+            std::lock_guard<std::mutex> lock(_Mutex);
+            for (auto const &gitManager : _GitManagers) {
+                if (gitManager->getWorkspace() == workspace)
+                    return gitManager;
+            }
+        CATCH
+        return nullptr;
+    }
+
+    std::vector<std::shared_ptr<GitRepositoryResult>> GitMultiRepositoryManager::execute(const GitRepositoryOperation &operation, const std::function<void(GitManager *, GitRepositoryResult *)> &action,
+        const std::function<void(const GitRepositoryProgress *)> &onProgress, const CancellationToken *cancellationToken)
+    {
+        std::vector<std::shared_ptr<GitManager>> gitManagers;
+        {
+            std::lock_guard<std::mutex> lock(_Mutex);
+            gitManagers = _GitManagers;
+        }
+        std::vector<std::shared_ptr<GitRepositoryResult>> results;
+        TRY
+            for (auto const &gitManager : gitManagers) {
+                auto result = std::make_shared<GitRepositoryResult>();
+                result->setWorkspace(gitManager->getWorkspace());
+                result->setOperation(operation);
+                results.push_back(result);
+            }
+
+            std::mutex progressMutex;
+            auto progress = std::make_shared<GitRepositoryProgress>();
+            progress->setTotalCount(static_cast<int64_t>(gitManagers.size()));
+
+            executeParallel(gitManagers.size(), _Parallelism, [&](const size_t &index) {
+                auto result = results[index];
+                if (cancellationToken != nullptr && cancellationToken->isCancelled()) {
+                    result->setIsCancelled(true);
+                    result->setError(L"Operation cancelled.");
+                } else {
+                    try {
+                        action(gitManagers[index].get(), result.get());
+                        result->setIsSuccess(true);
+                    } catch (std::exception &e) {
+                        const IException *ie = dynamic_cast<const IException *>(&e);
+                        result->setError(ie != nullptr ? ie->getErrorMessage() : str2wstr(e.what()));
+                        result->setIsCancelled(cancellationToken != nullptr && cancellationToken->isCancelled());
+                    } catch (...) {
+                        result->setError(L"Unknown exception.");
+                        result->setIsCancelled(cancellationToken != nullptr && cancellationToken->isCancelled());
+                    }
+                }
+
+                std::lock_guard<std::mutex> lock(progressMutex);
+                progress->setCompletedCount(progress->getCompletedCount() + 1);
+                if (!result->getIsSuccess())
+                    progress->setFailedCount(progress->getFailedCount() + 1);
+                progress->setResult(result);
+                if (onProgress != nullptr) {
+                    try {
+                        onProgress(progress.get());
+                    } catch (std::exception &e) {
+                        LogService::LogWarning(_LogConfig.get(), GIT_LOG_ID, str2wstr(e.what()));
+                    } catch (...) {
+                        LogService::LogWarning(_LogConfig.get(), GIT_LOG_ID, L"Unknown exception in progress callback.");
+                    }
+                }
+            });
+        CATCH
+        return results;
+    }
+
+    std::vector<std::shared_ptr<GitRepositoryResult>> GitMultiRepositoryManager::FetchAll(const std::function<void(const GitRepositoryProgress *)> &onProgress, const CancellationToken *cancellationToken)
+    {
+        TRY
+            return execute(GitRepositoryOperation::Fetch, [cancellationToken](GitManager *gitManager, GitRepositoryResult *) {
+                gitManager->FetchAll(cancellationToken);
+            }, onProgress, cancellationToken);
+        CATCH
+        return {};
+    }
+
+    std::vector<std::shared_ptr<GitRepositoryResult>> GitMultiRepositoryManager::Pull(const GitPullOption *option, const std::function<void(const GitRepositoryProgress *)> &onProgress, const CancellationToken *cancellationToken)
+    {
+        TRY
+            return execute(GitRepositoryOperation::Pull, [option, cancellationToken](GitManager *gitManager, GitRepositoryResult *) {
+                gitManager->Pull(option, cancellationToken);
+            }, onProgress, cancellationToken);
+        CATCH
+        return {};
+    }
+
+    std::vector<std::shared_ptr<GitRepositoryResult>> GitMultiRepositoryManager::getStatus(const GitStatusSearchCriteria *searchCriteria, const std::function<void(const GitRepositoryProgress *)> &onProgress, const CancellationToken *cancellationToken)
+    {
+        TRY
+            return execute(GitRepositoryOperation::Status, [searchCriteria](GitManager *gitManager, GitRepositoryResult *result) {
+                result->setStatus(gitManager->getStatus(searchCriteria));
+            }, onProgress, cancellationToken);
+        CATCH
+        return {};
+    }
+}
@@ -0,0 +1,232 @@
+#include "git_object_session.hpp"
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "exception_macro.hpp"
+#include "git_service.hpp"
+#include "log_service.hpp"
+#include "process_session.hpp"
+#include "string_helper.hpp"
+
+#ifdef _WIN32
+#include "process_service.hpp"
+#endif
+
+namespace vcc
+{
+    std::mutex GitObjectSession::_SessionsMutex;
+    std::map<std::wstring, std::shared_ptr<GitObjectSession>> GitObjectSession::_Sessions;
+
+    namespace
+    {
+        // request bytes written before reading responses, kept below pipe capacity so that git never blocks on stdout while we block on stdin
+        const size_t GIT_OBJECT_SESSION_CHUNK_SIZE = 32 * 1024;
+
+        std::wstring getSessionKey(const std::wstring &workspace)
+        {
+            std::wstring key = std::filesystem::absolute(workspace.empty() ? L"." : workspace).lexically_normal().wstring();
+            while (key.length() > 1 && (key.back() == L'/' || key.back() == L'\\'))
+                key.pop_back();
+            return key;
+        }
+    }
+
+    GitObjectSession::GitObjectSession(std::shared_ptr<LogConfig> logConfig, const std::wstring &workspace)
+    {
+        _LogConfig = logConfig;
+        _Workspace = workspace;
+    }
+
+    GitObjectSession::~GitObjectSession()
+    {
+        try {
+            close();
+        } catch (...) {
+        }
+    }
+
+    std::shared_ptr<GitObjectSession> GitObjectSession::getSession(std::shared_ptr<LogConfig> logConfig, const std::wstring &workspace)
+    {
+        TRY
+            std::wstring key = getSessionKey(workspace);
+            std::lock_guard<std::mutex> lock(_SessionsMutex);
+            auto it = _Sessions.find(key);
+            if (it != _Sessions.end())
+                return it->second;
+            auto session = std::make_shared<GitObjectSession>(logConfig, workspace);
+            _Sessions.insert(std::make_pair(key, session));
+            return session;
+        CATCH
+        return nullptr;
+    }
+
+    void GitObjectSession::closeSession(const std::wstring &workspace)
+    {
+        TRY
+            std::shared_ptr<GitObjectSession> session = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(_SessionsMutex);
+                auto it = _Sessions.find(getSessionKey(workspace));
+                if (it == _Sessions.end())
+                    return;
+                session = it->second;
+                _Sessions.erase(it);
+            }
+            session->close();
+        CATCH
+    }
+
+    void GitObjectSession::closeAllSessions()
+    {
+        TRY
+            std::map<std::wstring, std::shared_ptr<GitObjectSession>> sessions;
+            {
+                std::lock_guard<std::mutex> lock(_SessionsMutex);
+                sessions.swap(_Sessions);
+            }
+            for (auto &session : sessions)
+                session.second->close();
+        CATCH
+    }
+
+    void GitObjectSession::parseObjectHeader(const std::wstring &name, const std::string &header, std::shared_ptr<GitObject> object)
+    {
+        TRY
+            object->setName(name);
+            if (header.ends_with(" missing") || header.ends_with(" ambiguous")) {
+                object->setIsMissing(true);
+                return;
+            }
+            size_t typePos = header.find(' ');
+            size_t sizePos = typePos != std::string::npos ? header.find(' ', typePos + 1) : std::string::npos;
+            if (sizePos == std::string::npos)
+                THROW_EXCEPTION_MSG(ExceptionType::ParserError, L"Unknown git cat-file response: " + str2wstr(header));
+            object->setHashID(str2wstr(header.substr(0, typePos)));
+            object->setType(str2wstr(header.substr(typePos + 1, sizePos - typePos - 1)));
+            object->setSize(std::stoll(header.substr(sizePos + 1)));
+        CATCH
+    }
+
+    #ifdef _WIN32
+    std::shared_ptr<GitObject> GitObjectSession::_RequestByProcess(const std::wstring &name, const bool &isWithContent)
+    {
+        TRY
+            auto object = std::make_shared<GitObject>();
+            object->setName(name);
+            auto result = ProcessService::executeWithResult(_LogConfig.get(), GIT_LOG_ID, _Workspace, L"git rev-parse --verify --quiet \"" + name + L"\"");
+            if (!result->isSuccess() || result->getOutput().empty()) {
+                object->setIsMissing(true);
+                return object;
+            }
+            object->setHashID(result->getOutput());
+            object->setType(ProcessService::executeWithResult(_LogConfig.get(), GIT_LOG_ID, _Workspace, L"git cat-file -t " + object->getHashID())->getOutput());
+            object->setSize(std::stoll(ProcessService::executeWithResult(_LogConfig.get(), GIT_LOG_ID, _Workspace, L"git cat-file -s " + object->getHashID())->getOutput()));
+            if (isWithContent)
+                object->setContent(wstr2str(ProcessService::execute(_LogConfig.get(), GIT_LOG_ID, _Workspace, L"git cat-file " + object->getType() + L" " + object->getHashID())));
+            return object;
+        CATCH
+        return nullptr;
+    }
+    #endif
+
+    std::vector<std::shared_ptr<GitObject>> GitObjectSession::_Request(const std::vector<std::wstring> &names, const bool &isWithContent)
+    {
+        std::vector<std::shared_ptr<GitObject>> result;
+        TRY
+            for (auto const &name : names) {
+                if (name.empty() || name.find(L'\n') != std::wstring::npos)
+                    THROW_EXCEPTION_MSG(ExceptionType::ArgumentNotValid, L"Object name is empty or contains line break.");
+            }
+            std::lock_guard<std::mutex> lock(_Mutex);
+            #ifdef _WIN32
+            for (auto const &name : names)
+                result.push_back(_RequestByProcess(name, isWithContent));
+            #else
+            std::unique_ptr<ProcessSession> &session = isWithContent ? _BatchSession : _BatchCheckSession;
+            if (session == nullptr || !session->isRunning()) {
+                std::wstring command = isWithContent ? L"git cat-file --batch" : L"git cat-file --batch-check";
+                LogService::LogProcess(_LogConfig.get(), GIT_LOG_ID, command);
+                session = std::make_unique<ProcessSession>(_Workspace, command);
+            }
+            try {
+                size_t index = 0;
+                while (index < names.size()) {
+                    std::string request = "";
+                    size_t end = index;
+                    while (end < names.size() && (end == index || request.length() + names[end].length() < GIT_OBJECT_SESSION_CHUNK_SIZE)) {
+                        request += wstr2str(names[end]) + "\n";
+                        end++;
+                    }
+                    session->write(request);
+                    for (; index < end; index++) {
+                        auto object = std::make_shared<GitObject>();
+                        parseObjectHeader(names[index], session->readLine(), object);
+                        if (isWithContent && !object->getIsMissing()) {
+                            object->setContent(session->read(object->getSize()));
+                            // content is followed by line break
+                            session->read(1);
+                        }
+                        result.push_back(object);
+                    }
+                }
+            } catch (...) {
+                // stream position is unknown after failure, restart on next request
+                session->close(0);
+                session.reset();
+                throw;
+            }
+            #endif
+        CATCH
+        return result;
+    }
+
+    std::shared_ptr<GitObject> GitObjectSession::getObject(const std::wstring &name)
+    {
+        TRY
+            return _Request({ name }, true).at(0);
+        CATCH
+        return nullptr;
+    }
+
+    std::shared_ptr<GitObject> GitObjectSession::getObjectInfo(const std::wstring &name)
+    {
+        TRY
+            return _Request({ name }, false).at(0);
+        CATCH
+        return nullptr;
+    }
+
+    std::vector<std::shared_ptr<GitObject>> GitObjectSession::getObjects(const std::vector<std::wstring> &names)
+    {
+        TRY
+            return _Request(names, true);
+        CATCH
+        return {};
+    }
+
+    std::vector<std::shared_ptr<GitObject>> GitObjectSession::getObjectInfos(const std::vector<std::wstring> &names)
+    {
+        TRY
+            return _Request(names, false);
+        CATCH
+        return {};
+    }
+
+    void GitObjectSession::close()
+    {
+        TRY
+            std::lock_guard<std::mutex> lock(_Mutex);
+            if (_BatchSession != nullptr)
+                _BatchSession->close();
+            _BatchSession.reset();
+            if (_BatchCheckSession != nullptr)
+                _BatchCheckSession->close();
+            _BatchCheckSession.reset();
+        CATCH
+    }
+}
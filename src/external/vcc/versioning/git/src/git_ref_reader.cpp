@@ -0,0 +1,271 @@
+#include "git_ref_reader.hpp"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "exception_macro.hpp"
+#include "string_helper.hpp"
+
+namespace vcc
+{
+    namespace
+    {
+        // symbolic ref chain longer than this is treated as broken, same as git
+        const int GIT_REF_MAX_SYMBOLIC_DEPTH = 5;
+
+        bool readFileContent(const std::filesystem::path &path, std::string &content)
+        {
+            std::ifstream stream(path, std::ios::binary);
+            if (!stream.is_open())
+                return false;
+            std::stringstream buffer;
+            buffer << stream.rdbuf();
+            content = buffer.str();
+            return true;
+        }
+
+        std::string trimLine(const std::string &str)
+        {
+            size_t end = str.find_last_not_of(" \t\r\n");
+            return end == std::string::npos ? "" : str.substr(0, end + 1);
+        }
+
+        bool isHashID(const std::string &str)
+        {
+            if (str.length() != 40 && str.length() != 64)
+                return false;
+            for (char c : str) {
+                if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f')))
+                    return false;
+            }
+            return true;
+        }
+
+        // Content of loose ref or HEAD, return false if broken
+        bool parseRefContent(const std::string &content, std::shared_ptr<GitRef> ref)
+        {
+            std::string line = trimLine(content);
+            const std::string symbolicPrefix = "ref: ";
+            if (line.starts_with(symbolicPrefix)) {
+                ref->setSymbolicRef(str2wstr(line.substr(symbolicPrefix.length())));
+                return true;
+            }
+            if (!isHashID(line))
+                return false;
+            ref->setHashID(str2wstr(line));
+            return true;
+        }
+
+        // key is full ref name
+        bool readPackedRefs(const std::filesystem::path &gitDirectory, std::map<std::wstring, std::shared_ptr<GitRef>> &refs)
+        {
+            std::error_code errorCode;
+            std::filesystem::path path = gitDirectory / L"packed-refs";
+            if (!std::filesystem::exists(path, errorCode))
+                return true;
+            std::string content;
+            if (!readFileContent(path, content))
+                return false;
+
+            bool isFullyPeeled = false;
+            bool isTagPeeled = false;
+            std::shared_ptr<GitRef> lastRef = nullptr;
+            std::istringstream stream(content);
+            std::string line;
+            while (std::getline(stream, line)) {
+                line = trimLine(line);
+                if (line.empty())
+                    continue;
+                if (line[0] == '#') {
+                    // # pack-refs with: peeled fully-peeled sorted
+                    isFullyPeeled = line.find(" fully-peeled") != std::string::npos;
+                    isTagPeeled = line.find(" peeled") != std::string::npos;
+                    continue;
+                }
+                if (line[0] == '^') {
+                    if (lastRef == nullptr || !isHashID(line.substr(1)))
+                        return false;
+                    lastRef->setPeeledHashID(str2wstr(line.substr(1)));
+                    lastRef->setIsPeeled(true);
+                    continue;
+                }
+                size_t spacePos = line.find(' ');
+                if (spacePos == std::string::npos || !isHashID(line.substr(0, spacePos)))
+                    return false;
+                auto ref = std::make_shared<GitRef>();
+                ref->setName(str2wstr(line.substr(spacePos + 1)));
+                ref->setHashID(str2wstr(line.substr(0, spacePos)));
+                ref->setIsPeeled(isFullyPeeled || (isTagPeeled && ref->getName().starts_with(L"refs/tags/")));
+                refs[ref->getName()] = ref;
+                lastRef = ref;
+            }
+            return true;
+        }
+
+        bool readLooseRef(const std::filesystem::path &gitDirectory, const std::wstring &name, std::shared_ptr<GitRef> &ref)
+        {
+            ref = nullptr;
+            std::error_code errorCode;
+            std::filesystem::path path = gitDirectory / name;
+            if (!std::filesystem::is_regular_file(path, errorCode))
+                return true;
+            std::string content;
+            if (!readFileContent(path, content))
+                return false;
+            ref = std::make_shared<GitRef>();
+            ref->setName(name);
+            return parseRefContent(content, ref);
+        }
+    }
+
+    std::wstring GitRefReader::getGitDirectory(const std::wstring &workspace)
+    {
+        TRY
+            // repository is chosen by environment, same as git
+            if (std::getenv("GIT_DIR") != nullptr || std::getenv("GIT_COMMON_DIR") != nullptr)
+                return L"";
+
+            std::error_code errorCode;
+            std::filesystem::path directory = std::filesystem::absolute(workspace.empty() ? L"." : workspace, errorCode).lexically_normal();
+            if (errorCode)
+                return L"";
+            std::filesystem::path gitDirectory;
+            while (true) {
+                std::filesystem::path dotGit = directory / L".git";
+                if (std::filesystem::is_directory(dotGit, errorCode)) {
+                    gitDirectory = dotGit;
+                    break;
+                }
+                if (std::filesystem::is_regular_file(dotGit, errorCode)) {
+                    // submodule: "gitdir: ../.git/modules/name"
+                    std::string content;
+                    const std::string prefix = "gitdir: ";
+                    if (!readFileContent(dotGit, content) || !trimLine(content).starts_with(prefix))
+                        return L"";
+                    std::filesystem::path path = std::filesystem::path(str2wstr(trimLine(content).substr(prefix.length())));
+                    gitDirectory = path.is_absolute() ? path : (directory / path).lexically_normal();
+                    break;
+                }
+                if (!directory.has_parent_path() || directory.parent_path() == directory)
+                    return L"";
+                directory = directory.parent_path();
+            }
+
+            // linked worktree shares refs with common directory, reftable is binary
+            if (std::filesystem::exists(gitDirectory / L"commondir", errorCode)
+                || std::filesystem::exists(gitDirectory / L"reftable", errorCode)
+                || !std::filesystem::is_regular_file(gitDirectory / L"HEAD", errorCode))
+                return L"";
+            return gitDirectory.wstring();
+        CATCH
+        return L"";
+    }
+
+    bool GitRefReader::getHead(const std::wstring &workspace, std::wstring &symbolicRef, std::wstring &hashID)
+    {
+        TRY
+            symbolicRef = L"";
+            hashID = L"";
+            std::wstring gitDirectory = getGitDirectory(workspace);
+            if (gitDirectory.empty())
+                return false;
+            std::shared_ptr<GitRef> head = nullptr;
+            if (!readLooseRef(gitDirectory, L"HEAD", head) || head == nullptr)
+                return false;
+            if (head->getSymbolicRef().empty()) {
+                hashID = head->getHashID();
+                return true;
+            }
+            symbolicRef = head->getSymbolicRef();
+            return resolveRef(workspace, symbolicRef, hashID);
+        CATCH
+        return false;
+    }
+
+    bool GitRefReader::getRefs(const std::wstring &workspace, const std::wstring &prefix, std::vector<std::shared_ptr<GitRef>> &refs)
+    {
+        TRY
+            refs.clear();
+            std::wstring gitDirectory = getGitDirectory(workspace);
+            if (gitDirectory.empty())
+                return false;
+
+            std::map<std::wstring, std::shared_ptr<GitRef>> refMap;
+            if (!readPackedRefs(gitDirectory, refMap))
+                return false;
+            for (auto it = refMap.begin(); it != refMap.end(); ) {
+                if (!it->first.starts_with(prefix))
+                    it = refMap.erase(it);
+                else
+                    it++;
+            }
+
+            std::error_code errorCode;
+            std::filesystem::path refsDirectory = std::filesystem::path(gitDirectory) / L"refs";
+            std::filesystem::recursive_directory_iterator it(refsDirectory, errorCode);
+            for (; !errorCode && it != std::filesystem::recursive_directory_iterator(); it.increment(errorCode)) {
+                if (!it->is_regular_file(errorCode))
+                    continue;
+                std::wstring name = std::filesystem::relative(it->path(), gitDirectory).generic_wstring();
+                // ref being updated by git
+                if (name.ends_with(L".lock") || !name.starts_with(prefix))
+                    continue;
+                std::shared_ptr<GitRef> ref = nullptr;
+                if (!readLooseRef(gitDirectory, name, ref))
+                    return false;
+                if (ref != nullptr)
+                    refMap[name] = ref;
+            }
+            if (errorCode)
+                return false;
+
+            // std::map of std::wstring is in code point order, same as byte order of UTF-8 name used by git
+            for (auto const &ref : refMap)
+                refs.push_back(ref.second);
+            return true;
+        CATCH
+        return false;
+    }
+
+    bool GitRefReader::resolveRef(const std::wstring &workspace, const std::wstring &name, std::wstring &hashID)
+    {
+        TRY
+            hashID = L"";
+            std::wstring gitDirectory = getGitDirectory(workspace);
+            if (gitDirectory.empty())
+                return false;
+
+            std::map<std::wstring, std::shared_ptr<GitRef>> packedRefs;
+            bool isPackedRefsRead = false;
+            std::wstring currentName = name;
+            for (int depth = 0; depth < GIT_REF_MAX_SYMBOLIC_DEPTH; depth++) {
+                std::shared_ptr<GitRef> ref = nullptr;
+                if (!readLooseRef(gitDirectory, currentName, ref))
+                    return false;
+                if (ref == nullptr) {
+                    if (!isPackedRefsRead) {
+                        if (!readPackedRefs(gitDirectory, packedRefs))
+                            return false;
+                        isPackedRefsRead = true;
+                    }
+                    auto it = packedRefs.find(currentName);
+                    if (it != packedRefs.end())
+                        hashID = it->second->getHashID();
+                    return true;
+                }
+                if (ref->getSymbolicRef().empty()) {
+                    hashID = ref->getHashID();
+                    return true;
+                }
+                currentName = ref->getSymbolicRef();
+            }
+        CATCH
+        return false;
+    }
+}
@@ -1,7 +1,9 @@
 #include "git_service.hpp"
 
 #include <assert.h>
+#include <cwctype>
 #include <filesystem>
+#include <functional>
 #include <map>
 #include <math.h>
 #include <memory>
@@ -17,6 +19,11 @@
 #include "config_builder.hpp"
 #include "time_helper.hpp"
 #include "exception_macro.hpp"
+#include "file_helper.hpp"
+#include "git_diff_parser.hpp"
+#include "git_log_graph.hpp"
+#include "git_object_session.hpp"
+#include "git_ref_reader.hpp"
 #include "log_config.hpp"
 #include "process_service.hpp"
 #include "string_helper.hpp"
@@ -36,6 +43,149 @@ namespace vcc
     const std::wstring tagPrefix = L"tag:";
 
     const std::wstring remoteMirrorFetch = L"(fetch)";
+
+    namespace
+    {
+        const std::wstring gitRefTagsPrefix = L"refs/tags/";
+        const std::wstring gitRefHeadsPrefix = L"refs/heads/";
+        const std::wstring gitRefRemotesPrefix = L"refs/remotes/";
+
+        // Subject of commit object as git branch -v, first paragraph joined by space
+        std::wstring getCommitSubject(const std::string &content)
+        {
+            size_t messagePos = content.find("\n\n");
+            if (messagePos == std::string::npos)
+                return L"";
+            std::string subject = "";
+            size_t pos = messagePos + 2;
+            while (pos < content.length()) {
+                size_t end = content.find('\n', pos);
+                std::string line = content.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+                size_t lastPos = line.find_last_not_of(" \t\r");
+                if (lastPos == std::string::npos)
+                    break;
+                size_t firstPos = line.find_first_not_of(" \t");
+                subject += (subject.empty() ? "" : " ") + line.substr(firstPos, lastPos - firstPos + 1);
+                if (end == std::string::npos)
+                    break;
+                pos = end + 1;
+            }
+            return str2wstr(subject);
+        }
+
+        // Branches of refs/heads and refs/remotes as git branch -v --all --no-abbrev, return false if git command is needed
+        // Object session is created for this call only if nullptr, persistent session is owned by caller such as GitManager
+        bool getBranchesByRefs(const std::wstring &workspace, GitObjectSession *objectSession, std::vector<std::shared_ptr<GitBranch>> &branches)
+        {
+            #ifdef _WIN32
+            // object session spawns process per object on Windows
+            (void)workspace;
+            (void)objectSession;
+            (void)branches;
+            return false;
+            #else
+            std::wstring headRef = L"";
+            std::wstring headHashID = L"";
+            std::vector<std::shared_ptr<GitRef>> refs;
+            // detached HEAD is shown as "(HEAD detached at ...)"
+            if (!GitRefReader::getHead(workspace, headRef, headHashID) || headRef.empty() || !GitRefReader::getRefs(workspace, L"refs/", refs))
+                return false;
+
+            std::vector<std::wstring> hashIDs;
+            for (auto const &ref : refs) {
+                bool isLocal = ref->getName().starts_with(gitRefHeadsPrefix);
+                if (!isLocal && !ref->getName().starts_with(gitRefRemotesPrefix))
+                    continue;
+                auto branch = std::make_shared<GitBranch>();
+                if (isLocal) {
+                    if (!ref->getSymbolicRef().empty())
+                        return false;
+                    branch->setName(ref->getName().substr(gitRefHeadsPrefix.length()));
+                    branch->setIsActive(ref->getName() == headRef);
+                } else
+                    branch->setName(ref->getName().substr(std::wstring(L"refs/").length()));
+
+                if (!ref->getSymbolicRef().empty()) {
+                    if (!ref->getSymbolicRef().starts_with(gitRefRemotesPrefix))
+                        return false;
+                    branch->setPointToBranch(ref->getSymbolicRef().substr(gitRefRemotesPrefix.length()));
+                } else {
+                    branch->setHashID(ref->getHashID());
+                    hashIDs.push_back(ref->getHashID());
+                }
+                branches.push_back(branch);
+            }
+            if (hashIDs.empty())
+                return true;
+
+            // title is read from commit by git cat-file --batch, one git process for all branches
+            std::unique_ptr<GitObjectSession> scopedSession = nullptr;
+            if (objectSession == nullptr) {
+                scopedSession = std::make_unique<GitObjectSession>(nullptr, workspace);
+                objectSession = scopedSession.get();
+            }
+            auto objects = objectSession->getObjects(hashIDs);
+            std::map<std::wstring, std::wstring> titles;
+            for (auto const &object : objects) {
+                if (object->getIsMissing() || object->getType() != L"commit") {
+                    // session may belong to removed repository of the same path
+                    objectSession->close();
+                    return false;
+                }
+                titles[object->getName()] = getCommitSubject(object->getContent());
+            }
+            for (auto &branch : branches) {
+                if (branch->getHashID().empty())
+                    continue;
+                branch->setTitle(titles[branch->getHashID()]);
+            }
+            return true;
+            #endif
+        }
+
+        // Tag of HEAD without git describe, only if HEAD is tagged by exactly one tag and target of every tag is known
+        bool getCurrentTagByRefs(const std::wstring &workspace, std::shared_ptr<GitTagCurrentTag> currentTag)
+        {
+            std::wstring headRef = L"";
+            std::wstring headHashID = L"";
+            std::vector<std::shared_ptr<GitRef>> refs;
+            if (!GitRefReader::getHead(workspace, headRef, headHashID) || headHashID.empty() || !GitRefReader::getRefs(workspace, gitRefTagsPrefix, refs))
+                return false;
+            std::wstring tagName = L"";
+            for (auto const &ref : refs) {
+                // target of loose tag is unknown unless it is lightweight tag of HEAD
+                bool isHead = ref->getHashID() == headHashID || (ref->getIsPeeled() && ref->getPeeledHashID() == headHashID);
+                if (!isHead && !ref->getIsPeeled())
+                    return false;
+                if (!isHead)
+                    continue;
+                // git describe chooses among tags of the same commit
+                if (!tagName.empty())
+                    return false;
+                tagName = ref->getName().substr(gitRefTagsPrefix.length());
+            }
+            // distance to nearest tag needs commit walk
+            if (tagName.empty())
+                return false;
+            currentTag->setTagName(tagName);
+            return true;
+        }
+
+        // Run network operation, progress is requested by --progress after command (e.g. "git clone") only if onProgress is set
+        void executeWithProgress(const LogConfig *logConfig, const std::wstring &workspace, const std::wstring &command, const std::wstring &optionStr,
+            const CancellationToken *cancellationToken, const std::function<void(const GitProgress *)> &onProgress)
+        {
+            if (onProgress == nullptr) {
+                ProcessService::execute(logConfig, GIT_LOG_ID, workspace, command + optionStr, cancellationToken);
+                return;
+            }
+            auto progress = std::make_shared<GitProgress>();
+            ProcessService::executeErrorStreaming(logConfig, GIT_LOG_ID, workspace, command + L" --progress" + optionStr, [&](const std::wstring &line) {
+                if (GitService::parseGitProgress(line, progress))
+                    onProgress(progress.get());
+            }, cancellationToken);
+        }
+    }
     const std::wstring remoteMirrorPush = L"(push)";
 
     std::wstring GitService::execute(const LogConfig *logConfig, const std::wstring &command)
@@ -102,24 +252,54 @@ namespace vcc
         return GitFileStatus::NA;
     }
     
+    std::vector<std::wstring> GitService::getIgnoredDirectories(const LogConfig *logConfig, const std::wstring &workspace)
+    {
+        std::vector<std::wstring> directories;
+        TRY
+            // ignored files are listed too, directory ends with "/"
+            ProcessService::executeStreaming(logConfig, GIT_LOG_ID, workspace, L"git ls-files --others --ignored --exclude-standard --directory", [&directories](const std::wstring &line) {
+                if (line.ends_with(L"/"))
+                    directories.push_back(line);
+            });
+        CATCH
+        return directories;
+    }
+
+    bool GitService::isIgnored(const LogConfig *logConfig, const std::wstring &workspace, const std::wstring &path)
+    {
+        TRY
+            // exit code 1 if not ignored
+            auto result = ProcessService::executeWithResult(logConfig, GIT_LOG_ID, workspace, L"git check-ignore --quiet -- " + getEscapeStringWithQuote(EscapeStringType::DoubleQuote, path));
+            return result->getExitCode() == 0;
+        CATCH
+        return false;
+    }
+
     std::shared_ptr<GitStatus> GitService::getStatus(const LogConfig *logConfig, const std::wstring &workspace, const GitStatusSearchCriteria *searchCriteria)
     {
         auto status = std::make_shared<GitStatus>();
         TRY
+            std::wstring gitOptionStr = L"";
             std::wstring optionStr = L"";
             if (searchCriteria != nullptr) {
+                if (searchCriteria->getIsNoOptionalLocks())
+                    gitOptionStr += L" --no-optional-locks";
                 if (searchCriteria->getIsWithIgnoreFiles())
                     optionStr += L" --ignored";
+                // path must be at the end
+                if (!searchCriteria->getPaths().empty()) {
+                    optionStr += L" --";
+                    for (const std::wstring &path : searchCriteria->getPaths())
+                        optionStr += L" " + getEscapeStringWithQuote(EscapeStringType::DoubleQuote, path);
+                }
             }
 
-            std::vector<std::wstring> lines = splitStringByLine(ProcessService::execute(logConfig, GIT_LOG_ID, workspace, L"git status -b -s" + optionStr));
-            
             std::wstring localBrachPrefix = L"## No commits yet on ";
             std::wstring remoteBranchPrefix = L"## ";
             size_t prefixLength = 2;
-            for (auto line : lines) {
+            ProcessService::executeStreaming(logConfig, GIT_LOG_ID, workspace, L"git" + gitOptionStr + L" status -b -s" + optionStr, [&](const std::wstring &line) {
                 if (line.length() <= 2)
-                    continue;
+                    return;
 
                 // for branch
                 if (isStartWith(line, localBrachPrefix)) {
@@ -129,13 +309,13 @@ namespace vcc
                     trim(subLine);
                     status->setBranch(subLine);
                     status->setRemoteBranch(L"");
-                    continue;
+                    return;
                 } else if (isStartWith(line, remoteBranchPrefix)) {
                     std::vector<std::wstring> tokens = splitString(line.substr(remoteBranchPrefix.length()), { L"..." });
                     status->setBranch(tokens.at(0));
                     if (tokens.size() > 1)
                         status->setRemoteBranch(tokens.at(1));
-                    continue;
+                    return;
                 }
 
                 // for files
@@ -145,13 +325,13 @@ namespace vcc
                 trim(filePath);
                 if (indexFileStatus == GitFileStatus::Ignored || indexFileStatus == GitFileStatus::Untracked) {
                     status->getWorkingTreeFiles()[indexFileStatus].push_back(filePath);
-                    continue;
+                    return;
                 }
                 if (indexFileStatus != GitFileStatus::NA)
                     status->getIndexFiles()[indexFileStatus].push_back(filePath);
                 if (workingTreeFileStatus != GitFileStatus::NA)
                     status->getWorkingTreeFiles()[workingTreeFileStatus].push_back(filePath);
-            }
+            });
         CATCH
         return status;
     }
@@ -164,7 +344,7 @@ namespace vcc
         CATCH
     }
 
-    void GitService::cloneGitResponse(const LogConfig *logConfig, const std::wstring &workspace, const std::wstring &url, const GitCloneOption *option)
+    void GitService::cloneGitResponse(const LogConfig *logConfig, const std::wstring &workspace, const std::wstring &url, const GitCloneOption *option, const CancellationToken *cancellationToken, const std::function<void(const GitProgress *)> &onProgress)
     {
         TRY
             std::wstring optionStr = L"";
@@ -173,13 +353,49 @@ namespace vcc
                     optionStr += L" -b " + getEscapeStringWithQuote(EscapeStringType::DoubleQuote, option->getBranch());
                 if (option->getDepth() > 0)
                     optionStr +=L" --depth " + std::to_wstring(option->getDepth());
+                if (option->getIsSingleBranch())
+                    optionStr +=L" --single-branch";
+                if (!isBlank(option->getFilter()))
+                    optionStr +=L" --filter=" + getEscapeStringWithQuote(EscapeStringType::DoubleQuote, option->getFilter());
+                // only files in root are checked out until sparse-checkout set
+                if (!option->getSparseCheckoutPaths().empty())
+                    optionStr +=L" --sparse";
                 if (option->getIsQuiet())
                     optionStr +=L" --quiet";
+                if (!isBlank(option->getDirectory()))
+                    optionStr +=L" " + getEscapeStringWithQuote(EscapeStringType::DoubleQuote, option->getDirectory());
+            }
+            executeWithProgress(logConfig, workspace, L"git clone", L" " + url + optionStr, cancellationToken, onProgress);
+
+            if (option != nullptr && !option->getSparseCheckoutPaths().empty()) {
+                std::wstring pathStr = L"";
+                for (auto const &path : option->getSparseCheckoutPaths())
+                    pathStr += L" " + getEscapeStringWithQuote(EscapeStringType::DoubleQuote, path);
+                std::wstring directory = !isBlank(option->getDirectory()) ? option->getDirectory() : getCloneDirectory(url);
+                // blobs of partial clone are fetched here
+                ProcessService::execute(logConfig, GIT_LOG_ID, concatPaths({ workspace, directory }), L"git sparse-checkout set --cone" + pathStr, cancellationToken);
             }
-            ProcessService::execute(logConfig, GIT_LOG_ID, workspace, L"git clone " + url + optionStr);
         CATCH
     }
 
+    std::wstring GitService::getCloneDirectory(const std::wstring &url)
+    {
+        std::wstring result = url;
+        TRY
+            // "https://host/a/b.git/", "git@host:a/b.git", "/path/to/b/.git"
+            while (!result.empty() && (result.back() == L'/' || result.back() == L'\\'))
+                result.pop_back();
+            if (result.ends_with(L"/.git"))
+                result = result.substr(0, result.length() - 5);
+            else if (result.ends_with(L".git"))
+                result = result.substr(0, result.length() - 4);
+            size_t pos = result.find_last_of(L"/\\:");
+            if (pos != std::wstring::npos)
+                result = result.substr(pos + 1);
+        CATCH
+        return result;
+    }
+
     std::vector<std::shared_ptr<GitRemote>> GitService::getRemote(const LogConfig *logConfig, const std::wstring &workspace)
     {
         std::vector<std::shared_ptr<GitRemote>> remotes;
@@ -249,14 +465,14 @@ namespace vcc
         CATCH
     }
 
-    void GitService::FetchAll(const LogConfig *logConfig, const std::wstring &workspace)
+    void GitService::FetchAll(const LogConfig *logConfig, const std::wstring &workspace, const CancellationToken *cancellationToken, const std::function<void(const GitProgress *)> &onProgress)
     {
         TRY
-            ProcessService::execute(logConfig, GIT_LOG_ID, workspace, L"git fetch --all");
+            executeWithProgress(logConfig, workspace, L"git fetch", L" --all", cancellationToken, onProgress);
         CATCH
     }
 
-    void GitService::Pull(const LogConfig *logConfig, const std::wstring &workspace, const GitPullOption *option)
+    void GitService::Pull(const LogConfig *logConfig, const std::wstring &workspace, const GitPullOption *option, const CancellationToken *cancellationToken, const std::function<void(const GitProgress *)> &onProgress)
     {
         TRY
             std::wstring optionStr = L"";
@@ -285,11 +501,11 @@ namespace vcc
                     optionStr += L" " + str;
                 }
             }
-            ProcessService::execute(logConfig, GIT_LOG_ID, workspace, L"git pull " + optionStr);
+            executeWithProgress(logConfig, workspace, L"git pull", optionStr, cancellationToken, onProgress);
         CATCH
     }
 
-    void GitService::Push(const LogConfig *logConfig, const std::wstring &workspace, const GitPushOption *option)
+    void GitService::Push(const LogConfig *logConfig, const std::wstring &workspace, const GitPushOption *option, const CancellationToken *cancellationToken, const std::function<void(const GitProgress *)> &onProgress)
     {
         TRY
             std::wstring optionStr = L"";
@@ -304,8 +520,88 @@ namespace vcc
                     optionStr += L" " + str;
                 }
             }
-            ProcessService::execute(logConfig, GIT_LOG_ID, workspace, L"git push " + optionStr);
+            executeWithProgress(logConfig, workspace, L"git push", optionStr, cancellationToken, onProgress);
+        CATCH
+    }
+
+    bool GitService::parseGitProgress(const std::wstring &line, std::shared_ptr<GitProgress> progress)
+    {
+        TRY
+            // sample: "Receiving objects:  45% (450/1000), 1.20 MiB | 2.40 MiB/s"
+            // sample: "remote: Counting objects: 100% (10/10), done."
+            // sample: "Enumerating objects: 1234, done."
+            const std::wstring remotePrefix = L"remote: ";
+            const std::wstring donePostfix = L", done.";
+            std::wstring str = line;
+            // remote line ends with clear line escape sequence if stderr is terminal
+            if (str.ends_with(L"\x1b[K"))
+                str = str.substr(0, str.length() - 3);
+            bool isRemote = str.starts_with(remotePrefix);
+            if (isRemote)
+                str = str.substr(remotePrefix.length());
+            size_t colonPos = str.find(L": ");
+            if (colonPos == std::wstring::npos || colonPos == 0)
+                return false;
+            std::wstring phase = str.substr(0, colonPos);
+            std::wstring value = str.substr(colonPos + 2);
+            trim(value);
+            bool isDone = value.ends_with(donePostfix);
+            if (isDone)
+                value = value.substr(0, value.length() - donePostfix.length());
+            if (value.empty() || !std::iswdigit(value[0]))
+                return false;
+
+            int64_t percent = -1;
+            int64_t current = 0;
+            int64_t total = -1;
+            size_t pos = 0;
+            while (pos < value.length() && std::iswdigit(value[pos]))
+                pos++;
+            int64_t number = std::stoll(value.substr(0, pos));
+            if (pos < value.length() && value[pos] == L'%') {
+                // "45% (450/1000)"
+                percent = number;
+                size_t openPos = value.find(L'(', pos);
+                size_t slashPos = value.find(L'/', pos);
+                size_t closePos = value.find(L')', pos);
+                if (openPos == std::wstring::npos || slashPos == std::wstring::npos || closePos == std::wstring::npos || !(openPos < slashPos && slashPos < closePos))
+                    return false;
+                current = std::stoll(value.substr(openPos + 1, slashPos - openPos - 1));
+                total = std::stoll(value.substr(slashPos + 1, closePos - slashPos - 1));
+                pos = closePos + 1;
+            } else
+                current = number;
+            if (pos < value.length() && value[pos] != L',')
+                return false;
+
+            std::wstring transferred = L"";
+            std::wstring throughput = L"";
+            if (pos < value.length()) {
+                // ", 1.20 MiB | 2.40 MiB/s"
+                std::wstring transfer = value.substr(pos + 1);
+                size_t barPos = transfer.find(L'|');
+                transferred = transfer.substr(0, barPos);
+                if (barPos != std::wstring::npos)
+                    throughput = transfer.substr(barPos + 1);
+                trim(transferred);
+                trim(throughput);
+            }
+
+            // same phase keeps values until updated, e.g. throughput is not shown in every line
+            bool isSamePhase = progress->getPhase() == phase && progress->getIsRemote() == isRemote;
+            progress->setPhase(phase);
+            progress->setIsRemote(isRemote);
+            progress->setPercent(percent);
+            progress->setCurrent(current);
+            progress->setTotal(total);
+            if (!isSamePhase || !transferred.empty())
+                progress->setTransferred(transferred);
+            if (!isSamePhase || !throughput.empty())
+                progress->setThroughput(throughput);
+            progress->setIsDone(isDone);
+            return true;
         CATCH
+        return false;
     }
 
     std::wstring getGitLogSearchCriteriaString(const GitLogSearchCriteria *searchCriteria)
@@ -455,68 +751,224 @@ namespace vcc
         return optionStr;
     }
 
-    std::vector<std::shared_ptr<GitLog>> GitService::parseGitLogGraph(const std::wstring &str)
+    void GitLogRecordParser::parseHeader(const std::wstring &line, const size_t &pos)
     {
-        std::vector<std::shared_ptr<GitLog>> logs;
         TRY
-            std::vector<std::wstring> lines = splitStringByLine(str);
-            for (const std::wstring &line : lines) {
-                size_t pos = find(line, L"*");
-                if (pos == std::wstring::npos)
-                    continue;
-                auto log = std::make_shared<GitLog>();
-                if (pos > 0) {
-                    log->setColumnIndex((size_t)floor(pos/2));
-                } else
-                    log->setColumnIndex(0);
-                std::wregex pattern(L"\\(([^)]+)\\)");
-                std::wsmatch match;
-                std::wstring::const_iterator searchStart(line.cbegin());
-                size_t cnt = 0;
-                while (std::regex_search(searchStart, line.cend(), match, pattern)) {
-                    switch (cnt)
-                    {
-                    case 0:
-                        log->setHashID(match[1]);
-                        break;
-                    case 1:
-                        log->setAbbreviatedHashID(match[1]);
-                        break;
-                    case 2:
-                        log->setTreeHashID(match[1]);
-                        break;
-                    case 3:
-                        log->setAbbreviatedTreeHashID(match[1]);
-                        break;
-                    case 4: {
-                        std::wstring parentID = match[1];
-                        std::vector<std::wstring> tokens = splitString(parentID, { L" " });
-                        for (std::wstring token : tokens) {
-                            if (isBlank(token))
-                                continue;
-                            trim(token);
-                            log->insertParentHashIDs(token);
+            const size_t fieldCount = 13;
+            size_t start = pos;
+            for (size_t index = 0; index < fieldCount; index++) {
+                size_t end = line.find(L'\x1f', start);
+                if (end == std::wstring::npos)
+                    THROW_EXCEPTION_MSG(ExceptionType::ParserError, L"Git log record has " + std::to_wstring(index) + L" fields only: " + line);
+                std::wstring field = line.substr(start, end - start);
+                start = end + 1;
+                switch (index)
+                {
+                case 0:
+                    _Log->setHashID(field);
+                    break;
+                case 1:
+                    _Log->setAbbreviatedHashID(field);
+                    break;
+                case 2:
+                    _Log->setTreeHashID(field);
+                    break;
+                case 3:
+                    _Log->setAbbreviatedTreeHashID(field);
+                    break;
+                case 4:
+                case 5: {
+                    size_t tokenStart = 0;
+                    while (tokenStart < field.length()) {
+                        size_t tokenEnd = field.find(L' ', tokenStart);
+                        if (tokenEnd == std::wstring::npos)
+                            tokenEnd = field.length();
+                        if (tokenEnd > tokenStart) {
+                            if (index == 4)
+                                _Log->insertParentHashIDs(field.substr(tokenStart, tokenEnd - tokenStart));
+                            else
+                                _Log->insertAbbreviatedParentHashIDs(field.substr(tokenStart, tokenEnd - tokenStart));
                         }
-                        break;
+                        tokenStart = tokenEnd + 1;
                     }
-                    case 5: {
-                        std::wstring parentID = match[1];
-                        std::vector<std::wstring> tokens = splitString(parentID, { L" " });
-                        for (std::wstring token : tokens) {
-                            if (isBlank(token))
-                                continue;
+                    break;
+                }
+                case 6: {
+                    // HEAD -> main, tag: v0.0.1, origin/main
+                    size_t tokenStart = 0;
+                    while (tokenStart < field.length()) {
+                        size_t tokenEnd = field.find(L", ", tokenStart);
+                        if (tokenEnd == std::wstring::npos)
+                            tokenEnd = field.length();
+                        std::wstring token = field.substr(tokenStart, tokenEnd - tokenStart);
+                        tokenStart = tokenEnd + 2;
+                        if (token == L"HEAD")
+                            _Log->setIsHead(true);
+                        else if (isStartWith(token, headerPrefix)) {
+                            _Log->setIsHead(true);
+                            _Log->insertBranches(token.substr(headerPrefix.length()));
+                        } else if (isStartWith(token, tagPrefix)) {
+                            token = token.substr(tagPrefix.length());
                             trim(token);
-                            log->insertAbbreviatedParentHashIDs(token);
-                        }
-                        break;
+                            _Log->insertTags(token);
+                        } else if (!token.empty())
+                            _Log->insertBranches(token);
+                    }
+                    break;
+                }
+                case 7:
+                    _Log->setAuthor(field);
+                    break;
+                case 8:
+                    _Log->setAuthorEmail(field);
+                    break;
+                case 9:
+                    _Log->setAuthorDateStr(field);
+                    if (!field.empty())
+                        _Log->setAuthorDate(GitService::parseGitLogDatetime(field));
+                    break;
+                case 10:
+                    _Log->setCommitter(field);
+                    break;
+                case 11:
+                    _Log->setCommitterEmail(field);
+                    break;
+                case 12:
+                    _Log->setCommitDateStr(field);
+                    if (!field.empty())
+                        _Log->setCommitDate(GitService::parseGitLogDatetime(field));
+                    break;
+                default:
+                    break;
+                }
+            }
+            _FullMessage = line.substr(start);
+        CATCH
+    }
+
+    void GitLogRecordParser::parseMessage(const std::wstring &message)
+    {
+        TRY
+            // first paragraph is title, remaining paragraphs are message
+            _Log->setFullMessage(message);
+            size_t pos = message.find(L"\n\n");
+            if (pos == std::wstring::npos) {
+                size_t titleLength = message.length();
+                while (titleLength > 0 && message[titleLength - 1] == L'\n')
+                    titleLength--;
+                _Log->setTitle(message.substr(0, titleLength));
+            } else {
+                _Log->setTitle(message.substr(0, pos));
+                _Log->setMessage(message.substr(pos + 2));
+            }
+        CATCH
+    }
+
+    std::shared_ptr<GitLog> GitLogRecordParser::parseLine(const std::wstring &line)
+    {
+        TRY
+            size_t searchPos = 0;
+            if (_Log == nullptr) {
+                // line between commits only has graph
+                size_t pos = line.find(L'\x1e');
+                if (pos == std::wstring::npos)
+                    return nullptr;
+                _Log = std::make_shared<GitLog>();
+                _GraphWidth = pos;
+                size_t nodePos = line.find(L'*');
+                _Log->setColumnIndex(nodePos < pos ? nodePos / 2 : 0);
+                parseHeader(line, pos + 1);
+            } else {
+                _FullMessage += L"\n";
+                searchPos = _FullMessage.length();
+                if (line.length() > _GraphWidth)
+                    _FullMessage += line.substr(_GraphWidth);
+            }
+            size_t end = _FullMessage.find(L'\x1d', searchPos);
+            if (end == std::wstring::npos)
+                return nullptr;
+            _FullMessage.resize(end);
+            parseMessage(_FullMessage);
+            auto log = _Log;
+            _Log = nullptr;
+            _FullMessage.clear();
+            return log;
+        CATCH
+        return nullptr;
+    }
+
+    std::shared_ptr<GitLog> GitService::parseGitLogGraphLine(const std::wstring &line)
+    {
+        TRY
+            size_t pos = find(line, L"*");
+            if (pos == std::wstring::npos)
+                return nullptr;
+            auto log = std::make_shared<GitLog>();
+            if (pos > 0) {
+                log->setColumnIndex((size_t)floor(pos/2));
+            } else
+                log->setColumnIndex(0);
+            static const std::wregex pattern(L"\\(([^)]+)\\)");
+            std::wsmatch match;
+            std::wstring::const_iterator searchStart(line.cbegin());
+            size_t cnt = 0;
+            while (std::regex_search(searchStart, line.cend(), match, pattern)) {
+                switch (cnt)
+                {
+                case 0:
+                    log->setHashID(match[1]);
+                    break;
+                case 1:
+                    log->setAbbreviatedHashID(match[1]);
+                    break;
+                case 2:
+                    log->setTreeHashID(match[1]);
+                    break;
+                case 3:
+                    log->setAbbreviatedTreeHashID(match[1]);
+                    break;
+                case 4: {
+                    std::wstring parentID = match[1];
+                    std::vector<std::wstring> tokens = splitString(parentID, { L" " });
+                    for (std::wstring token : tokens) {
+                        if (isBlank(token))
+                            continue;
+                        trim(token);
+                        log->insertParentHashIDs(token);
                     }
-                    default:
-                        break;
+                    break;
+                }
+                case 5: {
+                    std::wstring parentID = match[1];
+                    std::vector<std::wstring> tokens = splitString(parentID, { L" " });
+                    for (std::wstring token : tokens) {
+                        if (isBlank(token))
+                            continue;
+                        trim(token);
+                        log->insertAbbreviatedParentHashIDs(token);
                     }
-                    cnt++;
-                    searchStart = match.suffix().first;
+                    break;
+                }
+                default:
+                    break;
                 }
-                logs.push_back(log);
+                cnt++;
+                searchStart = match.suffix().first;
+            }
+            return log;
+        CATCH
+        return nullptr;
+    }
+
+    std::vector<std::shared_ptr<GitLog>> GitService::parseGitLogGraph(const std::wstring &str)
+    {
+        std::vector<std::shared_ptr<GitLog>> logs;
+        TRY
+            std::vector<std::wstring> lines = splitStringByLine(str);
+            for (const std::wstring &line : lines) {
+                auto log = parseGitLogGraphLine(line);
+                if (log != nullptr)
+                    logs.push_back(log);
             }
         CATCH
         return logs;
@@ -661,41 +1113,73 @@ namespace vcc
         CATCH
     }
     
-    std::vector<std::shared_ptr<GitLog>> GitService::getLogs(const LogConfig *logConfig, const std::wstring &workspace, const GitLogSearchCriteria *searchCriteria)
+    std::vector<std::shared_ptr<GitLog>> GitService::parseGitLogRecords(const std::wstring &str)
     {
         std::vector<std::shared_ptr<GitLog>> logs;
         TRY
-            logs = GitService::parseGitLogGraph(ProcessService::execute(logConfig, GIT_LOG_ID, workspace, L"git log --graph --oneline --pretty=format:\"(%H)(%h)(%T)(%t)(%P)(%p)\" " + getGitLogSearchCriteriaString(searchCriteria)));
-            std::map<std::wstring, std::shared_ptr<GitLog>> logMap;
-            for (auto log : logs) {
-                logMap.insert({log->getHashID(), log});
-            }
-            std::wstring logDetail = L"";
-            std::wstring currentHashID = L"";
-            std::vector<std::wstring> lines = splitStringByLine(ProcessService::execute(logConfig, GIT_LOG_ID, workspace, L"git log --pretty=fuller" + getGitLogSearchCriteriaString(searchCriteria)));
-            for (const std::wstring &line : lines) {
-                if (isStartWith(line, hashIDPrefix)) {
-                    if (!logDetail.empty()) {
-                        parseGitLog(logDetail, logMap.at(currentHashID));
-                    }
-                    logDetail = line;
-                    currentHashID = line.substr(hashIDPrefix.size());
-                    trim(currentHashID);
-                    currentHashID = splitString(currentHashID, { L" " }).at(0);
-                    trim(currentHashID);
-                } else {
-                    if (!logDetail.empty())
-                        logDetail += L"\n";
-                    logDetail += line;
-                }
+            GitLogRecordParser parser;
+            for (const std::wstring &line : splitStringByLine(str)) {
+                auto log = parser.parseLine(line);
+                if (log != nullptr)
+                    logs.push_back(log);
             }
-            if (!logDetail.empty()) {
-                parseGitLog(logDetail, logMap.at(currentHashID));
+        CATCH
+        return logs;
+    }
+
+    std::vector<std::shared_ptr<GitLog>> GitService::getLogs(const LogConfig *logConfig, const std::wstring &workspace, const GitLogSearchCriteria *searchCriteria, const CancellationToken *cancellationToken)
+    {
+        std::vector<std::shared_ptr<GitLog>> logs;
+        TRY
+            logs = getLogRecords(logConfig, workspace, searchCriteria, cancellationToken);
+            // lanes are computed from parent hash ids, parents are rewritten by --parents for path limited history
+            // reversed history has parent before child, skipped history has unknown lanes, no lane layout
+            if (searchCriteria == nullptr || (searchCriteria->getOrderBy() != GitLogOrderBy::Reverse && searchCriteria->getSkip() <= 0)) {
+                GitLogGraph graph;
+                graph.addLogs(logs);
             }
         CATCH
         return logs;
     }
 
+    std::vector<std::shared_ptr<GitLog>> GitService::getLogRecords(const LogConfig *logConfig, const std::wstring &workspace, const GitLogSearchCriteria *searchCriteria, const CancellationToken *cancellationToken)
+    {
+        std::vector<std::shared_ptr<GitLog>> logs;
+        TRY
+            // parse line by line when output is read, full output is not kept
+            GitLogRecordParser parser;
+            ProcessService::executeStreaming(logConfig, GIT_LOG_ID, workspace, L"git log --parents --date=default --pretty=tformat:\"" + std::wstring(GIT_LOG_RECORD_FORMAT) + L"\"" + getGitLogSearchCriteriaString(searchCriteria), [&logs, &parser](const std::wstring &line) {
+                auto log = parser.parseLine(line);
+                if (log != nullptr)
+                    logs.push_back(log);
+            }, cancellationToken);
+        CATCH
+        return logs;
+    }
+
+    void GitService::getLogParents(const LogConfig *logConfig, const std::wstring &workspace, const GitLogSearchCriteria *searchCriteria, const std::function<void(const std::wstring &, const std::vector<std::wstring> &)> &onCommit, const CancellationToken *cancellationToken)
+    {
+        TRY
+            std::vector<std::wstring> parentHashIDs;
+            ProcessService::executeStreaming(logConfig, GIT_LOG_ID, workspace, L"git log --parents --pretty=tformat:\"%H %P\"" + getGitLogSearchCriteriaString(searchCriteria), [&onCommit, &parentHashIDs](const std::wstring &line) {
+                size_t pos = line.find(L' ');
+                if (pos == std::wstring::npos || pos == 0)
+                    return;
+                parentHashIDs.clear();
+                size_t start = pos + 1;
+                while (start < line.length()) {
+                    size_t end = line.find(L' ', start);
+                    if (end == std::wstring::npos)
+                        end = line.length();
+                    if (end > start)
+                        parentHashIDs.push_back(line.substr(start, end - start));
+                    start = end + 1;
+                }
+                onCommit(line.substr(0, pos), parentHashIDs);
+            }, cancellationToken);
+        CATCH
+    }
+
     std::shared_ptr<GitLog> GitService::getCurrentLog(const LogConfig *logConfig, const std::wstring &workspace)
     {
         TRY
@@ -731,12 +1215,35 @@ namespace vcc
                 if (!isBlank(searchCriteria->getOrderBy()))
                     optionStr += L" --sort=" + searchCriteria->getOrderBy();
             }
-            std::vector<std::wstring> lines = splitStringByLine(ProcessService::execute(logConfig, GIT_LOG_ID, workspace, L"git tag -l"));
+            if (optionStr.empty()) {
+                std::vector<std::shared_ptr<GitRef>> refs;
+                if (GitRefReader::getRefs(workspace, gitRefTagsPrefix, refs)) {
+                    for (auto const &ref : refs)
+                        tags.push_back(ref->getName().substr(gitRefTagsPrefix.length()));
+                    return tags;
+                }
+            }
+            std::vector<std::wstring> lines = splitStringByLine(ProcessService::execute(logConfig, GIT_LOG_ID, workspace, L"git tag -l" + optionStr));
             tags.insert(tags.end(), lines.begin(), lines.end());
         CATCH
         return tags;
     }
 
+    bool GitService::isRemoteTagExists(const LogConfig *logConfig, const std::wstring &workspace, const std::wstring &url, const std::wstring &tagName)
+    {
+        TRY
+            // exit code 2 if no matching ref, other non zero exit code if remote cannot be read
+            auto result = ProcessService::executeWithResult(logConfig, GIT_LOG_ID, workspace, L"git ls-remote --exit-code --tags " + url + L" "
+                + getEscapeStringWithQuote(EscapeStringType::DoubleQuote, gitRefTagsPrefix + tagName));
+            if (result->getExitCode() == 0)
+                return true;
+            if (result->getExitCode() == 2)
+                return false;
+            THROW_EXCEPTION_MSG(ExceptionType::CustomError, L"Cannot read tags of " + url + L": " + result->getError());
+        CATCH
+        return false;
+    }
+
     // void GitService::getTag(const LogConfig *logConfig, const std::wstring &workspace, const std::wstring &tagName, std::shared_ptr<GitLog> log)
     // {
     //     TRY
@@ -763,6 +1270,8 @@ namespace vcc
     {
         TRY
             auto currentTag = std::make_shared<GitTagCurrentTag>();
+            if (getCurrentTagByRefs(workspace, currentTag))
+                return currentTag;
             std::wstring tagStr = splitStringByLine(ProcessService::execute(logConfig, GIT_LOG_ID, workspace, L"git describe --tags"))[0];
             std::vector<std::wstring> tokens = splitString(tagStr, { L"-" });
             if (tokens.size() >= 3) {
@@ -860,7 +1369,12 @@ namespace vcc
                 tmpStr = tmpStr.substr(checkoutPrefix.size());
             }
             trim(tmpStr);
-            std::vector<std::wstring> tokens = splitString(tmpStr, { L" ", L"\t"});
+            // names are padded to the same width
+            std::vector<std::wstring> tokens;
+            for (auto const &token : splitString(tmpStr, { L" ", L"\t"})) {
+                if (!token.empty())
+                    tokens.push_back(token);
+            }
             if (tokens.size() < 3)
                 THROW_EXCEPTION_MSG(ExceptionType::CustomError, L"Unexpected git branch pattern: " + str);
             branch->setName(tokens[0]);
@@ -893,16 +1407,24 @@ namespace vcc
     std::wstring GitService::getCurrentBranchName(const LogConfig *logConfig, const std::wstring &workspace)
     {
         TRY
+            std::wstring headRef = L"";
+            std::wstring headHashID = L"";
+            if (GitRefReader::getHead(workspace, headRef, headHashID))
+                return headRef.starts_with(gitRefHeadsPrefix) ? headRef.substr(gitRefHeadsPrefix.length()) : L"";
             return splitStringByLine(ProcessService::execute(logConfig, GIT_LOG_ID, workspace, L"git branch --show-current"))[0];
         CATCH
         return L"";
     }
 
-    std::vector<std::shared_ptr<GitBranch>> GitService::getBranches(const LogConfig *logConfig, const std::wstring &workspace)
+    std::vector<std::shared_ptr<GitBranch>> GitService::getBranches(const LogConfig *logConfig, const std::wstring &workspace, GitObjectSession *objectSession)
     {
         std::vector<std::shared_ptr<GitBranch>> branches;
         TRY
-            std::wstring str = ProcessService::execute(logConfig, GIT_LOG_ID, workspace, L"git branch -v --all");
+            if (getBranchesByRefs(workspace, objectSession, branches))
+                return branches;
+            branches.clear();
+            // full hash id, abbreviated length of git grows with repository size and depends on core.abbrev
+            std::wstring str = ProcessService::execute(logConfig, GIT_LOG_ID, workspace, L"git branch -v --all --no-abbrev");
             if (str.empty())
                 return branches;
             std::vector<std::wstring> lines = splitStringByLine(str);
@@ -1018,85 +1540,21 @@ namespace vcc
     std::shared_ptr<GitDifference> GitService::parseGitDiff(const std::wstring &str)
     {
         TRY
-            auto difference = std::make_shared<GitDifference>();
-            std::wstring filePathOldPrefix = L"--- a/";
-            std::wstring filePathNewPrefix = L"+++ b/";
-            std::wstring lineCountPrefix = L"@@";
-            std::vector<std::wstring> lines = splitStringByLine(str);
-            size_t rowCount = 0;
-            size_t currentItem = 0;
-            std::wstring currentText = L"";
-            for (const std::wstring &line : lines) {
-                if (rowCount > 0) {
-                    currentText += line + L"\n";
-                    if (rowCount == 1) {
-                        difference->insertChangedLines(currentText);
-                        currentText = L"";
-                    }
-                    rowCount--;
-                } else {
-                    if (isStartWith(line, filePathOldPrefix)) {
-                        std::wstring tmpStr = line.substr(filePathOldPrefix.length());
-                        trim(tmpStr);
-                        difference->setFilePathOld(tmpStr);
-                    } else if (isStartWith(line, filePathNewPrefix)){
-                        std::wstring tmpStr = line.substr(filePathNewPrefix.length());
-                        trim(tmpStr);
-                        difference->setFilePathNew(tmpStr);
-                    } else if (isStartWith(line, lineCountPrefix)) {
-                        // sample new: @@ -1 +1,2 @@
-                        // sample modify: @@ -116,10 +116,10 @@ xxxx
-                        // 1. Chop to remove all @@
-                        // 2. get all numbers
-                        std::wstring tmpStr = line.substr(lineCountPrefix.length());
-                        tmpStr = tmpStr.substr(0, find(tmpStr, lineCountPrefix));
-                        trim(tmpStr);
-                        std::vector<std::wstring> tokens = splitString(tmpStr, { L" " });
-                        if (tokens.size() != 2)
-                            THROW_EXCEPTION_MSG(ExceptionType::CustomError, L"Unexpected pattern: " + line);
-
-                        // old
-                        std::vector<std::wstring> lineCountOld = splitString(tokens[0], { L"," });
-                        if (!(lineCountOld.size() == 1 || lineCountOld.size() == 2))
-                            THROW_EXCEPTION_MSG(ExceptionType::CustomError, L"Unexpected pattern: " + line);
-
-                        std::wstring lineNumberStr = lineCountOld[0];
-                        trim(lineNumberStr);
-                        if (!(isStartWith(lineNumberStr, L"-") && lineNumberStr.length() > 1))
-                            THROW_EXCEPTION_MSG(ExceptionType::CustomError, L"Unexpected pattern: " + line);
-
-                        difference->insertLineNumberOld((size_t)stoi(lineNumberStr.substr(1)));
-                        if (lineCountOld.size() > 1) {
-                            std::wstring lineCountStr = lineCountOld[1];
-                            trim(lineCountStr);
-                            difference->insertLineCountOld((size_t)stoi(lineCountStr));
-                        } else
-                            difference->insertLineCountOld((size_t)0);
-
-                        // new
-                        std::vector<std::wstring> lineCountNew = splitString(tokens[1], { L"," });
-                        if (!(lineCountNew.size() == 1 || lineCountNew.size() == 2))
-                            THROW_EXCEPTION_MSG(ExceptionType::CustomError, L"Unexpected pattern: " + line);
-
-                        lineNumberStr = lineCountNew[0];
-                        trim(lineNumberStr);
-                        if (!(isStartWith(lineNumberStr, L"+") && lineNumberStr.length() > 1))
-                            THROW_EXCEPTION_MSG(ExceptionType::CustomError, L"Unexpected pattern: " + line);
-
-                        difference->insertLineNumberNew((size_t)stoi(lineNumberStr.substr(1)));
-                        if (lineCountNew.size() > 1) {
-                            std::wstring lineCountStr = lineCountNew[1];
-                            trim(lineCountStr);
-                            difference->insertLineCountNew((size_t)stoi(lineCountStr));
-                        } else
-                            difference->insertLineCountNew((size_t)0);
-
-                        currentItem = difference->getLineCountNew().size() - 1;
-                        rowCount = std::max(difference->getLineCountOld()[currentItem], difference->getLineCountNew()[currentItem]);
-                    }
-                }
-            }
-            return difference;
+            GitDiffParser parser;
+            parser.parse(str);
+            return parser.getDifference(!parser.getFiles().empty() ? parser.getFiles().front().get() : nullptr);
+        CATCH
+        return nullptr;
+    }
+
+    std::shared_ptr<GitDifference> GitService::executeGitDiff(const LogConfig *logConfig, const std::wstring &workspace, const std::wstring &command)
+    {
+        TRY
+            GitDiffParser parser;
+            ProcessService::executeStreaming(logConfig, GIT_LOG_ID, workspace, command, [&](const std::wstring &line) {
+                parser.parseLine(line);
+            });
+            return parser.getDifference(!parser.getFiles().empty() ? parser.getFiles().front().get() : nullptr);
         CATCH
         return nullptr;
     }
@@ -1113,7 +1571,7 @@ namespace vcc
                 if (!searchCriteria->getHashIDs().empty())
                     optionStr += L" " + concat(searchCriteria->getHashIDs(), L" ");
             }
-            return parseGitDiff(ProcessService::execute(logConfig, GIT_LOG_ID, workspace, L"git diff --cached" + optionStr));
+            return executeGitDiff(logConfig, workspace, L"git diff --cached" + optionStr);
         CATCH
         return nullptr;
     }
@@ -1130,7 +1588,7 @@ namespace vcc
                 if (!searchCriteria->getHashIDs().empty())
                     optionStr += L" " + concat(searchCriteria->getHashIDs(), L" ");
             }
-            return parseGitDiff(ProcessService::execute(logConfig, GIT_LOG_ID, workspace, L"git diff" + optionStr + L" \"" + getEscapeString(EscapeStringType::DoubleQuote, filePath) + L"\""));
+            return executeGitDiff(logConfig, workspace, L"git diff" + optionStr + L" \"" + getEscapeString(EscapeStringType::DoubleQuote, filePath) + L"\"");
         CATCH
         return nullptr;
     }
@@ -1147,7 +1605,7 @@ namespace vcc
                 if (!searchCriteria->getHashIDs().empty())
                     optionStr += L" " + concat(searchCriteria->getHashIDs(), L" ");
             }
-            return parseGitDiff(ProcessService::execute(logConfig, GIT_LOG_ID, workspace, L"git diff HEAD" + optionStr + L" \"" + getEscapeString(EscapeStringType::DoubleQuote, filePath) + L"\""));
+            return executeGitDiff(logConfig, workspace, L"git diff HEAD" + optionStr + L" \"" + getEscapeString(EscapeStringType::DoubleQuote, filePath) + L"\"");
         CATCH
         return nullptr;
     }
@@ -1161,11 +1619,47 @@ namespace vcc
                 if (searchCriteria->getNoOfLines() > -1)
                     optionStr += L" --unified=" + std::to_wstring(searchCriteria->getNoOfLines());
             }
-            return parseGitDiff(ProcessService::execute(logConfig, GIT_LOG_ID, workspace, L"git diff" + optionStr + L" " + fromHashID + L"..." + toHashID + L" \"" + getEscapeString(EscapeStringType::DoubleQuote, filePath) + L"\""));
+            return executeGitDiff(logConfig, workspace, L"git diff" + optionStr + L" " + fromHashID + L"..." + toHashID + L" \"" + getEscapeString(EscapeStringType::DoubleQuote, filePath) + L"\"");
         CATCH
         return nullptr;
     }
 
+    std::vector<std::shared_ptr<GitDifference>> GitService::getDifferences(const LogConfig *logConfig, const std::wstring &workspace, const std::vector<std::wstring> &filePaths, const GitDifferentSearchCriteria *searchCriteria, const CancellationToken *cancellationToken)
+    {
+        std::vector<std::shared_ptr<GitDifference>> differences;
+        TRY
+            // paths of one git diff, keep command line far below system limit
+            const size_t maxPathLength = 32 * 1024;
+
+            std::wstring optionStr = L"";
+            if (searchCriteria != nullptr) {
+                if (searchCriteria->getIsCached())
+                    optionStr += L" --cached";
+
+                if (searchCriteria->getNoOfLines() > -1)
+                    optionStr += L" --unified=" + std::to_wstring(searchCriteria->getNoOfLines());
+                
+                if (!searchCriteria->getHashIDs().empty())
+                    optionStr += L" " + concat(searchCriteria->getHashIDs(), L" ");
+            }
+
+            GitDiffParser parser;
+            size_t index = 0;
+            do {
+                std::wstring pathStr = L"";
+                for (; index < filePaths.size() && (pathStr.empty() || pathStr.length() + filePaths[index].length() < maxPathLength); index++)
+                    pathStr += L" \"" + getEscapeString(EscapeStringType::DoubleQuote, filePaths[index]) + L"\"";
+                ProcessService::executeStreaming(logConfig, GIT_LOG_ID, workspace, L"git diff" + optionStr + L" --" + pathStr, [&](const std::wstring &line) {
+                    parser.parseLine(line);
+                }, cancellationToken);
+            } while (index < filePaths.size());
+
+            for (auto const &file : parser.getFiles())
+                differences.push_back(parser.getDifference(file.get()));
+        CATCH
+        return differences;
+    }
+
     void GitService::stage(const LogConfig *logConfig, const std::wstring &workspace, const std::wstring &filePath)
     {
         TRY
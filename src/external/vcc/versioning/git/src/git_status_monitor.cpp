@@ -0,0 +1,394 @@
+#include "git_status_monitor.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include "exception_macro.hpp"
+#include "git_service.hpp"
+#include "log_service.hpp"
+#include "string_helper.hpp"
+
+namespace vcc
+{
+    namespace
+    {
+        // Status entry of "a.txt -> b.txt" belongs to both paths
+        bool isEntryUnderPath(const std::wstring &entryPath, const std::wstring &path)
+        {
+            size_t renamePos = entryPath.find(L" -> ");
+            if (renamePos != std::wstring::npos)
+                return isEntryUnderPath(entryPath.substr(0, renamePos), path) || isEntryUnderPath(entryPath.substr(renamePos + 4), path);
+            if (path.empty() || entryPath == path)
+                return true;
+            std::wstring prefix = path.back() == L'/' ? path : path + L"/";
+            return entryPath.starts_with(prefix);
+        }
+
+        std::wstring joinRelativePath(const std::wstring &directory, const std::wstring &name)
+        {
+            if (directory.empty())
+                return name;
+            if (name.empty())
+                return directory;
+            return directory + L"/" + name;
+        }
+    }
+
+    GitStatusMonitor::GitStatusMonitor(std::shared_ptr<LogConfig> logConfig, const std::wstring &workspace, const GitStatusSearchCriteria *searchCriteria)
+    {
+        _LogConfig = logConfig;
+        _Workspace = workspace;
+        _SearchCriteria = searchCriteria != nullptr ? std::dynamic_pointer_cast<GitStatusSearchCriteria>(searchCriteria->clone()) : std::make_shared<GitStatusSearchCriteria>();
+        // status must not write index, otherwise index change triggers status again
+        _SearchCriteria->setIsNoOptionalLocks(true);
+        _SearchCriteria->clearPaths();
+    }
+
+    GitStatusMonitor::~GitStatusMonitor()
+    {
+        try {
+            stop();
+        } catch (...) {
+        }
+    }
+
+    void GitStatusMonitor::setOnChanged(std::function<void(std::shared_ptr<GitStatus>)> onChanged)
+    {
+        std::lock_guard<std::mutex> lock(_Mutex);
+        _OnChanged = onChanged;
+    }
+
+    void GitStatusMonitor::addWatch(const std::wstring &relativeDirectory)
+    {
+        #ifdef __linux__
+        std::string directory = wstr2str((std::filesystem::path(_Workspace) / relativeDirectory).wstring());
+        int wd = inotify_add_watch(_InotifyFd, directory.c_str(), IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_ATTRIB | IN_ONLYDIR);
+        if (wd < 0) {
+            // e.g. limit of fs.inotify.max_user_watches, change under this directory is not detected
+            LogService::LogWarning(_LogConfig.get(), GIT_LOG_ID, L"Cannot watch " + str2wstr(directory));
+            return;
+        }
+        _WatchDirectories[wd] = relativeDirectory;
+        #else
+        (void)relativeDirectory;
+        #endif
+    }
+
+    void GitStatusMonitor::loadIgnoredDirectories()
+    {
+        TRY
+            _IgnoredDirectories.clear();
+            for (auto directory : GitService::getIgnoredDirectories(_LogConfig.get(), _Workspace)) {
+                directory.pop_back();
+                _IgnoredDirectories.insert(directory);
+            }
+        CATCH
+    }
+
+    void GitStatusMonitor::addWatchRecursively(const std::wstring &relativeDirectory)
+    {
+        TRY
+            addWatch(relativeDirectory);
+            std::filesystem::path root = std::filesystem::path(_Workspace) / relativeDirectory;
+            std::error_code errorCode;
+            std::filesystem::recursive_directory_iterator it(root, std::filesystem::directory_options::skip_permission_denied, errorCode);
+            for (; !errorCode && it != std::filesystem::recursive_directory_iterator(); it.increment(errorCode)) {
+                if (!it->is_directory(errorCode) || it->is_symlink(errorCode))
+                    continue;
+                std::wstring path = std::filesystem::relative(it->path(), _Workspace).generic_wstring();
+                // e.g. bin/, build/, node_modules/ may exceed fs.inotify.max_user_watches
+                if (it->path().filename() == L".git" || _IgnoredDirectories.contains(path)) {
+                    it.disable_recursion_pending();
+                    continue;
+                }
+                addWatch(path);
+            }
+        CATCH
+    }
+
+    void GitStatusMonitor::start()
+    {
+        TRY
+            if (_IsRunning)
+                return;
+            #ifdef __linux__
+            _InotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            if (_InotifyFd < 0)
+                THROW_EXCEPTION_MSG(ExceptionType::CustomError, L"inotify_init1 failed.");
+            loadIgnoredDirectories();
+            addWatchRecursively(L"");
+            // HEAD, index and packed-refs are replaced by rename
+            std::string gitDirectory = wstr2str((std::filesystem::path(_Workspace) / L".git").wstring());
+            _GitDirectoryWatch = inotify_add_watch(_InotifyFd, gitDirectory.c_str(), IN_MOVED_TO | IN_CLOSE_WRITE | IN_DELETE | IN_ONLYDIR);
+            // branch refs such as feature/x are nested, remote refs updated by fetch change ahead and behind
+            addWatchRecursively(L".git/refs");
+            #endif
+            // Query after watches are installed, change made during query is reported by event instead of lost
+            try {
+                refreshAll();
+            } catch (...) {
+                stop();
+                throw;
+            }
+            #ifdef __linux__
+            _IsRunning = true;
+            _Watcher = std::thread(&GitStatusMonitor::run, this);
+            #endif
+        CATCH
+    }
+
+    void GitStatusMonitor::stop()
+    {
+        _IsRunning = false;
+        if (_Watcher.joinable())
+            _Watcher.join();
+        #ifdef __linux__
+        if (_InotifyFd >= 0) {
+            close(_InotifyFd);
+            _InotifyFd = -1;
+        }
+        #endif
+        _WatchDirectories.clear();
+        _GitDirectoryWatch = -1;
+    }
+
+    bool GitStatusMonitor::isRunning() const
+    {
+        return _IsRunning;
+    }
+
+    void GitStatusMonitor::run()
+    {
+        #ifdef __linux__
+        std::set<std::wstring> dirtyPaths;
+        bool isRefreshAll = false;
+        bool hasChange = false;
+        auto firstChangeTime = std::chrono::steady_clock::now();
+        auto lastChangeTime = firstChangeTime;
+        alignas(struct inotify_event) char buffer[64 * 1024];
+        while (_IsRunning) {
+            try {
+                // wake up regularly to check stop
+                int64_t timeout = 100;
+                auto now = std::chrono::steady_clock::now();
+                if (hasChange) {
+                    auto deadline = std::min(lastChangeTime + std::chrono::milliseconds(_Debounce), firstChangeTime + std::chrono::milliseconds(_MaxDelay));
+                    timeout = std::clamp((int64_t)std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count(), (int64_t)0, timeout);
+                }
+                struct pollfd pfd = { _InotifyFd, POLLIN, 0 };
+                if (poll(&pfd, 1, (int)timeout) > 0 && (pfd.revents & POLLIN)) {
+                    ssize_t length = 0;
+                    while ((length = read(_InotifyFd, buffer, sizeof(buffer))) > 0) {
+                        for (char *ptr = buffer; ptr < buffer + length; ) {
+                            struct inotify_event *event = (struct inotify_event *)ptr;
+                            ptr += sizeof(struct inotify_event) + event->len;
+                            std::wstring name = event->len > 0 ? str2wstr(event->name) : L"";
+                            if (event->mask & IN_Q_OVERFLOW)
+                                isRefreshAll = true;
+                            else if (event->wd == _GitDirectoryWatch) {
+                                if (name == L"HEAD" || name == L"index" || name == L"packed-refs")
+                                    isRefreshAll = true;
+                                else
+                                    continue;
+                            } else {
+                                auto it = _WatchDirectories.find(event->wd);
+                                if (it == _WatchDirectories.end())
+                                    continue;
+                                if (event->mask & IN_IGNORED) {
+                                    _WatchDirectories.erase(it);
+                                    continue;
+                                }
+                                std::wstring path = joinRelativePath(it->second, name);
+                                bool isNewDirectory = (event->mask & IN_ISDIR) && (event->mask & (IN_CREATE | IN_MOVED_TO));
+                                if (it->second.starts_with(L".git/")) {
+                                    if (name.ends_with(L".lock"))
+                                        continue;
+                                    if (isNewDirectory)
+                                        addWatchRecursively(path);
+                                    isRefreshAll = true;
+                                } else if (name == L".gitignore") {
+                                    // directory may be ignored or not ignored anymore, existing watch is kept
+                                    loadIgnoredDirectories();
+                                    addWatchRecursively(L"");
+                                    isRefreshAll = true;
+                                } else {
+                                    if (name == L".git")
+                                        continue;
+                                    if (isNewDirectory) {
+                                        if (GitService::isIgnored(_LogConfig.get(), _Workspace, path)) {
+                                            _IgnoredDirectories.insert(path);
+                                            continue;
+                                        }
+                                        addWatchRecursively(path);
+                                    }
+                                    dirtyPaths.insert(path);
+                                }
+                            }
+                            now = std::chrono::steady_clock::now();
+                            if (!hasChange)
+                                firstChangeTime = now;
+                            lastChangeTime = now;
+                            hasChange = true;
+                        }
+                    }
+                }
+
+                now = std::chrono::steady_clock::now();
+                if (hasChange && (now >= lastChangeTime + std::chrono::milliseconds(_Debounce) || now >= firstChangeTime + std::chrono::milliseconds(_MaxDelay))) {
+                    if (isRefreshAll || (int64_t)dirtyPaths.size() > _MaxDirtyPathCount)
+                        refreshAll();
+                    else
+                        refreshPaths(dirtyPaths);
+                    dirtyPaths.clear();
+                    isRefreshAll = false;
+                    hasChange = false;
+
+                    std::function<void(std::shared_ptr<GitStatus>)> onChanged = nullptr;
+                    {
+                        std::lock_guard<std::mutex> lock(_Mutex);
+                        onChanged = _OnChanged;
+                    }
+                    if (onChanged != nullptr)
+                        onChanged(buildStatus());
+                }
+            } catch (std::exception &e) {
+                // keep watching, next change queries again
+                LogService::LogError(_LogConfig.get(), GIT_LOG_ID, str2wstr(e.what()));
+                dirtyPaths.clear();
+                isRefreshAll = true;
+            }
+        }
+        #endif
+    }
+
+    void GitStatusMonitor::applyStatus(std::shared_ptr<GitStatus> status)
+    {
+        _Branch = status->getBranch();
+        _RemoteBranch = status->getRemoteBranch();
+        for (auto const &files : status->getIndexFiles()) {
+            for (auto const &path : files.second)
+                _Entries[path].IndexStatus = files.first;
+        }
+        for (auto const &files : status->getWorkingTreeFiles()) {
+            for (auto const &path : files.second)
+                _Entries[path].WorkingTreeStatus = files.first;
+        }
+    }
+
+    void GitStatusMonitor::refreshAll()
+    {
+        TRY
+            auto status = GitService::getStatus(_LogConfig.get(), _Workspace, _SearchCriteria.get());
+            std::lock_guard<std::mutex> lock(_Mutex);
+            _QueryCount++;
+            _Entries.clear();
+            applyStatus(status);
+        CATCH
+    }
+
+    void GitStatusMonitor::refreshPaths(const std::set<std::wstring> &paths)
+    {
+        TRY
+            if (paths.empty())
+                return;
+            // changed path inside collapsed untracked directory "dir/" queries the directory
+            std::set<std::wstring> queryPaths = paths;
+            {
+                std::lock_guard<std::mutex> lock(_Mutex);
+                for (auto const &entry : _Entries) {
+                    if (!entry.first.ends_with(L"/"))
+                        continue;
+                    for (auto const &path : paths) {
+                        if (path.starts_with(entry.first)) {
+                            queryPaths.insert(entry.first.substr(0, entry.first.length() - 1));
+                            break;
+                        }
+                    }
+                }
+            }
+            // path under another queried directory is covered by it, otherwise git lists "dir/a.txt" of untracked directory instead of "dir/"
+            for (auto it = queryPaths.begin(); it != queryPaths.end(); ) {
+                bool isCovered = std::any_of(queryPaths.begin(), queryPaths.end(), [&it](const std::wstring &path) {
+                    return it->starts_with(path + L"/");
+                });
+                it = isCovered ? queryPaths.erase(it) : std::next(it);
+            }
+
+            auto searchCriteria = std::dynamic_pointer_cast<GitStatusSearchCriteria>(_SearchCriteria->clone());
+            for (auto const &path : queryPaths)
+                searchCriteria->insertPaths(path);
+            auto status = GitService::getStatus(_LogConfig.get(), _Workspace, searchCriteria.get());
+
+            std::lock_guard<std::mutex> lock(_Mutex);
+            _QueryCount++;
+            for (auto it = _Entries.begin(); it != _Entries.end(); ) {
+                bool isQueried = false;
+                for (auto const &path : queryPaths) {
+                    if (isEntryUnderPath(it->first, path)) {
+                        isQueried = true;
+                        break;
+                    }
+                }
+                if (isQueried)
+                    it = _Entries.erase(it);
+                else
+                    it++;
+            }
+            applyStatus(status);
+        CATCH
+    }
+
+    std::shared_ptr<GitStatus> GitStatusMonitor::buildStatus() const
+    {
+        auto status = std::make_shared<GitStatus>();
+        TRY
+            std::lock_guard<std::mutex> lock(_Mutex);
+            status->setBranch(_Branch);
+            status->setRemoteBranch(_RemoteBranch);
+            for (auto const &entry : _Entries) {
+                if (entry.second.IndexStatus != GitFileStatus::NA)
+                    status->getIndexFiles()[entry.second.IndexStatus].push_back(entry.first);
+                if (entry.second.WorkingTreeStatus != GitFileStatus::NA)
+                    status->getWorkingTreeFiles()[entry.second.WorkingTreeStatus].push_back(entry.first);
+            }
+        CATCH
+        return status;
+    }
+
+    std::shared_ptr<GitStatus> GitStatusMonitor::getStatus()
+    {
+        TRY
+            if (!_IsRunning)
+                refreshAll();
+            return buildStatus();
+        CATCH
+        return nullptr;
+    }
+
+    int64_t GitStatusMonitor::getQueryCount() const
+    {
+        std::lock_guard<std::mutex> lock(_Mutex);
+        return _QueryCount;
+    }
+
+    void GitStatusMonitor::refresh()
+    {
+        TRY
+            refreshAll();
+        CATCH
+    }
+}
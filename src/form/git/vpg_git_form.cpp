@@ -17,6 +17,10 @@
 #include "vpg_git_log.hpp"
 
 // <vcc:customHeader sync="RESERVE" gen="RESERVE">
+#include <algorithm>
+#include <vector>
+
+#include "git_service.hpp"
 // </vcc:customHeader>
 
 VPGGitForm::VPGGitForm() : vcc::BaseForm()
@@ -78,4 +82,25 @@ std::shared_ptr<vcc::IResult> VPGGitForm::doAction(const int64_t &formProperty,
 }
 
 // <vcc:customFunctions sync="RESERVE" gen="RESERVE">
+std::vector<std::shared_ptr<vcc::GitLog>> VPGGitForm::getVisibleLogs(const int64_t &firstRow, const int64_t &rowCount)
+{
+    std::vector<std::shared_ptr<vcc::GitLog>> result;
+    TRY
+        if (_GitManager == nullptr || rowCount <= 0)
+            return result;
+        int64_t pageSize = std::max(_LogPageSize, (int64_t)1);
+        int64_t firstPageOffset = std::max(firstRow, (int64_t)0) / pageSize * pageSize;
+        int64_t endRow = std::max(firstRow, (int64_t)0) + rowCount;
+        // visible pages and prefetched next page
+        _GitManager->setLogPageCacheSize((endRow - firstPageOffset + pageSize - 1) / pageSize + 1);
+        for (int64_t offset = firstPageOffset; offset < endRow; offset += pageSize) {
+            auto logs = _GitManager->getLogPage(offset, pageSize);
+            for (int64_t i = std::max(firstRow - offset, (int64_t)0); i < (int64_t)logs.size() && offset + i < endRow; i++)
+                result.push_back(logs.at(i));
+            if ((int64_t)logs.size() < pageSize)
+                break;
+        }
+    CATCH
+    return result;
+}
 // </vcc:customFunctions>
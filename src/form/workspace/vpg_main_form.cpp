@@ -22,6 +22,7 @@
 
 // <vcc:customHeader sync="RESERVE" gen="RESERVE">
 #include "file_helper.hpp"
+#include "git_multi_repository_manager.hpp"
 #include "i_property_accessor.hpp"
 #include "lock_type.hpp"
 #include "property_accessor_factory.hpp"
@@ -361,4 +362,20 @@ void VPGMainForm::saveConfig() const
         vcc::writeFile(VPGGlobal::getVCCProjectManagerConfigFileFullPath(), serializeJson(jsonBuilder.get()), true);
     CATCH
 }
+
+std::shared_ptr<vcc::GitMultiRepositoryManager> VPGMainForm::getGitMultiRepositoryManager() const
+{
+    auto result = std::make_shared<vcc::GitMultiRepositoryManager>(_LogConfig);
+    TRY
+        for (auto const &workspaceForm : _WorkspaceForms) {
+            for (auto const &gitForm : workspaceForm->getGitForms()) {
+                auto gitManager = gitForm->getGitManager();
+                // form may be opened for directory which is not repository yet
+                if (gitManager != nullptr && vcc::GitMultiRepositoryManager::isRepositoryRoot(gitManager->getWorkspace()))
+                    result->addGitManager(gitManager);
+            }
+        }
+    CATCH
+    return result;
+}
 // </vcc:customFunctions>
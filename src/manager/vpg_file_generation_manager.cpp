@@ -7,6 +7,7 @@
 
 #include "exception_macro.hpp"
 #include "file_helper.hpp"
+#include "log_macro.hpp"
 #include "log_service.hpp"
 #include "string_helper.hpp"
 
@@ -231,12 +232,12 @@ void VPGFileGenerationManager::generateProperty(const vcc::LogConfig *logConfig,
                 middlePath = L"";
 
             if (!vcc::isBlank(projPrefix) && !vcc::isStartWith(fileName, filePrefix))
-                vcc::LogService::LogWarning(logConfig, logId, L"Class Prefix " + projPrefix + L" missing. Skip: " + path);
+                VCC_LOG_WARNING(logConfig, logId, L"Class Prefix {} missing. Skip: {}", projPrefix, path);
 
             // ------------------------------------------------------------------------------------------ //
             //                                      Parse File Start                                      //
             // ------------------------------------------------------------------------------------------ //
-            vcc::LogService::LogWarning(logConfig, logId, L"Parse file start: " + path);
+            VCC_LOG_WARNING(logConfig, logId, L"Parse file start: {}", path);
 
             std::wstring fileContent = vcc::readFile(path);
             vcc::trim(fileContent);
@@ -265,7 +266,7 @@ void VPGFileGenerationManager::generateProperty(const vcc::LogConfig *logConfig,
                     objectEnumClassList.push_back(enumClass);
                 } else {
                     std::wstring classPrefixStr = !vcc::isBlank(projPrefix) ? (L"Prefix " + projPrefix + L" or ") : L"";
-                    vcc::LogService::LogWarning(logConfig, logId, L"Class " + classPrefixStr + L"Suffix " + propertyClassNameSuffix + L"missing. Not generate object for " + enumClass->getName());
+                    VCC_LOG_WARNING(logConfig, logId, L"Class {}Suffix {}missing. Not generate object for {}", classPrefixStr, propertyClassNameSuffix, enumClass->getName());
                 }
             
                 // ------------------------------------------------------------------------------------------ //
@@ -326,7 +327,7 @@ void VPGFileGenerationManager::generateProperty(const vcc::LogConfig *logConfig,
             // ------------------------------------------------------------------------------------------ //
             //                                      Parse File End                                        //
             // ------------------------------------------------------------------------------------------ //
-            vcc::LogService::logInfo(logConfig, logId, L"Parse file completed: " + path);
+            VCC_LOG_INFO(logConfig, logId, L"Parse file completed: {}", path);
         }
         // ------------------------------------------------------------------------------------------ //
         //                               Generate Object Type File                                    //
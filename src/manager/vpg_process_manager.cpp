@@ -5,10 +5,13 @@
 
 #include "exception_macro.hpp"
 #include "file_helper.hpp"
+#include "git_multi_repository_manager.hpp"
 #include "git_service.hpp"
 #include "i_vpg_generation_manager.hpp"
 #include "json.hpp"
 #include "json_builder.hpp"
+#include "log_binary_codec.hpp"
+#include "log_json_line_codec.hpp"
 #include "string_helper.hpp"
 #include "vector_helper.hpp"
 #include "vpg_global.hpp"
@@ -67,8 +70,8 @@ void VPGProcessManager::verifyLocalResponse()
                         CATCH_SLIENT
                         // If version is main and current tag version not exists, then no switch
                         std::wstring mainBranch = L"main";
-                        std::vector<std::wstring> allTags = vcc::GitService::getTags(this->getLogConfig().get(), localResponseDirectoryProject);
-                        if (currentBranchName == L"main" && !vcc::isContain(allTags, VPGGlobal::getVersion())) {
+                        // Tags are read from refs without git process
+                        if (currentBranchName == L"main" && !vcc::isContain(vcc::GitService::getTags(this->getLogConfig().get(), localResponseDirectoryProject), VPGGlobal::getVersion())) {
                             vcc::LogService::logInfo(this->getLogConfig().get(), L"", L"Currently in main branch and " + VPGGlobal::getVersion() + L" is not found. Keep in main branch.");
                         } else {
                             isNeedToCloneGitResponse = true;
@@ -103,9 +106,20 @@ void VPGProcessManager::verifyLocalResponse()
             try
             {            
                 vcc::LogService::logInfo(this->getLogConfig().get(), L"", L"Clone from " + gitUrl);
+                // progress line is redrawn many times per second, only log completed phase
+                auto onProgress = [this](const vcc::GitProgress *progress) {
+                    if (progress->getIsDone())
+                        vcc::LogService::logInfo(this->getLogConfig().get(), L"", progress->getPhase() + L": " + std::to_wstring(progress->getCurrent()) + L", done.");
+                };
+                // Only commit of current version is needed, history and other branches are not downloaded
+                // Files of template are all read by generation, so blobs are not filtered
                 vcc::GitCloneOption cloneOption;
-                cloneOption.setIsQuiet(true);
-                vcc::GitService::cloneGitResponse(this->getLogConfig().get(), localResponseDirectoryBase, gitUrl, &cloneOption);
+                cloneOption.setDirectory(VPGGlobal::getProjectName(_Option->getProjectType()));
+                cloneOption.setDepth(1);
+                // Clone default branch if tag of version not exists, then switch to main below
+                if (isUpdateAvaliable() && vcc::GitService::isRemoteTagExists(this->getLogConfig().get(), localResponseDirectoryBase, gitUrl, VPGGlobal::getVersion()))
+                    cloneOption.setBranch(VPGGlobal::getVersion());
+                vcc::GitService::cloneGitResponse(this->getLogConfig().get(), localResponseDirectoryBase, gitUrl, &cloneOption, nullptr, onProgress);
                 vcc::LogService::logInfo(this->getLogConfig().get(), L"", L"Done.");
             }
             catch(const std::exception& e)
@@ -136,6 +150,26 @@ void VPGProcessManager::verifyLocalResponse()
     CATCH
 }
 
+void VPGProcessManager::pullLocalResponses()
+{
+    TRY
+        std::wstring localResponseDirectoryBase = VPGGlobal::getConvertedPath(VPGGlobal::getVccLocalResponseFolder());
+        vcc::GitMultiRepositoryManager gitMultiRepositoryManager(this->getLogConfig());
+        gitMultiRepositoryManager.addWorkspaces(localResponseDirectoryBase);
+        vcc::LogService::logInfo(this->getLogConfig().get(), L"", L"Pull " + std::to_wstring(gitMultiRepositoryManager.getWorkspaces().size()) + L" repositories in " + localResponseDirectoryBase);
+        auto results = gitMultiRepositoryManager.Pull(nullptr, [this](const vcc::GitRepositoryProgress *progress) {
+            std::wstring message = L"[" + std::to_wstring(progress->getCompletedCount()) + L"/" + std::to_wstring(progress->getTotalCount()) + L"] " + progress->getResult()->getWorkspace();
+            if (progress->getResult()->getIsSuccess())
+                vcc::LogService::logInfo(this->getLogConfig().get(), L"", message + L" Done.");
+            else
+                vcc::LogService::LogWarning(this->getLogConfig().get(), L"", message + L" " + progress->getResult()->getError());
+        });
+        std::wstring errorMessage = vcc::GitMultiRepositoryManager::getErrorMessage(results);
+        if (!errorMessage.empty())
+            THROW_EXCEPTION_MSG(ExceptionType::CustomError, errorMessage);
+    CATCH
+}
+
 bool VPGProcessManager::isUpdateAvaliable()
 {
     switch (_Option->getProjectType())
@@ -211,6 +245,22 @@ void VPGProcessManager::execute(const std::vector<std::wstring> &cmds)
         if (mode == L"-Version") {
             std::wcout << VPGGlobal::getVersion() << std::endl;
             return;        
+        } else if (mode == L"-DecodeLog") {
+            if (cmds.size() < 3)
+                THROW_EXCEPTION_MSG(ExceptionType::CustomError, L"Argument missing for " + mode);
+            std::vector<vcc::LogRecord> records;
+            vcc::LogBinaryCodec::decodeFile(cmds[2], records);
+            std::string line;
+            for (auto const &record : records) {
+                line.clear();
+                vcc::LogJsonLineCodec::encode(record, line);
+                std::wcout << vcc::str2wstr(line) << L"\n";
+            }
+            std::wcout.flush();
+            return;
+        } else if (mode == L"-PullAll") {
+            this->pullLocalResponses();
+            return;
         }
 
         // ensure no nullptr
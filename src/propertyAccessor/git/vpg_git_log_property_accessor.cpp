@@ -98,10 +98,21 @@ long VPGGitLogPropertyAccessor::_readLong(const int64_t &objectProperty) const
     return 0L;
 }
 
-long VPGGitLogPropertyAccessor::_readLongAtIndex(const int64_t &objectProperty, const int64_t &/*index*/) const
+long VPGGitLogPropertyAccessor::_readLongAtIndex(const int64_t &objectProperty, const int64_t &index) const
 {
     TRY
-        THROW_EXCEPTION_MSG_FOR_BASE_PROPERTY_ACCESSOR_DETAIL_PROPERTY_NOT_FOUND
+        assert(index >= -1);
+        auto obj = std::static_pointer_cast<VPGGitLog>(_Object);
+        assert(obj != nullptr);
+        switch(static_cast<VPGGitLogProperty>(objectProperty))
+        {
+        case VPGGitLogProperty::GraphIncomingColumnIndexes:
+            return obj->getGraphIncomingColumnIndexesAtIndex(index);
+        case VPGGitLogProperty::GraphOutgoingColumnIndexes:
+            return obj->getGraphOutgoingColumnIndexesAtIndex(index);
+        default:
+            assert(false);
+        }
     CATCH
     return 0L;
 }
@@ -136,10 +147,29 @@ void VPGGitLogPropertyAccessor::_writeLong(const int64_t &objectProperty, const
     CATCH
 }
 
-void VPGGitLogPropertyAccessor::_writeLongAtIndex(const int64_t &objectProperty, const long &/*value*/, const int64_t &/*index*/)
+void VPGGitLogPropertyAccessor::_writeLongAtIndex(const int64_t &objectProperty, const long &value, const int64_t &index)
 {
     TRY
-        THROW_EXCEPTION_MSG_FOR_BASE_PROPERTY_ACCESSOR_DETAIL_PROPERTY_NOT_FOUND
+        assert(index >= -1);
+        auto obj = std::static_pointer_cast<VPGGitLog>(_Object);
+        assert(obj != nullptr);
+        switch(static_cast<VPGGitLogProperty>(objectProperty))
+        {
+        case VPGGitLogProperty::GraphIncomingColumnIndexes:
+            if (index > -1)
+                obj->setGraphIncomingColumnIndexesAtIndex(index, value);
+            else
+                obj->insertGraphIncomingColumnIndexes(value);
+            break;
+        case VPGGitLogProperty::GraphOutgoingColumnIndexes:
+            if (index > -1)
+                obj->setGraphOutgoingColumnIndexesAtIndex(index, value);
+            else
+                obj->insertGraphOutgoingColumnIndexes(value);
+            break;
+        default:
+            assert(false);
+        }
     CATCH
 }
 
@@ -150,10 +180,29 @@ void VPGGitLogPropertyAccessor::_writeLongAtKey(const int64_t &objectProperty, c
     CATCH
 }
 
-void VPGGitLogPropertyAccessor::_insertLongAtIndex(const int64_t &objectProperty, const long &/*value*/, const int64_t &/*index*/)
+void VPGGitLogPropertyAccessor::_insertLongAtIndex(const int64_t &objectProperty, const long &value, const int64_t &index)
 {
     TRY
-        THROW_EXCEPTION_MSG_FOR_BASE_PROPERTY_ACCESSOR_DETAIL_PROPERTY_NOT_FOUND
+        assert(index >= -1);
+        auto obj = std::static_pointer_cast<VPGGitLog>(_Object);
+        assert(obj != nullptr);
+        switch(static_cast<VPGGitLogProperty>(objectProperty))
+        {
+        case VPGGitLogProperty::GraphIncomingColumnIndexes:
+            if (index > -1)
+                obj->insertGraphIncomingColumnIndexesAtIndex(index, value);
+            else
+                obj->insertGraphIncomingColumnIndexes(value);
+            break;
+        case VPGGitLogProperty::GraphOutgoingColumnIndexes:
+            if (index > -1)
+                obj->insertGraphOutgoingColumnIndexesAtIndex(index, value);
+            else
+                obj->insertGraphOutgoingColumnIndexes(value);
+            break;
+        default:
+            assert(false);
+        }
     CATCH
 }
 
@@ -378,6 +427,10 @@ size_t VPGGitLogPropertyAccessor::_getCount(const int64_t &objectProperty) const
             return obj->getBranches().size();
         case VPGGitLogProperty::Tags:
             return obj->getTags().size();
+        case VPGGitLogProperty::GraphIncomingColumnIndexes:
+            return obj->getGraphIncomingColumnIndexes().size();
+        case VPGGitLogProperty::GraphOutgoingColumnIndexes:
+            return obj->getGraphOutgoingColumnIndexes().size();
         default:
             assert(false);
         }
@@ -434,6 +487,18 @@ void VPGGitLogPropertyAccessor::_remove(const int64_t &objectProperty, const voi
             obj->removeTags(valuePtr);
             break;
         }
+        case VPGGitLogProperty::GraphIncomingColumnIndexes: {
+            auto valuePtr = static_cast<const long *>(value);
+            assert(valuePtr != nullptr);
+            obj->removeGraphIncomingColumnIndexes(*valuePtr);
+            break;
+        }
+        case VPGGitLogProperty::GraphOutgoingColumnIndexes: {
+            auto valuePtr = static_cast<const long *>(value);
+            assert(valuePtr != nullptr);
+            obj->removeGraphOutgoingColumnIndexes(*valuePtr);
+            break;
+        }
         default:
             assert(false);
         }
@@ -467,6 +532,12 @@ void VPGGitLogPropertyAccessor::_removeAtIndex(const int64_t &objectProperty, co
         case VPGGitLogProperty::Tags:
             obj->removeTagsAtIndex(index);
             break;
+        case VPGGitLogProperty::GraphIncomingColumnIndexes:
+            obj->removeGraphIncomingColumnIndexesAtIndex(index);
+            break;
+        case VPGGitLogProperty::GraphOutgoingColumnIndexes:
+            obj->removeGraphOutgoingColumnIndexesAtIndex(index);
+            break;
         default:
             assert(false);
         }
@@ -499,6 +570,12 @@ void VPGGitLogPropertyAccessor::_clear(const int64_t &objectProperty)
         case VPGGitLogProperty::Tags:
             obj->clearTags();
             break;
+        case VPGGitLogProperty::GraphIncomingColumnIndexes:
+            obj->clearGraphIncomingColumnIndexes();
+            break;
+        case VPGGitLogProperty::GraphOutgoingColumnIndexes:
+            obj->clearGraphOutgoingColumnIndexes();
+            break;
         default:
             assert(false);
         }
@@ -7,6 +7,7 @@
 #include "exception_macro.hpp"
 #include "file_helper.hpp"
 #include "log_config.hpp"
+#include "log_macro.hpp"
 #include "log_service.hpp"
 #include "set_helper.hpp"
 #include "string_helper.hpp"
@@ -135,7 +136,7 @@ void VPGActionFileGenerationService::GenerateHpp(const vcc::LogConfig *logConfig
                     
                 // Generate File
                 std::wstring filePathHpp = vcc::concatPaths({folderPathHpp, getActionFileNameWithoutExtension(actionClassName, projectPrefix) + L".hpp"});
-                vcc::LogService::logInfo(logConfig, LOG_ID, L"Generate action class file: " + filePathHpp);
+                VCC_LOG_INFO(logConfig, LOG_ID, L"Generate action class file: {}", filePathHpp);
                 if (vcc::isFilePresent(filePathHpp))
                     content = VPGFileSyncService::SyncFileContent(VPGFileContentSyncTagMode::Generation, content, vcc::readFile(filePathHpp), VPGFileContentSyncMode::Full, L"//");
                 vcc::lTrim(content);
@@ -321,7 +322,7 @@ void VPGActionFileGenerationService::GenerateCpp(const vcc::LogConfig *logConfig
                     
                 // Generate File
                 std::wstring filePathCpp = vcc::concatPaths({folderPathCpp, getActionFileNameWithoutExtension(actionClassName, projectPrefix) + L".cpp"});
-                vcc::LogService::logInfo(logConfig, LOG_ID, L"Generate action class file: " + filePathCpp);
+                VCC_LOG_INFO(logConfig, LOG_ID, L"Generate action class file: {}", filePathCpp);
                 if (vcc::isFilePresent(filePathCpp))
                     content = VPGFileSyncService::SyncFileContent(VPGFileContentSyncTagMode::Generation, content, vcc::readFile(filePathCpp), VPGFileContentSyncMode::Full, L"//");
                 vcc::lTrim(content);
@@ -5,6 +5,7 @@
 
 #include "exception_macro.hpp"
 #include "file_helper.hpp"
+#include "log_macro.hpp"
 #include "log_service.hpp"
 #include "set_helper.hpp"
 
@@ -343,7 +344,7 @@ void VPGDllFileGenerationService::GenerateHpp(const vcc::LogConfig *logConfig, c
         if (!vcc::isFilePresent(filePathHpp))
             return;
         
-        vcc::LogService::logInfo(logConfig, LOG_ID, L"Modify DllFunctions.hpp file: " + filePathHpp);
+        VCC_LOG_INFO(logConfig, LOG_ID, L"Modify DllFunctions.hpp file: {}", filePathHpp);
 
         // header
         std::wstring content = L"";
@@ -372,7 +373,7 @@ void VPGDllFileGenerationService::GenerateCpp(const vcc::LogConfig *logConfig, c
         if (!vcc::isFilePresent(filePathCpp))
             return;
 
-        vcc::LogService::logInfo(logConfig, LOG_ID, L"Modify DllFunctions.cpp file: " + filePathCpp);
+        VCC_LOG_INFO(logConfig, LOG_ID, L"Modify DllFunctions.cpp file: {}", filePathCpp);
         // header
         std::wstring content = L"";
         std::set<std::wstring> customIncludeFiles;
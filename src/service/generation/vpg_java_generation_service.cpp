@@ -7,6 +7,7 @@
 #include "exception_macro.hpp"
 #include "file_helper.hpp"
 #include "log_config.hpp"
+#include "log_macro.hpp"
 
 #include "vpg_class_helper.hpp"
 #include "vpg_file_generation_manager.hpp"
@@ -410,7 +411,7 @@ void VPGJavaGenerationService::GenerateJavaBridge(const vcc::LogConfig *logConfi
         std::wstring javaFileName = filePrefix + JAVA_BRIDGE_FILE_NAME;
         std::wstring workspace = vcc::isAbsolutePath(javaOption->getWorkspace()) ? javaOption->getWorkspace() : vcc::concatPaths({ targetWorkspace, javaOption->getWorkspace() });
         std::wstring filePath = vcc::concatPaths({ workspace, javaOption->getDllBridgeDirectory(), javaFileName });
-        vcc::LogService::logInfo(logConfig, LOG_ID, L"Generate Java Bridge: " + filePath);
+        VCC_LOG_INFO(logConfig, LOG_ID, L"Generate Java Bridge: {}", filePath);
         vcc::writeFile(filePath, VPGJavaGenerationService::GenerateJavaBridgeContent(vcc::readFile(dllInterfacehppFilePath), option), true);
         vcc::LogService::logInfo(logConfig, LOG_ID, L"Generate Java Bridge completed.");
     CATCH
@@ -1245,7 +1246,7 @@ void VPGJavaGenerationService::GenerateEnum(const vcc::LogConfig *logConfig, con
         std::wstring tmpFilePath = vcc::getParentPath(filePath);
         tmpFilePath = vcc::concatPaths({ tmpFilePath, vcc::getFileName(filePath) });
 
-        vcc::LogService::logInfo(logConfig, LOG_ID, L"Generate Java Enum: " + tmpFilePath);
+        VCC_LOG_INFO(logConfig, LOG_ID, L"Generate Java Enum: {}", tmpFilePath);
         vcc::writeFile(tmpFilePath, VPGJavaGenerationService::GenerateEnumContent(option->getProjectPrefix(), enumClass, cppMiddlePath, javaOption), true);
         vcc::LogService::logInfo(logConfig, LOG_ID, L"Generate Java Enum completed.");
     CATCH
@@ -1267,7 +1268,7 @@ void VPGJavaGenerationService::GenerateObject(const vcc::LogConfig *logConfig, c
         std::wstring objectName = getTypeOrClassWithoutNamespace(enumClass->getName());
         if (!vcc::isEndWith(objectName, propertyClassNameSuffix))
             return;
-        vcc::LogService::logInfo(logConfig, LOG_ID, L"Generate Java Class: " + tmpFilePath);
+        VCC_LOG_INFO(logConfig, LOG_ID, L"Generate Java Class: {}", tmpFilePath);
         vcc::writeFile(tmpFilePath, VPGJavaGenerationService::GenerateObjectContent(option->getProjectPrefix(), enumClass, cppMiddlePath, getImportFileMap(option->getProjectPrefix(), javaOption, typeWorkspaceClassRelativePathMapObject, typeWorkspaceClassRelativePathMapForm), javaOption), true);
         vcc::LogService::logInfo(logConfig, LOG_ID, L"Generate Java Class completed.");
     CATCH
@@ -1280,7 +1281,7 @@ void VPGJavaGenerationService::GenerateOperationResult(const vcc::LogConfig *log
         if (option == nullptr || option->getInterface() != VPGConfigInterfaceType::Java || vcc::isBlank(option->getObjectDirectory()))
             return;
         std::wstring filePath = vcc::concatPaths({option->getWorkspace(), getOperationResultFilePath(projectPrefix, option)});
-        vcc::LogService::logInfo(logConfig, LOG_ID, L"Generate Java Class: " + filePath);
+        VCC_LOG_INFO(logConfig, LOG_ID, L"Generate Java Class: {}", filePath);
         vcc::writeFile(filePath, GenerateOperationResultContent(projectPrefix, option, getImportFileMap(projectPrefix, option, typeWorkspaceClassRelativePathMapObject, typeWorkspaceClassRelativePathMapForm)), true);
         vcc::LogService::logInfo(logConfig, LOG_ID, L"Generate Java Class completed.");
         return;
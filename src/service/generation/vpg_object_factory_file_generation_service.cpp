@@ -5,6 +5,7 @@
 
 #include "exception_macro.hpp"
 #include "file_helper.hpp"
+#include "log_macro.hpp"
 #include "log_service.hpp"
 #include "set_helper.hpp"
 
@@ -13,7 +14,7 @@
 void VPGObjectFactoryFileGenerationService::GenerateHpp(const vcc::LogConfig *logConfig, const std::wstring &filePathHpp)
 {
     TRY
-        vcc::LogService::logInfo(logConfig, LOG_ID, L"Generate object factory file: " + filePathHpp);
+        VCC_LOG_INFO(logConfig, LOG_ID, L"Generate object factory file: {}", filePathHpp);
         std::wstring content = L""
             "#pragma once\r\n"
             "\r\n"
@@ -41,7 +42,7 @@ void VPGObjectFactoryFileGenerationService::GenerateCpp(const vcc::LogConfig *lo
     const std::wstring &filePathCpp, const std::set<std::wstring> &propertyTypes)
 {
     TRY
-        vcc::LogService::logInfo(logConfig, LOG_ID, L"Generate object factory file: " + filePathCpp);
+        VCC_LOG_INFO(logConfig, LOG_ID, L"Generate object factory file: {}", filePathCpp);
 
         std::set<std::wstring> tmpIncludePaths = includeFiles;
         tmpIncludePaths.insert(L"exception_macro.hpp");
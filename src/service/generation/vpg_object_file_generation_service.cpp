@@ -5,6 +5,7 @@
 
 #include "exception_macro.hpp"
 #include "file_helper.hpp"
+#include "log_macro.hpp"
 #include "log_service.hpp"
 #include "set_helper.hpp"
 #include "string_helper.hpp"
@@ -786,7 +787,7 @@ void VPGObjectFileGenerationService::GenerateHpp(const vcc::LogConfig *logConfig
         
         std::wstring classPrefix = option->getProjectPrefix();
         std::wstring filePathHpp = isContainForm && !formFilePathHpp.empty() ? formFilePathHpp : objectFilePathHpp;
-        vcc::LogService::logInfo(logConfig, LOG_ID, L"Generate object class file: " + filePathHpp);
+        VCC_LOG_INFO(logConfig, LOG_ID, L"Generate object class file: {}", filePathHpp);
 
         // ------------------------------------------------------------------------------------------ //
         //                               Action  Files                                                //
@@ -1357,7 +1358,7 @@ void VPGObjectFileGenerationService::GenerateCpp(const vcc::LogConfig *logConfig
         std::wstring includeFileName = vcc::getFileName(filePathCpp);
         vcc::replace(includeFileName, L".cpp", L".hpp");
 
-        vcc::LogService::logInfo(logConfig, LOG_ID, L"Generate object class file: " + filePathCpp);
+        VCC_LOG_INFO(logConfig, LOG_ID, L"Generate object class file: {}", filePathCpp);
         
         // ------------------------------------------------------------------------------------------ //
         //                               include Files                                                //
@@ -2,6 +2,7 @@
 
 #include "exception_macro.hpp"
 #include "file_helper.hpp"
+#include "log_macro.hpp"
 #include "log_service.hpp"
 #include "set_helper.hpp"
 #include "xml.hpp"
@@ -14,7 +15,7 @@
 void VPGObjectTypeFileGenerationService::generate(const vcc::LogConfig *logConfig, const std::wstring &filePathHpp, const std::set<std::wstring> &propertyTypes)
 {
     TRY
-        vcc::LogService::logInfo(logConfig, LOG_ID, L"Generate object type file: " + filePathHpp);
+        VCC_LOG_INFO(logConfig, LOG_ID, L"Generate object type file: {}", filePathHpp);
 
         std::wstring customContent = L"";
         if (vcc::isFilePresent(filePathHpp)) {
@@ -5,6 +5,7 @@
 
 #include "exception_macro.hpp"
 #include "file_helper.hpp"
+#include "log_macro.hpp"
 #include "log_service.hpp"
 #include "set_helper.hpp"
 
@@ -13,7 +14,7 @@
 void VPGPropertyAccessorFactoryFileGenerationService::GenerateHpp(const vcc::LogConfig *logConfig, const std::wstring &filePathHpp)
 {
     TRY
-        vcc::LogService::logInfo(logConfig, LOG_ID, L"Generate property accessor factory file: " + filePathHpp);
+        VCC_LOG_INFO(logConfig, LOG_ID, L"Generate property accessor factory file: {}", filePathHpp);
         std::wstring content = L""
             "#pragma once\r\n"
             "\r\n"
@@ -41,7 +42,7 @@ void VPGPropertyAccessorFactoryFileGenerationService::GenerateCpp(const vcc::Log
     const std::wstring &filePathCpp, const std::set<std::wstring> &propertyTypes)
 {
     TRY
-        vcc::LogService::logInfo(logConfig, LOG_ID, L"Generate property accessor factory file: " + filePathCpp);
+        VCC_LOG_INFO(logConfig, LOG_ID, L"Generate property accessor factory file: {}", filePathCpp);
 
         std::set<std::wstring> tmpIncludePaths = includeFiles;
         tmpIncludePaths.insert(L"base_property_accessor.hpp");
@@ -4,6 +4,7 @@
 
 #include "exception_macro.hpp"
 #include "file_helper.hpp"
+#include "log_macro.hpp"
 #include "vpg_class_helper.hpp"
 #include "vpg_cpp_helper.hpp"
 
@@ -195,7 +196,7 @@ void VPGPropertyAccessorGenerationService::GenerateHpp(const vcc::LogConfig *log
     const std::wstring &filePathHpp, const std::vector<std::shared_ptr<VPGEnumClass>> &enumClassList)
 {
     TRY
-        vcc::LogService::logInfo(logConfig, LOG_ID, L"Generate property accessor hpp file: " + filePathHpp);
+        VCC_LOG_INFO(logConfig, LOG_ID, L"Generate property accessor hpp file: {}", filePathHpp);
 
         std::wstring result = L"#pragma once\r\n\r\n";
 
@@ -230,7 +231,7 @@ void VPGPropertyAccessorGenerationService::GenerateHpp(const vcc::LogConfig *log
 
                 // property accessor not support set
                 if (property->getIsSet()) {
-                    vcc::LogService::LogWarning(logConfig, L"Property Accessor Generation Service", L"Property Accessor not support SET: class " + enumClass->getName() + L": " + property->getMacro());
+                    VCC_LOG_WARNING(logConfig, L"Property Accessor Generation Service", L"Property Accessor not support SET: class {}: {}", enumClass->getName(), property->getMacro());
                     continue;
                 }
                 
@@ -945,7 +946,7 @@ void VPGPropertyAccessorGenerationService::GenerateCpp(const vcc::LogConfig *log
     const std::wstring &filePathCpp, const std::vector<std::shared_ptr<VPGEnumClass>> &enumClassList)
 {
     TRY
-        vcc::LogService::logInfo(logConfig, LOG_ID, L"Generate property accessor cpp file: " + filePathCpp);
+        VCC_LOG_INFO(logConfig, LOG_ID, L"Generate property accessor cpp file: {}", filePathCpp);
 
         std::set<std::wstring> systemIncludeFiles;
         std::set<std::wstring> projectIncludeFiles;
@@ -9,6 +9,7 @@
 #include "exception_type.hpp"
 #include "file_helper.hpp"
 #include "log_config.hpp"
+#include "log_macro.hpp"
 #include "xml_builder.hpp"
 
 #include "vpg_code_reader.hpp"
@@ -124,10 +125,10 @@ void VPGFileSyncService::copyFile(const vcc::LogConfig *logConfig, const VPGFile
             std::wstring commandDelimiter = vcc::getFileName(sourcePath) == L"Makefile" ? L"#" : L"//";
             std::wstring fileContent = VPGFileSyncService::SyncFileContent(mode, vcc::readFile(sourcePath), vcc::readFile(originalCodePath), VPGFileContentSyncMode::Demand, commandDelimiter);
             vcc::writeFile(originalCodePath, fileContent, true);
-            vcc::LogService::logInfo(logConfig, L"", L"Updated File: " + originalCodePath);
+            VCC_LOG_INFO(logConfig, L"", L"Updated File: {}", originalCodePath);
         } else {
             std::filesystem::copy_file(PATH(sourcePath), PATH(originalCodePath), std::filesystem::copy_options::overwrite_existing);
-            vcc::LogService::logInfo(logConfig, L"", L"Added File: " + originalCodePath);
+            VCC_LOG_INFO(logConfig, L"", L"Added File: {}", originalCodePath);
         }
     CATCH
 }
@@ -26,6 +26,17 @@ TEST(StringHelperTest, isStartWithTrimSpace_Space)
 /*                                      Conversion                                                      */
 /* ---------------------------------------------------------------------------------------------------- */
 
+TEST(StringHelperTest, str2wstr_wstr2str)
+{
+    std::wstring wstr = L"a\u00e9\u4e2d\U0001F600";
+    std::string str = "a\xC3\xA9\xE4\xB8\xAD\xF0\x9F\x98\x80";
+    EXPECT_EQ(vcc::wstr2str(wstr), str);
+    EXPECT_EQ(vcc::str2wstr(str), wstr);
+    // byte which is not UTF-8 is kept
+    EXPECT_EQ(vcc::str2wstr("a\xE9" "b"), L"a\u00e9b");
+    EXPECT_EQ(vcc::str2wstr(std::string("a\0b", 3)), std::wstring(L"a\0b", 3));
+}
+
 TEST(StringHelperTest, convertNamingStyle)
 {
     std::wstring str = L"PascalCase";
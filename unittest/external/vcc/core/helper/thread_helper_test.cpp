@@ -0,0 +1,39 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "thread_helper.hpp"
+
+TEST(ThreadHelperTest, executeParallel)
+{
+    std::vector<int> results(100, 0);
+    vcc::executeParallel(results.size(), 4, [&results](const size_t &index) {
+        results[index] = (int)index;
+    });
+    for (size_t i = 0; i < results.size(); i++)
+        EXPECT_EQ(results[i], (int)i);
+
+    // parallelism <= 0 means current thread only
+    std::atomic<size_t> count = 0;
+    vcc::executeParallel(10, 0, [&count](const size_t &) { count++; });
+    EXPECT_EQ(count.load(), (size_t)10);
+    vcc::executeParallel(0, 4, [&count](const size_t &) { count++; });
+    EXPECT_EQ(count.load(), (size_t)10);
+}
+
+TEST(ThreadHelperTest, executeParallel_Exception)
+{
+    // exception of any type is rethrown after all threads are joined
+    std::atomic<size_t> count = 0;
+    EXPECT_THROW(vcc::executeParallel(100, 4, [&count](const size_t &index) {
+        count++;
+        if (index == 10)
+            throw 1;
+    }), int);
+    EXPECT_LT(count.load(), (size_t)100);
+    EXPECT_THROW(vcc::executeParallel(10, 4, [](const size_t &) {
+        throw std::runtime_error("error");
+    }), std::runtime_error);
+}
@@ -0,0 +1,33 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+
+#include "time_helper.hpp"
+
+TEST(TimeHelperTest, DatetimeString)
+{
+    auto time = std::chrono::system_clock::now();
+    std::wstring datetimeStr = vcc::getDatetimeString(std::chrono::system_clock::to_time_t(time));
+    EXPECT_EQ(vcc::getDatetimeString(time, vcc::TimePrecision::Second), datetimeStr);
+
+    std::wstring millisecondStr = vcc::getDatetimeString(time, vcc::TimePrecision::Millisecond);
+    EXPECT_EQ(millisecondStr.length(), datetimeStr.length() + 4);
+    EXPECT_EQ(millisecondStr.substr(0, datetimeStr.length() + 1), datetimeStr + L".");
+
+    std::wstring microsecondStr = vcc::getDatetimeString(time, vcc::TimePrecision::Microsecond);
+    EXPECT_EQ(microsecondStr.length(), datetimeStr.length() + 7);
+    EXPECT_EQ(microsecondStr.substr(0, millisecondStr.length()), millisecondStr);
+
+    // cached second is replaced when second changes
+    auto nextTime = time + std::chrono::seconds(1);
+    EXPECT_EQ(vcc::getDatetimeString(nextTime, vcc::TimePrecision::Second), vcc::getDatetimeString(std::chrono::system_clock::to_time_t(nextTime)));
+}
+
+TEST(TimeHelperTest, MonotonicTime)
+{
+    int64_t start = vcc::getMonotonicTime();
+    vcc::Sleep(2);
+    EXPECT_GE(vcc::getMonotonicTime() - start, 2000);
+    EXPECT_GE(vcc::getMonotonicTime(vcc::TimePrecision::Millisecond) * 1000, start - 1000);
+}
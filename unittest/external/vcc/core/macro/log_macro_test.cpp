@@ -0,0 +1,35 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+#include "log_config.hpp"
+#include "log_macro.hpp"
+
+TEST(LogMacroTest, FormatLogMessage)
+{
+    EXPECT_EQ(vcc::formatLogMessage(L"message"), L"message");
+    EXPECT_EQ(vcc::formatLogMessage(L"{} {} {} {} {}", std::wstring(L"a"), L"b", std::string("c"), 1, true), L"a b c 1 true");
+    EXPECT_EQ(vcc::formatLogMessage(L"{{}} {}", L'x'), L"{} x");
+    EXPECT_EQ(vcc::formatLogMessage(L"{} {}", 1), L"1 {}");
+    EXPECT_EQ(vcc::formatLogMessage(L"{}", 1, 2), L"1");
+}
+
+TEST(LogMacroTest, Lazy)
+{
+    size_t evaluatedCount = 0;
+    auto getArgument = [&evaluatedCount]() {
+        evaluatedCount++;
+        return std::wstring(L"argument");
+    };
+
+    VCC_LOG_DEBUG(nullptr, L"id", L"message {}", getArgument());
+    EXPECT_EQ(evaluatedCount, (size_t)0);
+
+    auto logConfig = std::make_shared<vcc::LogConfig>(vcc::LogConfigInitialType::None);
+    VCC_LOG_DEBUG(logConfig.get(), L"id", L"message {}", getArgument());
+    VCC_LOG_INFO(logConfig.get(), L"id", L"message {}", getArgument());
+    EXPECT_EQ(evaluatedCount, (size_t)0);
+
+    EXPECT_EQ(vcc::LogService::LogDebug(nullptr, L"id", L"message"), L"");
+}
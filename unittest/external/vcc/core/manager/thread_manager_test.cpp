@@ -1,5 +1,13 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "json_builder.hpp"
 #include "thread.hpp"
 #include "thread_manager.hpp"
 
@@ -103,3 +111,141 @@ TEST_F(ThreadManagerTest, ClearWaitingThread)
     EXPECT_TRUE(getManager()->getThreads().empty());
     EXPECT_TRUE(getManager()->getActiveThreads().empty());
 }
+
+TEST_F(ThreadManagerTest, StopCancelRunningThread) 
+{
+    getManager()->setThreadManagementMode(vcc::ThreadManagementMode::Detach);
+    getManager()->setTerminateMode(vcc::ThreadManagerTerminateMode::Wait);
+    std::atomic<bool> isStarted = false;
+    std::atomic<bool> isCancelled = false;
+    auto thread1 = std::make_shared<vcc::Thread>(getLogConfig(), [&isStarted, &isCancelled](const vcc::Thread *thread){
+        isStarted = true;
+        while (!thread->isCancelled())
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        isCancelled = true;
+    });
+    getManager()->queue(thread1);
+    while (!isStarted)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    getManager()->stop();
+    EXPECT_TRUE(isCancelled);
+    EXPECT_FALSE(thread1->isExecuting());
+    EXPECT_TRUE(getManager()->getActiveThreads().empty());
+}
+
+TEST_F(ThreadManagerTest, DestroyWaitThreadRelease) 
+{
+    // Immediately mode returns from stop() at once, destructor still waits for thread using manager
+    auto manager = std::make_shared<vcc::ThreadManager>(nullptr);
+    manager->setTerminateMode(vcc::ThreadManagerTerminateMode::Immediately);
+    manager->setMaxThreadPoolSize(1);
+    std::atomic<bool> isStarted = false;
+    std::atomic<int64_t> callbackCount = 0;
+    auto createThread = [this, &isStarted, &callbackCount]() {
+        return std::make_shared<vcc::Thread>(getLogConfig(), [&isStarted](const vcc::Thread *thread){
+            isStarted = true;
+            while (!thread->isCancelled())
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }, [&callbackCount](const vcc::Thread * /*thread*/) {
+            callbackCount++;
+        });
+    };
+    auto thread1 = createThread();
+    manager->queue(thread1);
+    while (!isStarted)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    manager->stop();
+    EXPECT_TRUE(thread1->isCancelled());
+    EXPECT_EQ(callbackCount, 0);
+    manager.reset();
+    EXPECT_EQ(callbackCount, 1);
+    EXPECT_FALSE(thread1->isExecuting());
+    EXPECT_EQ(thread1->getState(), vcc::ProcessState::Stop);
+}
+
+TEST_F(ThreadManagerTest, PriorityAndDeadline) 
+{
+    std::vector<std::wstring> result;
+    auto createThread = [this, &result](const std::wstring &id, const int64_t &priority, const int64_t &deadline) {
+        auto thread = std::make_shared<vcc::Thread>(getLogConfig(), [&result, id](const vcc::Thread * /*thread*/){
+            result.push_back(id);
+        });
+        thread->setPriority(priority);
+        thread->setDeadline(deadline);
+        return thread;
+    };
+    getManager()->setPriorityAgingInterval(1000);
+    getManager()->suspend();
+    getManager()->queue(createThread(L"Low", -5, -1));
+    getManager()->queue(createThread(L"LowWithDeadline", -5, 100));
+    getManager()->queue(createThread(L"Normal", 0, -1));
+    getManager()->queue(createThread(L"High", 5, -1));
+    getManager()->resume();
+
+    // Due time: LowWithDeadline 100, High 10000 - 5000, Normal 10000, Low 10000 + 5000
+    EXPECT_EQ(result, std::vector<std::wstring>({ L"LowWithDeadline", L"High", L"Normal", L"Low" }));
+
+    auto metrics = getManager()->getPriorityMetrics();
+    EXPECT_EQ(metrics.size(), (size_t)3);
+    EXPECT_EQ(metrics[-5]->getCompletedCount(), 2);
+    EXPECT_EQ(metrics[0]->getCompletedCount(), 1);
+    EXPECT_EQ(metrics[5]->getCompletedCount(), 1);
+    getManager()->resetMetrics();
+    EXPECT_TRUE(getManager()->getPriorityMetrics().empty());
+}
+
+TEST_F(ThreadManagerTest, Deadline) 
+{
+    std::vector<std::wstring> result;
+    auto createThread = [this, &result](const std::wstring &id, const int64_t &deadline) {
+        auto thread = std::make_shared<vcc::Thread>(getLogConfig(), [&result, id](const vcc::Thread * /*thread*/){
+            result.push_back(id);
+        });
+        thread->setDeadline(deadline);
+        return thread;
+    };
+    getManager()->setDefaultDeadline(10000);
+    getManager()->suspend();
+    getManager()->queue(createThread(L"First", -1));
+    getManager()->queue(createThread(L"Second", -1));
+    getManager()->queue(createThread(L"LateDeadline", 20000));
+    getManager()->queue(createThread(L"Deadline", 1000));
+    getManager()->queue(createThread(L"EarlyDeadline", 0));
+    EXPECT_EQ(getManager()->getThreads().size(), (size_t)5);
+    getManager()->resume();
+
+    EXPECT_EQ(result, std::vector<std::wstring>({ L"EarlyDeadline", L"Deadline", L"First", L"Second", L"LateDeadline" }));
+    EXPECT_TRUE(getManager()->getThreads().empty());
+}
+
+TEST_F(ThreadManagerTest, Metrics) 
+{
+    getManager()->suspend();
+    for (size_t i = 0; i < 3; i++)
+        getManager()->queue(std::make_shared<vcc::Thread>(getLogConfig(), [](const vcc::Thread * /*thread*/){}));
+    auto metrics = getManager()->getMetrics();
+    EXPECT_EQ(metrics->getQueuedCount(), 3);
+    EXPECT_EQ(metrics->getQueueDepth(), 3);
+    EXPECT_EQ(metrics->getStartedCount(), 0);
+
+    getManager()->resume();
+    metrics = getManager()->getMetrics();
+    EXPECT_EQ(metrics->getStartedCount(), 3);
+    EXPECT_EQ(metrics->getCompletedCount(), 3);
+    EXPECT_EQ(metrics->getFailedCount(), 0);
+    EXPECT_EQ(metrics->getQueueDepth(), 0);
+    EXPECT_EQ(metrics->getMaxQueueDepth(), 3);
+    EXPECT_EQ(metrics->getWaitLatency()->getCount(), 3);
+    EXPECT_EQ(metrics->getExecutionLatency()->getCount(), 3);
+    EXPECT_EQ(metrics->getPriorityMetrics().size(), (size_t)1);
+
+    auto jsonBuilder = std::make_unique<vcc::JsonBuilder>();
+    auto result = std::make_shared<vcc::ThreadManagerMetrics>();
+    result->deserializeJsonString(jsonBuilder.get(), metrics->serializeJson(jsonBuilder.get()));
+    EXPECT_EQ(result->getCompletedCount(), 3);
+    EXPECT_EQ(result->getExecutionLatency()->getCount(), 3);
+    EXPECT_EQ(result->getExecutionLatency()->getBucketCounts().size(), vcc::ThreadLatencyHistogram::getBucketUpperBounds().size() + 1);
+    EXPECT_EQ(result->getPriorityMetrics().size(), (size_t)1);
+    EXPECT_EQ(result->getPriorityMetrics().at(0)->getCompletedCount(), 3);
+}
@@ -1,11 +1,19 @@
 #include <gtest/gtest.h>
 
 #include <filesystem>
+#include <fstream>
+#include <iterator>
 #include <memory>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "file_helper.hpp"
+#include "log_binary_codec.hpp"
+#include "log_file_writer.hpp"
+#include "log_json_line_codec.hpp"
 #include "log_service.hpp"
+#include "string_helper.hpp"
 
 TEST(LogServiceTest, LogTest) 
 {
@@ -40,4 +48,160 @@ TEST(LogServiceTest, LogTest)
     EXPECT_EQ(logProcessResultStr, vcc::readFileOneLine(filePath, 6));
     EXPECT_EQ(logSQLStr, vcc::readFileOneLine(filePath, 7));
     EXPECT_EQ(logSQLResultStr, vcc::readFileOneLine(filePath, 8));
+    // same line ending on all platforms
+    EXPECT_EQ(vcc::readFile(filePath).find(L"\r"), std::wstring::npos);
+}
+
+TEST(LogServiceTest, AsyncLogTest) 
+{
+    std::wstring filePath = vcc::concatPaths({std::filesystem::current_path().wstring(), L"bin/Debug/AppLogs/LogServiceAsyncTest.log"});
+    vcc::removeFile(filePath);
+    
+    auto property = std::make_shared<vcc::LogConfig>(vcc::LogConfigInitialType::None);
+    property->setIsAsync(true);
+    property->setAsyncBatchSize(64);
+    property->setFilePath(filePath);
+    std::wstring firstStr = vcc::LogService::logInfo(property.get(), L"id", L"message");
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 4; i++) {
+        threads.push_back(std::thread([&property, i]() {
+            for (size_t j = 0; j < 500; j++)
+                vcc::LogService::logInfo(property.get(), L"id", L"thread " + std::to_wstring(i) + L" message " + std::to_wstring(j));
+        }));
+    }
+    for (auto &thread : threads)
+        thread.join();
+    vcc::LogService::flush();
+
+    EXPECT_EQ(firstStr, vcc::readFileOneLine(filePath, 0));
+    EXPECT_EQ(vcc::splitStringByLine(vcc::readFile(filePath)).size(), (size_t)2001);
+}
+
+TEST(LogServiceTest, AsyncFullBufferTest) 
+{
+    std::wstring filePath = vcc::concatPaths({std::filesystem::current_path().wstring(), L"bin/Debug/AppLogs/LogServiceAsyncFullBufferTest.log"});
+    vcc::removeFile(filePath);
+
+    // Writer only wakes up when producer finds buffer full
+    vcc::LogService::configureAsync(60000, 1000000);
+    auto property = std::make_shared<vcc::LogConfig>(vcc::LogConfigInitialType::None);
+    property->setIsAsync(true);
+    property->setFilePath(filePath);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 4; i++) {
+        threads.push_back(std::thread([&property, i]() {
+            for (size_t j = 0; j < 5000; j++)
+                vcc::LogService::logInfo(property.get(), L"id", L"thread " + std::to_wstring(i) + L" message " + std::to_wstring(j));
+        }));
+    }
+    for (auto &thread : threads)
+        thread.join();
+    vcc::LogService::flush();
+    vcc::LogService::configureAsync(100, 256);
+
+    EXPECT_EQ(vcc::splitStringByLine(vcc::readFile(filePath)).size(), (size_t)20000);
+}
+
+TEST(LogServiceTest, RotationTest) 
+{
+    for (bool isAsync : { false, true }) {
+        std::wstring filePath = vcc::concatPaths({std::filesystem::current_path().wstring(), L"bin/Debug/AppLogs/LogServiceRotationTest.log"});
+        for (int64_t i = 0; i <= 3; i++)
+            vcc::removeFile(vcc::LogFileWriter::getRotatedFilePath(filePath, i));
+
+        auto property = std::make_shared<vcc::LogConfig>(vcc::LogConfigInitialType::None);
+        property->setIsAsync(isAsync);
+        property->setFilePath(filePath);
+        property->setMaxFileSize(200);
+        property->setMaxRetainedFileCount(2);
+        std::wstring lastStr = L"";
+        for (size_t i = 0; i < 20; i++)
+            lastStr = vcc::LogService::logInfo(property.get(), L"id", L"message " + std::to_wstring(i));
+        vcc::LogService::flush();
+
+        EXPECT_TRUE(vcc::isFilePresent(filePath));
+        EXPECT_TRUE(vcc::isFilePresent(vcc::LogFileWriter::getRotatedFilePath(filePath, 1)));
+        EXPECT_TRUE(vcc::isFilePresent(vcc::LogFileWriter::getRotatedFilePath(filePath, 2)));
+        EXPECT_FALSE(vcc::isFilePresent(vcc::LogFileWriter::getRotatedFilePath(filePath, 3)));
+        EXPECT_LE(std::filesystem::file_size(filePath), (uintmax_t)200);
+        auto lines = vcc::splitStringByLine(vcc::readFile(filePath));
+        EXPECT_FALSE(lines.empty());
+        EXPECT_EQ(vcc::readFileOneLine(filePath, lines.size() - 1), lastStr);
+    }
+}
+
+TEST(LogServiceTest, BinaryTest) 
+{
+    std::wstring filePath = vcc::concatPaths({std::filesystem::current_path().wstring(), L"bin/Debug/AppLogs/LogServiceBinaryTest.log"});
+    vcc::removeFile(filePath);
+
+    auto property = std::make_shared<vcc::LogConfig>(vcc::LogConfigInitialType::None);
+    property->setUserID(L"user");
+    property->setFilePath(filePath);
+    property->setFileFormat(vcc::LogFileFormat::Binary);
+    vcc::LogService::logInfo(property.get(), L"id", L"message");
+    vcc::LogService::LogError(property.get(), L"id", L"error é \U0001F600");
+
+    std::ifstream fileStream(std::filesystem::path(filePath), std::ios_base::binary);
+    std::string data((std::istreambuf_iterator<char>(fileStream)), std::istreambuf_iterator<char>());
+    size_t pos = 0;
+    EXPECT_TRUE(vcc::LogBinaryCodec::decodeFileHeader(data, pos));
+    vcc::LogRecord record;
+    EXPECT_TRUE(vcc::LogBinaryCodec::decode(data, pos, record));
+    EXPECT_EQ(record.Type, vcc::LogType::Info);
+    EXPECT_EQ(record.Category, vcc::LogCategory::General);
+    EXPECT_FALSE(record.ThreadId.empty());
+    EXPECT_EQ(record.Id, L"id");
+    EXPECT_EQ(record.UserID, L"user");
+    EXPECT_EQ(record.Message, L"message");
+    EXPECT_GT(record.Timestamp, 0);
+    EXPECT_TRUE(vcc::LogBinaryCodec::decode(data, pos, record));
+    EXPECT_EQ(record.Type, vcc::LogType::Error);
+    EXPECT_EQ(record.Message, L"error é \U0001F600");
+    EXPECT_FALSE(vcc::LogBinaryCodec::decode(data, pos, record));
+    EXPECT_EQ(pos, data.length());
+}
+
+TEST(LogServiceTest, JsonLinesTest) 
+{
+    std::wstring filePath = vcc::concatPaths({std::filesystem::current_path().wstring(), L"bin/Debug/AppLogs/LogServiceJsonLinesTest.log"});
+    vcc::removeFile(filePath);
+
+    auto property = std::make_shared<vcc::LogConfig>(vcc::LogConfigInitialType::None);
+    property->setUserID(L"user");
+    property->setFilePath(filePath);
+    property->setFileFormat(vcc::LogFileFormat::JsonLines);
+    property->setIsLogProcess(true);
+    vcc::LogService::LogProcess(property.get(), L"id", L"line1\n\"quote\" é");
+
+    std::wstring line = vcc::readFileOneLine(filePath, 0);
+    EXPECT_TRUE(line.starts_with(L"{\"Type\":\"Info\",\"Timestamp\":"));
+    EXPECT_TRUE(line.find(L"\"ThreadId\":\"") != std::wstring::npos);
+    EXPECT_TRUE(line.ends_with(L"\"UserID\":\"user\",\"Category\":\"Process\",\"Id\":\"id\",\"Message\":\"line1\\n\\\"quote\\\" \\u00e9\"}"));
+    EXPECT_EQ(vcc::readFile(filePath).find(L"\r"), std::wstring::npos);
+}
+
+TEST(LogServiceTest, BinaryCategoryTest) 
+{
+    std::wstring filePath = vcc::concatPaths({std::filesystem::current_path().wstring(), L"bin/Debug/AppLogs/LogServiceBinaryCategoryTest.log"});
+    std::wstring binaryFilePath = filePath + L".bin";
+    vcc::removeFile(filePath);
+    vcc::removeFile(binaryFilePath);
+
+    auto property = std::make_shared<vcc::LogConfig>(vcc::LogConfigInitialType::None);
+    property->setFilePath(filePath);
+    property->setIsLogProcess(true);
+    property->setIsLogProcessResult(true);
+    property->insertBinaryCategories(vcc::LogCategory::ProcessResult);
+    vcc::LogService::LogProcess(property.get(), L"id", L"command");
+    vcc::LogService::LogProcessResult(property.get(), L"id", L"result");
+
+    EXPECT_TRUE(vcc::readFileOneLine(filePath, 0).ends_with(L"command"));
+    EXPECT_EQ(vcc::readFileOneLine(filePath, 1), L"");
+
+    std::vector<vcc::LogRecord> records;
+    vcc::LogBinaryCodec::decodeFile(binaryFilePath, records);
+    EXPECT_EQ(records.size(), (size_t)1);
+    EXPECT_EQ(records[0].Category, vcc::LogCategory::ProcessResult);
+    EXPECT_EQ(records[0].Message, L"result");
 }
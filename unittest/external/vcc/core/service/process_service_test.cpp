@@ -1,9 +1,18 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <chrono>
+#include <filesystem>
 #include <string>
+#include <thread>
 #include <vector>
 
+#ifndef _WIN32
+#include <signal.h>
+#endif
+
 #include "process_service.hpp"
+#include "process_session.hpp"
 #include "log_config.hpp"
 #include "string_helper.hpp"
 
@@ -17,6 +26,175 @@ TEST(ProcessServiceTest, NormalWithWorkspace)
     EXPECT_TRUE(vcc::ProcessService::execute(nullptr, L"", L"..", L"git --version").starts_with(L"git version"));
 }
 
+TEST(ProcessServiceTest, ConcurrentWorkspace)
+{
+    std::wstring currentDirectory = std::filesystem::current_path().wstring();
+    std::wstring parentDirectory = std::filesystem::current_path().parent_path().wstring();
+    std::wstring rootDirectory = std::filesystem::current_path().root_path().wstring();
+    std::vector<std::thread> threads;
+    std::vector<std::wstring> results(8);
+    for (size_t i = 0; i < results.size(); i++) {
+        threads.emplace_back([&results, i, &parentDirectory, &rootDirectory]() {
+            results[i] = vcc::ProcessService::execute(nullptr, L"", i % 2 == 0 ? parentDirectory : rootDirectory, L"pwd");
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+    for (size_t i = 0; i < results.size(); i++)
+        EXPECT_EQ(results[i], i % 2 == 0 ? parentDirectory : rootDirectory);
+    EXPECT_EQ(std::filesystem::current_path().wstring(), currentDirectory);
+}
+
+TEST(ProcessServiceTest, LargeOutput)
+{
+    // stderr larger than pipe buffer is written before stdout
+    EXPECT_EQ(vcc::ProcessService::execute(nullptr, L"", L"sh -c \"yes error | head -n 100000 >&2; echo done\""), L"done");
+    std::wstring result = vcc::ProcessService::execute(nullptr, L"", L"sh -c \"yes line | head -n 100000\"");
+    EXPECT_EQ(result.length(), (size_t)(100000 * 5 - 1));
+}
+
+TEST(ProcessServiceTest, Streaming)
+{
+    std::vector<std::wstring> lines;
+    vcc::ProcessService::executeStreaming(nullptr, L"", L"", L"sh -c \"printf 'a\\\\nb\\\\r\\\\n\\\\nc'\"", [&lines](const std::wstring &line) {
+        lines.push_back(line);
+    });
+    std::vector<std::wstring> expectedLines = { L"a", L"b", L"", L"c" };
+    EXPECT_EQ(lines, expectedLines);
+
+    // first line is delivered before process ends
+    auto startTime = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::duration firstLineTime;
+    vcc::ProcessService::executeStreaming(nullptr, L"", L"", L"sh -c \"echo first; sleep 1; echo second\"", [&](const std::wstring &line) {
+        if (line == L"first")
+            firstLineTime = std::chrono::steady_clock::now() - startTime;
+    });
+    EXPECT_LT(firstLineTime, std::chrono::milliseconds(900));
+
+    // exception from callback stops process
+    startTime = std::chrono::steady_clock::now();
+    EXPECT_THROW(vcc::ProcessService::executeStreaming(nullptr, L"", L"", L"sh -c \"echo first; sleep 10\"", [](const std::wstring &) {
+        throw std::runtime_error("stop");
+    }), std::exception);
+    EXPECT_LT(std::chrono::steady_clock::now() - startTime, std::chrono::seconds(5));
+}
+
+#ifndef _WIN32
+TEST(ProcessServiceTest, ErrorStreaming)
+{
+    // carriage return ends progress line, only lines ended by line feed are kept for error
+    std::vector<std::wstring> lines;
+    std::wstring output = vcc::ProcessService::executeErrorStreaming(nullptr, L"", L"", L"sh -c \"printf '10%%\\\\r50%%\\\\r100%%, done.\\\\n' >&2; echo output\"", [&lines](const std::wstring &line) {
+        lines.push_back(line);
+    });
+    EXPECT_EQ(output, L"output");
+    std::vector<std::wstring> expectedLines = { L"10%", L"50%", L"100%, done." };
+    EXPECT_EQ(lines, expectedLines);
+
+    lines.clear();
+    try {
+        vcc::ProcessService::executeErrorStreaming(nullptr, L"", L"", L"sh -c \"printf '10%%\\\\rfatal: error\\\\n' >&2; exit 1\"", [&lines](const std::wstring &line) {
+            lines.push_back(line);
+        });
+        FAIL();
+    } catch (std::exception &e) {
+        std::string message = e.what();
+        EXPECT_NE(message.find("fatal: error"), std::string::npos);
+        EXPECT_EQ(message.find("10%"), std::string::npos);
+    }
+    expectedLines = { L"10%", L"fatal: error" };
+    EXPECT_EQ(lines, expectedLines);
+}
+#endif
+
+TEST(ProcessServiceTest, Result)
+{
+    auto result = vcc::ProcessService::executeWithResult(nullptr, L"", L"", L"sh -c \"echo output; echo error >&2; exit 3\"");
+    EXPECT_FALSE(result->isSuccess());
+    EXPECT_EQ(result->getExitCode(), 3);
+    EXPECT_EQ(result->getSignal(), 0);
+    EXPECT_EQ(result->getOutput(), L"output");
+    EXPECT_EQ(result->getError(), L"error\n");
+
+    result = vcc::ProcessService::executeWithResult(nullptr, L"", L"", L"git --version");
+    EXPECT_TRUE(result->isSuccess());
+    EXPECT_TRUE(result->getOutput().starts_with(L"git version"));
+}
+
+#ifndef _WIN32
+TEST(ProcessServiceTest, Timeout)
+{
+    vcc::ProcessOption option;
+    option.setTimeout(200);
+    auto startTime = std::chrono::steady_clock::now();
+    auto result = vcc::ProcessService::executeWithResult(nullptr, L"", L"", L"sleep 10", &option);
+    EXPECT_LT(std::chrono::steady_clock::now() - startTime, std::chrono::seconds(5));
+    EXPECT_TRUE(result->getIsTimeout());
+    EXPECT_EQ(result->getSignal(), SIGTERM);
+    EXPECT_THROW(vcc::ProcessService::executeStreaming(nullptr, L"", L"", L"sleep 10", [](const std::wstring &) {}, nullptr, &option), std::exception);
+
+    // SIGTERM is ignored, SIGKILL after grace period
+    option.setKillGracePeriod(200);
+    startTime = std::chrono::steady_clock::now();
+    result = vcc::ProcessService::executeWithResult(nullptr, L"", L"", L"sh -c \"trap '' TERM; sleep 3\"", &option);
+    EXPECT_LT(std::chrono::steady_clock::now() - startTime, std::chrono::milliseconds(2500));
+    EXPECT_TRUE(result->getIsTimeout());
+    EXPECT_EQ(result->getSignal(), SIGKILL);
+}
+
+TEST(ProcessServiceTest, ResourceLimit)
+{
+    vcc::ProcessOption option;
+    option.setCpuTimeLimit(5);
+    option.setAddressSpaceLimit(1024 * 1024 * 1024);
+    EXPECT_EQ(vcc::ProcessService::executeWithResult(nullptr, L"", L"", L"sh -c \"ulimit -t\"", &option)->getOutput(), L"5");
+    EXPECT_EQ(vcc::ProcessService::executeWithResult(nullptr, L"", L"", L"sh -c \"ulimit -v\"", &option)->getOutput(), L"1048576");
+}
+#endif
+
+TEST(ProcessServiceTest, Batch)
+{
+    std::vector<std::wstring> commands;
+    for (size_t i = 0; i < 8; i++)
+        commands.push_back(L"sh -c \"sleep 0.2; echo " + std::to_wstring(i) + L"\"");
+    commands.push_back(L"sh -c \"exit 2\"");
+    commands.push_back(L"command_not_exists");
+
+    auto startTime = std::chrono::steady_clock::now();
+    auto results = vcc::ProcessService::executeBatch(nullptr, L"", L"", commands, 4);
+    EXPECT_LT(std::chrono::steady_clock::now() - startTime, std::chrono::milliseconds(1200));
+    EXPECT_EQ(results.size(), commands.size());
+    for (size_t i = 0; i < 8; i++) {
+        EXPECT_TRUE(results[i]->isSuccess());
+        EXPECT_EQ(results[i]->getOutput(), std::to_wstring(i));
+    }
+    EXPECT_EQ(results[8]->getExitCode(), 2);
+    EXPECT_FALSE(results[9]->isSuccess());
+    EXPECT_FALSE(results[9]->getError().empty());
+}
+
+#ifndef _WIN32
+TEST(ProcessServiceTest, Session)
+{
+    vcc::ProcessSession session(L"", L"cat");
+    EXPECT_TRUE(session.isRunning());
+    session.write("abc\n12345");
+    EXPECT_EQ(session.readLine(), "abc");
+    EXPECT_EQ(session.read(3), "123");
+    session.write("\n");
+    EXPECT_EQ(session.readLine(), "45");
+    session.close();
+    EXPECT_FALSE(session.isRunning());
+    EXPECT_THROW(session.write("abc\n"), std::exception);
+
+    // command must run in workspace or not at all
+    std::filesystem::path workspace = std::filesystem::temp_directory_path();
+    vcc::ProcessSession workspaceSession(workspace.wstring(), L"pwd");
+    EXPECT_TRUE(std::filesystem::equivalent(workspaceSession.readLine(), workspace));
+    EXPECT_THROW(vcc::ProcessSession(L"bin/Debug/ProcessSessionNotExists", L"pwd"), std::exception);
+}
+#endif
+
 TEST(ProcessServiceTest, ParseCMDToken)
 {
     std::vector<std::string> tokens = vcc::ProcessService::ParseCmdLinux("");
@@ -65,3 +243,61 @@ TEST(ProcessServiceTest, Exception)
     }
     EXPECT_TRUE(isError);
 }
+
+TEST(ProcessServiceTest, Cancel)
+{
+    vcc::CancellationToken cancellationToken;
+    std::thread cancelThread([&cancellationToken]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        cancellationToken.cancel();
+    });
+    auto startTime = std::chrono::steady_clock::now();
+    bool isError = false;
+    try {
+        vcc::ProcessService::execute(nullptr, L"", L"", L"sleep 10", &cancellationToken);
+    } catch (std::exception &e) {
+        isError = true;
+    }
+    cancelThread.join();
+    EXPECT_TRUE(isError);
+    EXPECT_LT(std::chrono::steady_clock::now() - startTime, std::chrono::seconds(5));
+}
+
+TEST(ProcessServiceTest, CancelWhileExit)
+{
+    // cancel races with child exit and waitpid, either output or cancelled
+    for (int i = 0; i < 50; i++) {
+        vcc::CancellationToken cancellationToken;
+        std::thread cancelThread([&cancellationToken, i]() {
+            std::this_thread::sleep_for(std::chrono::microseconds(i * 100));
+            cancellationToken.cancel();
+        });
+        try {
+            EXPECT_EQ(vcc::ProcessService::execute(nullptr, L"", L"", L"echo a", &cancellationToken), L"a");
+        } catch (std::exception &e) {
+            EXPECT_TRUE(cancellationToken.isCancelled());
+        }
+        cancelThread.join();
+    }
+}
+
+TEST(ProcessServiceTest, UnregisterWaitCancelCallback)
+{
+    // ProcessService reaps child after unregisterCallback, kill must not run afterward
+    vcc::CancellationToken cancellationToken;
+    std::atomic<bool> isCallbackStarted = false;
+    std::atomic<bool> isCallbackComplete = false;
+    int64_t callbackID = cancellationToken.registerCallback([&isCallbackStarted, &isCallbackComplete]() {
+        isCallbackStarted = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        isCallbackComplete = true;
+    });
+    std::thread cancelThread([&cancellationToken]() {
+        cancellationToken.cancel();
+    });
+    while (!isCallbackStarted)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    cancellationToken.unregisterCallback(callbackID);
+    EXPECT_TRUE(isCallbackComplete);
+    cancelThread.join();
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "git_diff_parser.hpp"
+
+using namespace vcc;
+
+TEST(GitDiffParserTest, Parse)
+{
+    std::wstring str = L" a.txt | 3 ++-\n";
+    str += L"\n";
+    str += L"diff --git a/a.txt b/a.txt\n";
+    str += L"index edf0eff..ab966a8 100644\n";
+    str += L"--- a/a.txt\n";
+    str += L"+++ b/a.txt\n";
+    str += L"@@ -1,2 +1,3 @@ section\n";
+    str += L" hi\n";
+    str += L"-there\n";
+    str += L"+There\n";
+    str += L"+--- not header\n";
+    str += L"@@ -10 +11 @@\n";
+    str += L"-x\n";
+    str += L"\\ No newline at end of file\n";
+    str += L"diff --git a/new file.txt b/new file.txt\n";
+    str += L"new file mode 100644\n";
+    str += L"index 0000000..ab966a8\n";
+    str += L"--- /dev/null\n";
+    str += L"+++ b/new file.txt\t\n";
+    str += L"@@ -0,0 +1 @@\n";
+    str += L"+new\n";
+    str += L"diff --git a/old.txt b/renamed.txt\n";
+    str += L"similarity index 100%\n";
+    str += L"rename from old.txt\n";
+    str += L"rename to renamed.txt\n";
+    str += L"diff --git a/image.png b/image.png\n";
+    str += L"deleted file mode 100644\n";
+    str += L"Binary files a/image.png and /dev/null differ\n";
+
+    GitDiffParser parser;
+    parser.parse(str);
+    EXPECT_EQ(parser.getBufferSize(), str.length());
+    ASSERT_EQ(parser.getFiles().size(), (size_t)4);
+
+    auto file = parser.getFiles().at(0);
+    EXPECT_EQ(file->getFilePathOld(), L"a.txt");
+    EXPECT_EQ(file->getFilePathNew(), L"a.txt");
+    ASSERT_EQ(file->getHunks().size(), (size_t)2);
+    auto hunk = file->getHunks().at(0);
+    EXPECT_EQ(hunk->getLineNumberOld(), (size_t)1);
+    EXPECT_EQ(hunk->getLineCountOld(), (size_t)2);
+    EXPECT_EQ(hunk->getLineNumberNew(), (size_t)1);
+    EXPECT_EQ(hunk->getLineCountNew(), (size_t)3);
+    EXPECT_EQ(hunk->getAddLineCount(), (size_t)2);
+    EXPECT_EQ(hunk->getDeleteLineCount(), (size_t)1);
+    EXPECT_EQ(parser.getHunkText(hunk.get()), L" hi\n-there\n+There\n+--- not header\n");
+    hunk = file->getHunks().at(1);
+    EXPECT_EQ(hunk->getLineNumberOld(), (size_t)10);
+    EXPECT_EQ(hunk->getLineCountOld(), (size_t)0);
+    EXPECT_EQ(hunk->getLineNumberNew(), (size_t)11);
+    EXPECT_EQ(parser.getHunkText(hunk.get()), L"-x\n\\ No newline at end of file\n");
+    EXPECT_TRUE(parser.getFileText(file.get()).starts_with(L"diff --git a/a.txt b/a.txt\n"));
+    EXPECT_TRUE(parser.getFileText(file.get()).ends_with(L"\\ No newline at end of file\n"));
+
+    file = parser.getFiles().at(1);
+    EXPECT_EQ(file->getFilePathOld(), L"");
+    EXPECT_EQ(file->getFilePathNew(), L"new file.txt");
+    EXPECT_EQ(parser.getFile(L"new file.txt"), file);
+    EXPECT_EQ(parser.getHunkText(file->getHunks().at(0).get()), L"+new\n");
+
+    file = parser.getFiles().at(2);
+    EXPECT_EQ(file->getFilePathOld(), L"old.txt");
+    EXPECT_EQ(file->getFilePathNew(), L"renamed.txt");
+    EXPECT_TRUE(file->getHunks().empty());
+
+    file = parser.getFiles().at(3);
+    EXPECT_EQ(file->getFilePathOld(), L"image.png");
+    EXPECT_EQ(file->getFilePathNew(), L"");
+    EXPECT_TRUE(file->getIsBinary());
+    EXPECT_EQ(parser.getFile(L"image.png"), file);
+
+    auto difference = parser.getDifference(parser.getFiles().at(0).get());
+    EXPECT_EQ(difference->getFilePathNew(), L"a.txt");
+    EXPECT_EQ(difference->getChangedLines().size(), (size_t)2);
+    EXPECT_EQ(difference->getChangedLines().at(1), L"-x\n\\ No newline at end of file\n");
+
+    parser.clear();
+    EXPECT_TRUE(parser.getFiles().empty());
+    EXPECT_EQ(parser.getBufferSize(), (size_t)0);
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "git_log_graph.hpp"
+#include "git_service.hpp"
+
+using namespace vcc;
+
+namespace
+{
+    std::shared_ptr<GitLog> createLog(const std::wstring &hashID, const std::vector<std::wstring> &parentHashIDs)
+    {
+        auto log = std::make_shared<GitLog>();
+        log->setHashID(hashID);
+        log->insertParentHashIDs(parentHashIDs);
+        return log;
+    }
+}
+
+TEST(GitLogGraphTest, Merge)
+{
+    // A merges C into B, B and C branch from D, E is another tip on D
+    std::vector<std::shared_ptr<GitLog>> logs = {
+        createLog(L"A", { L"B", L"C" }),
+        createLog(L"E", { L"D" }),
+        createLog(L"B", { L"D" }),
+        createLog(L"C", { L"D" }),
+        createLog(L"D", {})
+    };
+    GitLogGraph graph;
+    graph.addLogs(logs);
+
+    EXPECT_EQ(logs.at(0)->getColumnIndex(), 0);
+    EXPECT_EQ(logs.at(0)->getGraphIncomingColumnIndexes(), std::vector<int64_t>({}));
+    EXPECT_EQ(logs.at(0)->getGraphOutgoingColumnIndexes(), std::vector<int64_t>({ 0, 0 }));
+
+    EXPECT_EQ(logs.at(1)->getColumnIndex(), 2);
+    EXPECT_EQ(logs.at(1)->getGraphIncomingColumnIndexes(), std::vector<int64_t>({ 0, 1 }));
+    EXPECT_EQ(logs.at(1)->getGraphOutgoingColumnIndexes(), std::vector<int64_t>({ 0, 1, 2 }));
+
+    EXPECT_EQ(logs.at(2)->getColumnIndex(), 0);
+    EXPECT_EQ(logs.at(2)->getGraphIncomingColumnIndexes(), std::vector<int64_t>({ 0, 1, 2 }));
+    EXPECT_EQ(logs.at(2)->getGraphOutgoingColumnIndexes(), std::vector<int64_t>({ 0, 1, 2 }));
+
+    EXPECT_EQ(logs.at(3)->getColumnIndex(), 1);
+    EXPECT_EQ(logs.at(3)->getGraphIncomingColumnIndexes(), std::vector<int64_t>({ 0, 1, 2 }));
+    EXPECT_EQ(logs.at(3)->getGraphOutgoingColumnIndexes(), std::vector<int64_t>({ 0, 1, 2 }));
+
+    // all lanes join D
+    EXPECT_EQ(logs.at(4)->getColumnIndex(), 0);
+    EXPECT_EQ(logs.at(4)->getGraphIncomingColumnIndexes(), std::vector<int64_t>({ 0, 0, 0 }));
+    EXPECT_TRUE(logs.at(4)->getGraphOutgoingColumnIndexes().empty());
+    EXPECT_TRUE(graph.getLanes().empty());
+}
+
+TEST(GitLogGraphTest, Continue)
+{
+    std::vector<std::shared_ptr<GitLog>> logs = {
+        createLog(L"A", { L"B", L"C" }),
+        createLog(L"B", { L"D" }),
+        createLog(L"C", { L"D" }),
+        createLog(L"D", { L"F" })
+    };
+    GitLogGraph graph;
+    graph.addLogs(logs);
+
+    // same layout if second page continues from saved lanes of first page
+    std::vector<std::shared_ptr<GitLog>> page2 = { createLog(L"C", { L"D" }), createLog(L"D", { L"F" }) };
+    GitLogGraph graph1;
+    graph1.addCommit(L"A", { L"B", L"C" });
+    graph1.addCommit(L"B", { L"D" });
+    GitLogGraph graph2;
+    graph2.setLanes(graph1.getLanes());
+    graph2.addLogs(page2);
+    for (size_t i = 0; i < page2.size(); i++) {
+        EXPECT_EQ(page2.at(i)->getColumnIndex(), logs.at(i + 2)->getColumnIndex());
+        EXPECT_EQ(page2.at(i)->getGraphIncomingColumnIndexes(), logs.at(i + 2)->getGraphIncomingColumnIndexes());
+        EXPECT_EQ(page2.at(i)->getGraphOutgoingColumnIndexes(), logs.at(i + 2)->getGraphOutgoingColumnIndexes());
+    }
+    // parent outside history keeps its lane
+    EXPECT_EQ(graph2.getLanes(), std::vector<std::wstring>({ L"F" }));
+}
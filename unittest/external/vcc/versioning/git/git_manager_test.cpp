@@ -1,11 +1,18 @@
 #include <gtest/gtest.h>
 
+#include <filesystem>
+#include <string>
+
+#include "file_helper.hpp"
 #include "git_manager.hpp"
+#include "git_service.hpp"
+#include "process_service.hpp"
 
 class GitManagerTest : public testing::Test 
 {
     private:
         MANAGER_SPTR_NULL(vcc::GitManager, Manager);
+        GETSET(std::wstring, Workspace, L"bin/Debug/GitManager/");
 
     public:
         void SetUp() override
@@ -16,9 +23,156 @@ class GitManagerTest : public testing::Test
         void TearDown() override
         {
         }
+
+        // Repository with commits "Commit 0" to "Commit n - 1"
+        void initializeRepository(const int64_t &commitCount)
+        {
+            if (vcc::isDirectoryExists(_Workspace))
+                std::filesystem::remove_all(_Workspace);
+            vcc::createDirectory(_Workspace);
+            _Manager->setWorkspace(_Workspace);
+            _Manager->initializeGitResponse();
+            vcc::GitService::setLocalUserName(nullptr, _Workspace, L"test");
+            vcc::GitService::setLocalUserEmail(nullptr, _Workspace, L"test@test.com");
+            for (int64_t i = 0; i < commitCount; i++)
+                vcc::ProcessService::execute(nullptr, L"", _Workspace, L"git commit --allow-empty -m \"Commit " + std::to_wstring(i) + L"\"");
+        }
 };
 
 TEST_F(GitManagerTest, Full)
 {
 
 }
+
+TEST_F(GitManagerTest, LogPage)
+{
+    initializeRepository(7);
+    _Manager->setLogPageCacheSize(2);
+
+    auto page0 = _Manager->getLogPage(0, 3);
+    EXPECT_EQ(page0.size(), (size_t)3);
+    EXPECT_EQ(page0.at(0)->getTitle(), L"Commit 6");
+    EXPECT_EQ(page0.at(2)->getTitle(), L"Commit 4");
+    // page 0 and prefetched page 1
+    EXPECT_EQ(_Manager->getCachedLogPageCount(), (size_t)2);
+
+    auto page1 = _Manager->getLogPage(3, 3);
+    EXPECT_EQ(page1.size(), (size_t)3);
+    EXPECT_EQ(page1.at(0)->getTitle(), L"Commit 3");
+
+    // last page is not full, no prefetch
+    auto page2 = _Manager->getLogPage(6, 3);
+    EXPECT_EQ(page2.size(), (size_t)1);
+    EXPECT_EQ(page2.at(0)->getTitle(), L"Commit 0");
+    EXPECT_EQ(_Manager->getCachedLogPageCount(), (size_t)2);
+    EXPECT_TRUE(_Manager->getLogPage(9, 3).empty());
+
+    // search criteria limits whole history
+    auto searchCriteria = std::make_shared<vcc::GitLogSearchCriteria>();
+    searchCriteria->setSkip(1);
+    searchCriteria->setLogCount(4);
+    _Manager->setLogPageSearchCriteria(searchCriteria.get());
+    EXPECT_EQ(_Manager->getCachedLogPageCount(), (size_t)0);
+    auto limitedPage0 = _Manager->getLogPage(0, 3);
+    EXPECT_EQ(limitedPage0.size(), (size_t)3);
+    EXPECT_EQ(limitedPage0.at(0)->getTitle(), L"Commit 5");
+    auto limitedPage1 = _Manager->getLogPage(3, 3);
+    EXPECT_EQ(limitedPage1.size(), (size_t)1);
+    EXPECT_EQ(limitedPage1.at(0)->getTitle(), L"Commit 2");
+
+    _Manager->clearLogPageCache();
+    EXPECT_EQ(_Manager->getCachedLogPageCount(), (size_t)0);
+
+    // destroyed while next page is prefetched
+    _Manager->getLogPage(0, 3);
+    _Manager = nullptr;
+}
+
+TEST_F(GitManagerTest, LogPageGraph)
+{
+    // c0 - c1 - c2, branch f from c1 with f0 f1, merged by m
+    initializeRepository(2);
+    vcc::ProcessService::execute(nullptr, L"", _Workspace, L"git checkout -b f");
+    vcc::ProcessService::execute(nullptr, L"", _Workspace, L"git commit --allow-empty -m f0");
+    vcc::ProcessService::execute(nullptr, L"", _Workspace, L"git commit --allow-empty -m f1");
+    vcc::ProcessService::execute(nullptr, L"", _Workspace, L"git checkout -");
+    vcc::ProcessService::execute(nullptr, L"", _Workspace, L"git commit --allow-empty -m c2");
+    vcc::ProcessService::execute(nullptr, L"", _Workspace, L"git merge --no-ff -m m f");
+
+    auto logs = _Manager->getLogs(nullptr);
+    EXPECT_EQ(logs.size(), (size_t)6);
+    EXPECT_EQ(logs.at(0)->getTitle(), L"m");
+    EXPECT_EQ(logs.at(0)->getGraphOutgoingColumnIndexes(), std::vector<int64_t>({ 0, 0 }));
+
+    // later page first, rows before are read as hash id and parents only
+    _Manager->setIsLogPagePrefetch(false);
+    auto page1 = _Manager->getLogPage(2, 2);
+    auto page0 = _Manager->getLogPage(0, 2);
+    std::vector<std::shared_ptr<vcc::GitLog>> pageLogs = { page0.at(0), page0.at(1), page1.at(0), page1.at(1) };
+    for (size_t i = 0; i < pageLogs.size(); i++) {
+        EXPECT_EQ(pageLogs.at(i)->getHashID(), logs.at(i)->getHashID());
+        EXPECT_EQ(pageLogs.at(i)->getColumnIndex(), logs.at(i)->getColumnIndex());
+        EXPECT_EQ(pageLogs.at(i)->getGraphIncomingColumnIndexes(), logs.at(i)->getGraphIncomingColumnIndexes());
+        EXPECT_EQ(pageLogs.at(i)->getGraphOutgoingColumnIndexes(), logs.at(i)->getGraphOutgoingColumnIndexes());
+    }
+
+    // jump into walked gap continues from lanes saved at page boundary
+    _Manager->clearLogPageCache();
+    auto page5 = _Manager->getLogPage(5, 1);
+    auto page3 = _Manager->getLogPage(3, 1);
+    for (auto const &pair : std::vector<std::pair<std::shared_ptr<vcc::GitLog>, std::shared_ptr<vcc::GitLog>>>({ { page3.at(0), logs.at(3) }, { page5.at(0), logs.at(5) } })) {
+        EXPECT_EQ(pair.first->getHashID(), pair.second->getHashID());
+        EXPECT_EQ(pair.first->getColumnIndex(), pair.second->getColumnIndex());
+        EXPECT_EQ(pair.first->getGraphIncomingColumnIndexes(), pair.second->getGraphIncomingColumnIndexes());
+        EXPECT_EQ(pair.first->getGraphOutgoingColumnIndexes(), pair.second->getGraphOutgoingColumnIndexes());
+    }
+}
+
+TEST_F(GitManagerTest, ResultCache)
+{
+    initializeRepository(1);
+    std::wstring branchName = _Manager->getCurrentBranchName();
+    EXPECT_FALSE(branchName.empty());
+    EXPECT_TRUE(_Manager->getTags().empty());
+
+    // cached until HEAD is changed, HEAD with same modified time and size is not reloaded
+    std::filesystem::path headPath = std::filesystem::path(_Workspace) / L".git" / L"HEAD";
+    auto headTime = std::filesystem::last_write_time(headPath);
+    std::wstring otherBranchName(branchName.length(), L'x');
+    vcc::ProcessService::execute(nullptr, L"", _Workspace, L"git symbolic-ref HEAD refs/heads/" + otherBranchName);
+    std::filesystem::last_write_time(headPath, headTime);
+    EXPECT_EQ(_Manager->getCurrentBranchName(), branchName);
+    _Manager->clearResultCache();
+    EXPECT_EQ(_Manager->getCurrentBranchName(), otherBranchName);
+    vcc::ProcessService::execute(nullptr, L"", _Workspace, L"git symbolic-ref HEAD refs/heads/" + branchName);
+    EXPECT_EQ(_Manager->getCurrentBranchName(), branchName);
+
+    // changed outside manager
+    vcc::ProcessService::execute(nullptr, L"", _Workspace, L"git tag v0.0.1");
+    EXPECT_EQ(_Manager->getTags(), std::vector<std::wstring>({ L"v0.0.1" }));
+    EXPECT_EQ(_Manager->getCurrentTag()->getTagName(), L"v0.0.1");
+    vcc::ProcessService::execute(nullptr, L"", _Workspace, L"git branch feature/a");
+    auto branches = _Manager->getBranches();
+    EXPECT_EQ(branches.size(), (size_t)2);
+    vcc::GitService::setLocalUserName(nullptr, _Workspace, L"cache");
+    EXPECT_EQ(_Manager->getConfig(L"user.name"), L"cache");
+
+    // changed by manager
+    _Manager->CreateTag(L"v0.0.2");
+    EXPECT_EQ(_Manager->getTags().size(), (size_t)2);
+    _Manager->DeleteBranch(L"feature/a");
+    EXPECT_EQ(_Manager->getBranches().size(), (size_t)1);
+
+    // nested loose ref updated outside manager
+    vcc::ProcessService::execute(nullptr, L"", _Workspace, L"git branch feature/b");
+    EXPECT_EQ(_Manager->getBranches().size(), (size_t)2);
+    vcc::ProcessService::execute(nullptr, L"", _Workspace, L"git commit --allow-empty -m c");
+    vcc::ProcessService::execute(nullptr, L"", _Workspace, L"git update-ref refs/heads/feature/b HEAD");
+    std::wstring hashID = vcc::ProcessService::execute(nullptr, L"", _Workspace, L"git rev-parse HEAD");
+    for (auto const &branch : _Manager->getBranches())
+        EXPECT_EQ(branch->getHashID(), hashID);
+
+    // result is copy of cache
+    _Manager->getBranches().at(0)->setName(L"changed");
+    EXPECT_NE(_Manager->getBranches().at(0)->getName(), L"changed");
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "cancellation_token.hpp"
+#include "class_macro.hpp"
+#include "file_helper.hpp"
+#include "git_multi_repository_manager.hpp"
+#include "git_service.hpp"
+#include "log_config.hpp"
+#include "process_service.hpp"
+
+using namespace vcc;
+
+class GitMultiRepositoryManagerTest : public testing::Test
+{
+    GETSET_SPTR_NULL(LogConfig, LogConfig);
+    GETSET(std::wstring, Workspace, L"");
+    GETSET(std::wstring, RemoteWorkspace, L"");
+    GETSET(std::wstring, RepositoryDirectory, L"");
+    public:
+
+        void SetUp() override
+        {
+            this->_LogConfig = std::make_shared<vcc::LogConfig>();
+            this->_LogConfig->setIsConsoleLog(false);
+
+            // outside project checkout, git must not find repository of project by walking up from fixture
+            this->_Workspace = concatPaths({std::filesystem::temp_directory_path().wstring(), L"GitMultiRepositoryManager"});
+            this->_RemoteWorkspace = concatPaths({this->_Workspace, L"Remote"});
+            this->_RepositoryDirectory = concatPaths({this->_Workspace, L"Repositories"});
+            if (isDirectoryExists(this->getWorkspace()))
+                std::filesystem::remove_all(this->getWorkspace());
+            createDirectory(this->getRemoteWorkspace());
+            createDirectory(this->getRepositoryDirectory());
+            createDirectory(concatPaths({this->getRepositoryDirectory(), L"NotGit"}));
+
+            GitService::initializeGitResponse(this->getLogConfig().get(), this->getRemoteWorkspace());
+            GitService::setLocalUserName(this->getLogConfig().get(), this->getRemoteWorkspace(), L"test");
+            GitService::setLocalUserEmail(this->getLogConfig().get(), this->getRemoteWorkspace(), L"test@test.com");
+            writeFile(concatPaths({this->getRemoteWorkspace(), L"a.txt"}), L"a\n", true);
+            GitService::stageAll(this->getLogConfig().get(), this->getRemoteWorkspace());
+            GitService::Commit(this->getLogConfig().get(), this->getRemoteWorkspace(), L"Test Commit");
+
+            ProcessService::execute(this->getLogConfig().get(), L"", this->getRepositoryDirectory(), L"git clone --quiet ../Remote A");
+            ProcessService::execute(this->getLogConfig().get(), L"", this->getRepositoryDirectory(), L"git clone --quiet ../Remote B");
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove_all(this->getWorkspace());
+        }
+};
+
+TEST_F(GitMultiRepositoryManagerTest, FindRepositories)
+{
+    auto workspaces = GitMultiRepositoryManager::findRepositories(this->getRepositoryDirectory());
+    ASSERT_EQ(workspaces.size(), (size_t)2);
+    EXPECT_EQ(std::filesystem::path(workspaces[0]).filename().wstring(), L"A");
+    EXPECT_EQ(std::filesystem::path(workspaces[1]).filename().wstring(), L"B");
+}
+
+TEST_F(GitMultiRepositoryManagerTest, Pull)
+{
+    writeFile(concatPaths({this->getRemoteWorkspace(), L"b.txt"}), L"b\n", true);
+    GitService::stageAll(this->getLogConfig().get(), this->getRemoteWorkspace());
+    GitService::Commit(this->getLogConfig().get(), this->getRemoteWorkspace(), L"Second Commit");
+
+    // remote of C not exists
+    ProcessService::execute(this->getLogConfig().get(), L"", this->getRepositoryDirectory(), L"git clone --quiet ../Remote C");
+    ProcessService::execute(this->getLogConfig().get(), L"", concatPaths({this->getRepositoryDirectory(), L"C"}), L"git remote set-url origin ../../NotExists");
+
+    GitMultiRepositoryManager manager(this->getLogConfig());
+    manager.setParallelism(2);
+    manager.addWorkspaces(this->getRepositoryDirectory());
+    manager.addWorkspace(concatPaths({this->getRepositoryDirectory(), L"C"}));
+    manager.addWorkspace(concatPaths({this->getRepositoryDirectory(), L"A"}));
+    // git would run on repository containing directory
+    EXPECT_FALSE(GitMultiRepositoryManager::isRepositoryRoot(concatPaths({this->getRepositoryDirectory(), L"NotGit"})));
+    EXPECT_THROW(manager.addWorkspace(concatPaths({this->getRepositoryDirectory(), L"NotGit"})), std::exception);
+    EXPECT_THROW(manager.addWorkspace(concatPaths({this->getRepositoryDirectory(), L"A", L".git"})), std::exception);
+    EXPECT_EQ(manager.getWorkspaces().size(), (size_t)3);
+
+    std::atomic<int64_t> progressCount = 0;
+    int64_t lastCompletedCount = 0;
+    auto results = manager.Pull(nullptr, [&](const GitRepositoryProgress *progress) {
+        progressCount++;
+        EXPECT_EQ(progress->getTotalCount(), 3);
+        EXPECT_EQ(progress->getCompletedCount(), lastCompletedCount + 1);
+        lastCompletedCount = progress->getCompletedCount();
+    });
+    EXPECT_EQ(progressCount, 3);
+    ASSERT_EQ(results.size(), (size_t)3);
+    EXPECT_TRUE(results[0]->getIsSuccess());
+    EXPECT_TRUE(results[1]->getIsSuccess());
+    EXPECT_FALSE(results[2]->getIsSuccess());
+    EXPECT_FALSE(results[2]->getIsCancelled());
+    EXPECT_FALSE(results[2]->getError().empty());
+    EXPECT_TRUE(isFilePresent(concatPaths({this->getRepositoryDirectory(), L"A", L"b.txt"})));
+    EXPECT_TRUE(isFilePresent(concatPaths({this->getRepositoryDirectory(), L"B", L"b.txt"})));
+
+    std::wstring errorMessage = GitMultiRepositoryManager::getErrorMessage(results);
+    EXPECT_TRUE(errorMessage.starts_with(results[2]->getWorkspace() + L": "));
+}
+
+TEST_F(GitMultiRepositoryManagerTest, Status)
+{
+    writeFile(concatPaths({this->getRepositoryDirectory(), L"B", L"c.txt"}), L"c\n", true);
+
+    GitMultiRepositoryManager manager(this->getLogConfig());
+    manager.addWorkspaces(this->getRepositoryDirectory());
+    auto results = manager.getStatus();
+    ASSERT_EQ(results.size(), (size_t)2);
+    ASSERT_TRUE(results[0]->getIsSuccess());
+    ASSERT_TRUE(results[1]->getIsSuccess());
+    EXPECT_EQ(results[0]->getOperation(), GitRepositoryOperation::Status);
+    EXPECT_TRUE(results[0]->getStatus()->getWorkingTreeFiles().empty());
+    EXPECT_EQ(results[1]->getStatus()->getWorkingTreeFiles()[GitFileStatus::Untracked], std::vector<std::wstring>({ L"c.txt" }));
+    EXPECT_TRUE(GitMultiRepositoryManager::getErrorMessage(results).empty());
+}
+
+TEST_F(GitMultiRepositoryManagerTest, Cancel)
+{
+    GitMultiRepositoryManager manager(this->getLogConfig());
+    manager.addWorkspaces(this->getRepositoryDirectory());
+    CancellationToken cancellationToken;
+    cancellationToken.cancel();
+    auto results = manager.FetchAll(nullptr, &cancellationToken);
+    ASSERT_EQ(results.size(), (size_t)2);
+    for (auto const &result : results) {
+        EXPECT_FALSE(result->getIsSuccess());
+        EXPECT_TRUE(result->getIsCancelled());
+        EXPECT_EQ(result->getOperation(), GitRepositoryOperation::Fetch);
+    }
+}
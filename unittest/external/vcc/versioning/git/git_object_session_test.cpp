@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "class_macro.hpp"
+#include "file_helper.hpp"
+#include "git_object_session.hpp"
+#include "git_service.hpp"
+#include "log_config.hpp"
+#include "process_service.hpp"
+
+using namespace vcc;
+
+class GitObjectSessionTest : public testing::Test 
+{
+    GETSET_SPTR_NULL(LogConfig, LogConfig);
+    GETSET(std::wstring, Workspace, L"bin/Debug/GitObjectSession/");
+    public:
+
+        void SetUp() override
+        {
+            this->_LogConfig = std::make_shared<vcc::LogConfig>();
+            this->_LogConfig->setIsConsoleLog(false);
+
+            if (isDirectoryExists(this->getWorkspace()))
+                std::filesystem::remove_all(this->getWorkspace());
+            createDirectory(this->getWorkspace());
+
+            GitService::initializeGitResponse(this->getLogConfig().get(), this->getWorkspace());
+            GitService::setLocalUserName(this->getLogConfig().get(), this->getWorkspace(), L"test");
+            GitService::setLocalUserEmail(this->getLogConfig().get(), this->getWorkspace(), L"test@test.com");
+            writeFile(concatPaths({this->getWorkspace(), L"test.txt"}), L"hi\nthere\n", true);
+            GitService::stageAll(this->getLogConfig().get(), this->getWorkspace());
+            GitService::Commit(this->getLogConfig().get(), this->getWorkspace(), L"Test Commit");
+        }
+
+        void TearDown() override
+        {
+            GitObjectSession::closeSession(this->getWorkspace());
+        }
+};
+
+TEST_F(GitObjectSessionTest, ParseObjectHeader)
+{
+    auto object = std::make_shared<GitObject>();
+    GitObjectSession::parseObjectHeader(L"HEAD", "0123456789abcdef0123456789abcdef01234567 commit 176", object);
+    EXPECT_EQ(object->getName(), L"HEAD");
+    EXPECT_EQ(object->getHashID(), L"0123456789abcdef0123456789abcdef01234567");
+    EXPECT_EQ(object->getType(), L"commit");
+    EXPECT_EQ(object->getSize(), 176);
+    EXPECT_FALSE(object->getIsMissing());
+
+    auto missing = std::make_shared<GitObject>();
+    GitObjectSession::parseObjectHeader(L"HEAD:a b.txt", "HEAD:a b.txt missing", missing);
+    EXPECT_TRUE(missing->getIsMissing());
+}
+
+TEST_F(GitObjectSessionTest, Full)
+{
+    auto session = GitObjectSession::getSession(this->getLogConfig(), this->getWorkspace());
+    EXPECT_EQ(session, GitObjectSession::getSession(this->getLogConfig(), L"bin/Debug/GitObjectSession"));
+
+    auto commit = session->getObject(L"HEAD");
+    EXPECT_EQ(commit->getType(), L"commit");
+    EXPECT_EQ(commit->getHashID(), ProcessService::executeWithResult(this->getLogConfig().get(), L"", this->getWorkspace(), L"git rev-parse HEAD")->getOutput());
+    EXPECT_EQ((int64_t)commit->getContent().length(), commit->getSize());
+    EXPECT_TRUE(commit->getContent().starts_with("tree "));
+    EXPECT_NE(commit->getContent().find("Test Commit"), std::string::npos);
+
+    auto blobInfo = session->getObjectInfo(L"HEAD:test.txt");
+    EXPECT_EQ(blobInfo->getType(), L"blob");
+    EXPECT_EQ(blobInfo->getSize(), 9);
+    EXPECT_TRUE(blobInfo->getContent().empty());
+
+    auto objects = session->getObjects({ L"HEAD:test.txt", L"HEAD:missing.txt", L"HEAD^{tree}" });
+    EXPECT_EQ(objects.size(), (size_t)3);
+    EXPECT_EQ(objects.at(0)->getContent(), "hi\nthere\n");
+    EXPECT_EQ(objects.at(0)->getHashID(), blobInfo->getHashID());
+    EXPECT_TRUE(objects.at(1)->getIsMissing());
+    EXPECT_EQ(objects.at(2)->getType(), L"tree");
+
+    // Many requests in one session
+    std::vector<std::wstring> names(5000, L"HEAD:test.txt");
+    auto manyObjects = session->getObjects(names);
+    EXPECT_EQ(manyObjects.size(), names.size());
+    EXPECT_EQ(manyObjects.back()->getContent(), "hi\nthere\n");
+
+    EXPECT_THROW(session->getObject(L"a\nb"), std::exception);
+    // Session still usable after invalid request
+    EXPECT_EQ(session->getObject(L"HEAD:test.txt")->getContent(), "hi\nthere\n");
+}
@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include "class_macro.hpp"
+#include "file_helper.hpp"
+#include "git_manager.hpp"
+#include "git_ref_reader.hpp"
+#include "git_service.hpp"
+#include "log_config.hpp"
+#include "process_service.hpp"
+#include "string_helper.hpp"
+
+using namespace vcc;
+
+class GitRefReaderTest : public testing::Test
+{
+    GETSET_SPTR_NULL(LogConfig, LogConfig);
+    GETSET(std::wstring, Workspace, L"bin/Debug/GitRefReader/");
+    public:
+
+        void SetUp() override
+        {
+            this->_LogConfig = std::make_shared<vcc::LogConfig>();
+            this->_LogConfig->setIsConsoleLog(false);
+
+            if (isDirectoryExists(this->getWorkspace()))
+                std::filesystem::remove_all(this->getWorkspace());
+            createDirectory(this->getWorkspace());
+
+            GitService::initializeGitResponse(this->getLogConfig().get(), this->getWorkspace());
+            GitService::setLocalUserName(this->getLogConfig().get(), this->getWorkspace(), L"test");
+            GitService::setLocalUserEmail(this->getLogConfig().get(), this->getWorkspace(), L"test@test.com");
+        }
+
+        #ifndef _WIN32
+        // git cat-file child processes of test process
+        size_t getCatFileProcessCount()
+        {
+            size_t count = 0;
+            std::error_code errorCode;
+            for (auto const &entry : std::filesystem::directory_iterator("/proc", errorCode)) {
+                std::string name = entry.path().filename().string();
+                if (name.empty() || name.find_first_not_of("0123456789") != std::string::npos)
+                    continue;
+                std::ifstream statFile(entry.path() / "stat");
+                std::string stat((std::istreambuf_iterator<char>(statFile)), std::istreambuf_iterator<char>());
+                size_t pos = stat.rfind(')');
+                if (pos == std::string::npos || std::stol(stat.substr(stat.find(' ', pos + 2) + 1)) != getpid())
+                    continue;
+                std::ifstream cmdlineFile(entry.path() / "cmdline");
+                std::string cmdline((std::istreambuf_iterator<char>(cmdlineFile)), std::istreambuf_iterator<char>());
+                if (cmdline.find("cat-file") != std::string::npos)
+                    count++;
+            }
+            return count;
+        }
+        #endif
+
+        std::wstring execute(const std::wstring &command)
+        {
+            return ProcessService::execute(this->getLogConfig().get(), L"", this->getWorkspace(), command);
+        }
+
+        std::wstring toString(std::shared_ptr<GitBranch> branch)
+        {
+            return branch->getName() + L"|" + std::to_wstring(branch->getIsActive()) + L"|" + branch->getHashID() + L"|" + branch->getTitle() + L"|" + branch->getPointToBranch();
+        }
+
+        std::vector<std::wstring> getBranches()
+        {
+            std::vector<std::wstring> result;
+            for (auto const &branch : GitService::getBranches(this->getLogConfig().get(), this->getWorkspace()))
+                result.push_back(toString(branch));
+            // same as git command
+            std::vector<std::wstring> expectedResult;
+            for (auto const &line : splitStringByLine(execute(L"git branch -v --all --no-abbrev"))) {
+                auto branch = std::make_shared<GitBranch>();
+                GitService::ParseGitBranch(line, branch);
+                expectedResult.push_back(toString(branch));
+            }
+            EXPECT_EQ(result, expectedResult);
+            return result;
+        }
+};
+
+TEST_F(GitRefReaderTest, Head)
+{
+    std::wstring symbolicRef = L"";
+    std::wstring hashID = L"";
+    // no commit
+    EXPECT_TRUE(GitRefReader::getHead(this->getWorkspace(), symbolicRef, hashID));
+    EXPECT_TRUE(symbolicRef.starts_with(L"refs/heads/"));
+    EXPECT_TRUE(hashID.empty());
+    EXPECT_EQ(GitService::getCurrentBranchName(this->getLogConfig().get(), this->getWorkspace()), execute(L"git branch --show-current"));
+
+    execute(L"git commit --allow-empty -m \"Commit 0\"");
+    EXPECT_TRUE(GitRefReader::getHead(this->getWorkspace(), symbolicRef, hashID));
+    EXPECT_EQ(hashID, execute(L"git rev-parse HEAD"));
+
+    // detached
+    execute(L"git checkout --detach");
+    EXPECT_TRUE(GitRefReader::getHead(this->getWorkspace(), symbolicRef, hashID));
+    EXPECT_TRUE(symbolicRef.empty());
+    EXPECT_EQ(hashID, execute(L"git rev-parse HEAD"));
+    EXPECT_EQ(GitService::getCurrentBranchName(this->getLogConfig().get(), this->getWorkspace()), L"");
+}
+
+TEST_F(GitRefReaderTest, Refs)
+{
+    execute(L"git commit --allow-empty -m \"Commit 0\"");
+    execute(L"git tag v0.0.1");
+    execute(L"git commit --allow-empty -m \"Commit 1\" -m \"Body\"");
+    execute(L"git tag -a v0.0.2 -m \"Annotated\"");
+    execute(L"git branch feature/a");
+    execute(L"git update-ref refs/remotes/origin/main HEAD~1");
+    execute(L"git symbolic-ref refs/remotes/origin/HEAD refs/remotes/origin/main");
+
+    // loose refs
+    EXPECT_EQ(GitService::getTags(this->getLogConfig().get(), this->getWorkspace()), std::vector<std::wstring>({ L"v0.0.1", L"v0.0.2" }));
+    std::wstring branchName = execute(L"git branch --show-current");
+    std::wstring hash0 = execute(L"git rev-parse HEAD~1");
+    std::wstring hash1 = execute(L"git rev-parse HEAD");
+    EXPECT_EQ(getBranches(), std::vector<std::wstring>({ L"feature/a|0|" + hash1 + L"|Commit 1|", branchName + L"|1|" + hash1 + L"|Commit 1|",
+        L"remotes/origin/HEAD|0|||origin/main", L"remotes/origin/main|0|" + hash0 + L"|Commit 0|" }));
+    // target of loose annotated tag is unknown, git describe is used
+    EXPECT_EQ(GitService::getCurrentTag(this->getLogConfig().get(), this->getWorkspace())->getTagName(), L"v0.0.2");
+
+    // packed refs, loose ref overrides packed ref
+    execute(L"git pack-refs --all");
+    execute(L"git tag v0.0.0 HEAD~1");
+    execute(L"git commit --allow-empty -m \"Commit 2\"");
+    std::vector<std::shared_ptr<GitRef>> refs;
+    EXPECT_TRUE(GitRefReader::getRefs(this->getWorkspace(), L"refs/tags/", refs));
+    EXPECT_EQ(refs.size(), (size_t)3);
+    EXPECT_EQ(refs.at(2)->getName(), L"refs/tags/v0.0.2");
+    EXPECT_TRUE(refs.at(2)->getIsPeeled());
+    EXPECT_EQ(refs.at(2)->getPeeledHashID(), execute(L"git rev-parse HEAD~1"));
+    EXPECT_EQ(GitService::getTags(this->getLogConfig().get(), this->getWorkspace()), splitStringByLine(execute(L"git tag -l")));
+    std::wstring hash2 = execute(L"git rev-parse HEAD");
+    EXPECT_EQ(getBranches(), std::vector<std::wstring>({ L"feature/a|0|" + hash1 + L"|Commit 1|", branchName + L"|1|" + hash2 + L"|Commit 2|",
+        L"remotes/origin/HEAD|0|||origin/main", L"remotes/origin/main|0|" + hash0 + L"|Commit 0|" }));
+
+    // HEAD tagged by packed annotated tag only
+    execute(L"git tag -d v0.0.0");
+    execute(L"git checkout --detach HEAD~1");
+    EXPECT_EQ(GitService::getCurrentTag(this->getLogConfig().get(), this->getWorkspace())->getTagName(), L"v0.0.2");
+    std::wstring hashID = L"";
+    EXPECT_TRUE(GitRefReader::resolveRef(this->getWorkspace(), L"refs/remotes/origin/HEAD", hashID));
+    EXPECT_EQ(hashID, execute(L"git rev-parse HEAD~1"));
+}
+
+#ifndef _WIN32
+TEST_F(GitRefReaderTest, BranchObjectSession)
+{
+    execute(L"git commit --allow-empty -m \"Commit 0\"");
+
+    // stateless call leaves no git process
+    EXPECT_EQ(GitService::getBranches(this->getLogConfig().get(), this->getWorkspace()).size(), (size_t)1);
+    EXPECT_EQ(getCatFileProcessCount(), (size_t)0);
+
+    // session of manager is kept until manager is destroyed
+    auto manager = std::make_shared<GitManager>(this->getLogConfig(), this->getWorkspace());
+    EXPECT_EQ(manager->getBranches().size(), (size_t)1);
+    EXPECT_EQ(getCatFileProcessCount(), (size_t)1);
+    manager.reset();
+    EXPECT_EQ(getCatFileProcessCount(), (size_t)0);
+}
+#endif
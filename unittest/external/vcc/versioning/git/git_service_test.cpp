@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <regex>
@@ -11,6 +12,7 @@
 #include "file_helper.hpp"
 #include "git_service.hpp"
 #include "log_config.hpp"
+#include "process_service.hpp"
 #include "terminal_service.hpp"
 
 using namespace vcc;
@@ -292,6 +294,60 @@ TEST_F(GitServiceTest, parseGitLog)
     EXPECT_EQ(log5->getFullMessage(), str);
 }
 
+TEST_F(GitServiceTest, parseGitLogRecords)
+{
+    std::wstring str = L"";
+    str += L"*   \x1e" L"A1\x1f" L"A1Short\x1f" L"A2\x1f" L"A2Short\x1f" L"A3 A6\x1f" L"A3Short A6Short\x1f" L"HEAD -> main, tag: v0.0.1, origin/main\x1f"
+        L"Test Tester\x1f" L"test@gmail.com\x1f" L"Thu Jan 25 22:47:35 2024 +0800\x1f" L"Committer\x1f" L"committer@gmail.com\x1f" L"Fri Jan 26 22:47:35 2024 +0800\x1f" L"Merge branch\n";
+    str += L"|\\  \n";
+    str += L"| | * body line\n";
+    str += L"| | \x1d\n";
+    str += L"| * \x1e" L"A6\x1f" L"A6Short\x1f" L"A7\x1f" L"A7Short\x1f" L"A8\x1f" L"A8Short\x1f\x1f" L"Test Tester\x1f" L"test@gmail.com\x1f" L"Thu Jan 25 22:47:35 2024 +0800\x1f"
+        L"Test Tester\x1f" L"test@gmail.com\x1f" L"Thu Jan 25 22:47:35 2024 +0800\x1f" L"Title\n";
+    str += L"| | second title line\n";
+    str += L"| | \x1d\n";
+    str += L"|/  \n";
+    str += L"* \x1e" L"B1\x1f" L"B1Short\x1f" L"B2\x1f" L"B2Short\x1f\x1f\x1f" L"tag: v0.0.0\x1f" L"Test Tester\x1f" L"test@gmail.com\x1f" L"Thu Jan 25 22:47:35 2024 +0800\x1f"
+        L"Test Tester\x1f" L"test@gmail.com\x1f" L"Thu Jan 25 22:47:35 2024 +0800\x1f" L"Init\x1d\n";
+
+    std::vector<std::shared_ptr<GitLog>> logs = GitService::parseGitLogRecords(str);
+    EXPECT_EQ(logs.size(), (size_t)3);
+    EXPECT_EQ(logs.at(0)->getColumnIndex(), 0);
+    EXPECT_EQ(logs.at(0)->getHashID(), L"A1");
+    EXPECT_EQ(logs.at(0)->getAbbreviatedHashID(), L"A1Short");
+    EXPECT_EQ(logs.at(0)->getTreeHashID(), L"A2");
+    EXPECT_EQ(logs.at(0)->getAbbreviatedTreeHashID(), L"A2Short");
+    EXPECT_EQ(logs.at(0)->getParentHashIDs(), std::vector<std::wstring>({ L"A3", L"A6" }));
+    EXPECT_EQ(logs.at(0)->getAbbreviatedParentHashIDs(), std::vector<std::wstring>({ L"A3Short", L"A6Short" }));
+    EXPECT_TRUE(logs.at(0)->getIsHead());
+    EXPECT_EQ(logs.at(0)->getBranches(), std::vector<std::wstring>({ L"main", L"origin/main" }));
+    EXPECT_EQ(logs.at(0)->getTags(), std::vector<std::wstring>({ L"v0.0.1" }));
+    EXPECT_EQ(logs.at(0)->getAuthor(), L"Test Tester");
+    EXPECT_EQ(logs.at(0)->getAuthorEmail(), L"test@gmail.com");
+    EXPECT_EQ(logs.at(0)->getAuthorDate(), GitService::parseGitLogDatetime(L"Thu Jan 25 22:47:35 2024 +0800"));
+    EXPECT_EQ(logs.at(0)->getAuthorDateStr(), L"Thu Jan 25 22:47:35 2024 +0800");
+    EXPECT_EQ(logs.at(0)->getCommitter(), L"Committer");
+    EXPECT_EQ(logs.at(0)->getCommitterEmail(), L"committer@gmail.com");
+    EXPECT_EQ(logs.at(0)->getCommitDateStr(), L"Fri Jan 26 22:47:35 2024 +0800");
+    EXPECT_EQ(logs.at(0)->getTitle(), L"Merge branch");
+    EXPECT_EQ(logs.at(0)->getMessage(), L"* body line\n");
+    EXPECT_EQ(logs.at(0)->getFullMessage(), L"Merge branch\n\n* body line\n");
+
+    EXPECT_EQ(logs.at(1)->getColumnIndex(), 1);
+    EXPECT_EQ(logs.at(1)->getHashID(), L"A6");
+    EXPECT_FALSE(logs.at(1)->getIsHead());
+    EXPECT_TRUE(logs.at(1)->getBranches().empty());
+    EXPECT_EQ(logs.at(1)->getTitle(), L"Title\nsecond title line");
+    EXPECT_EQ(logs.at(1)->getMessage(), L"");
+
+    EXPECT_EQ(logs.at(2)->getColumnIndex(), 0);
+    EXPECT_EQ(logs.at(2)->getHashID(), L"B1");
+    EXPECT_TRUE(logs.at(2)->getParentHashIDs().empty());
+    EXPECT_EQ(logs.at(2)->getTags(), std::vector<std::wstring>({ L"v0.0.0" }));
+    EXPECT_EQ(logs.at(2)->getTitle(), L"Init");
+    EXPECT_EQ(logs.at(2)->getFullMessage(), L"Init");
+}
+
 TEST_F(GitServiceTest, ParseGitBranch)
 {
     std::wstring str = L"* master hashID Title 1";
@@ -318,6 +374,13 @@ TEST_F(GitServiceTest, ParseGitBranch)
     EXPECT_EQ(checkoutBranch3->getHashID(), L"");
     EXPECT_EQ(checkoutBranch3->getTitle(), L"");
     EXPECT_EQ(checkoutBranch3->getPointToBranch(), L"origin/Head");
+
+    str = L"  main      hashID Title 1";
+    auto checkoutBranch4 = std::make_shared<GitBranch>();
+    GitService::ParseGitBranch(str, checkoutBranch4);
+    EXPECT_EQ(checkoutBranch4->getName(), L"main");
+    EXPECT_EQ(checkoutBranch4->getHashID(), L"hashID");
+    EXPECT_EQ(checkoutBranch4->getTitle(), L"Title 1");
 }
 
 TEST_F(GitServiceTest, Tag)
@@ -415,6 +478,126 @@ TEST_F(GitServiceTest, Branch)
     //GitService::DeleteBranch(this->getLogConfig().get(), this->getWorkspace(), L"branch");
 }
 
+TEST(GitServiceProgressTest, parseGitProgress)
+{
+    auto progress = std::make_shared<GitProgress>();
+    EXPECT_TRUE(GitService::parseGitProgress(L"Receiving objects:  45% (450/1000), 1.20 MiB | 2.40 MiB/s", progress));
+    EXPECT_EQ(progress->getPhase(), L"Receiving objects");
+    EXPECT_FALSE(progress->getIsRemote());
+    EXPECT_EQ(progress->getPercent(), 45);
+    EXPECT_EQ(progress->getCurrent(), 450);
+    EXPECT_EQ(progress->getTotal(), 1000);
+    EXPECT_EQ(progress->getTransferred(), L"1.20 MiB");
+    EXPECT_EQ(progress->getThroughput(), L"2.40 MiB/s");
+    EXPECT_FALSE(progress->getIsDone());
+
+    // throughput is kept until updated in the same phase
+    EXPECT_TRUE(GitService::parseGitProgress(L"Receiving objects:  46% (460/1000)", progress));
+    EXPECT_EQ(progress->getCurrent(), 460);
+    EXPECT_EQ(progress->getThroughput(), L"2.40 MiB/s");
+
+    EXPECT_TRUE(GitService::parseGitProgress(L"Resolving deltas: 100% (200/200), done.", progress));
+    EXPECT_EQ(progress->getPhase(), L"Resolving deltas");
+    EXPECT_EQ(progress->getPercent(), 100);
+    EXPECT_EQ(progress->getCurrent(), 200);
+    EXPECT_EQ(progress->getThroughput(), L"");
+    EXPECT_TRUE(progress->getIsDone());
+
+    EXPECT_TRUE(GitService::parseGitProgress(L"remote: Enumerating objects: 1234, done.", progress));
+    EXPECT_EQ(progress->getPhase(), L"Enumerating objects");
+    EXPECT_TRUE(progress->getIsRemote());
+    EXPECT_EQ(progress->getPercent(), -1);
+    EXPECT_EQ(progress->getCurrent(), 1234);
+    EXPECT_EQ(progress->getTotal(), -1);
+    EXPECT_TRUE(progress->getIsDone());
+
+    EXPECT_TRUE(GitService::parseGitProgress(L"Writing objects: 100% (3/3), 240 bytes | 240.00 KiB/s, done.", progress));
+    EXPECT_EQ(progress->getTransferred(), L"240 bytes");
+    EXPECT_EQ(progress->getThroughput(), L"240.00 KiB/s");
+
+    EXPECT_FALSE(GitService::parseGitProgress(L"Cloning into 'a'...", progress));
+    EXPECT_FALSE(GitService::parseGitProgress(L"fatal: repository 'a' does not exist", progress));
+    EXPECT_FALSE(GitService::parseGitProgress(L"remote: Total 3 (delta 0), reused 0 (delta 0), pack-reused 0", progress));
+}
+
+TEST_F(GitServiceTest, cloneGitResponseProgress)
+{
+    std::wstring remoteWorkspace = concatPaths({this->getWorkspace(), L"Remote"});
+    createDirectory(remoteWorkspace);
+    GitService::initializeGitResponse(this->getLogConfig().get(), remoteWorkspace);
+    GitService::setLocalUserName(this->getLogConfig().get(), remoteWorkspace, L"test");
+    GitService::setLocalUserEmail(this->getLogConfig().get(), remoteWorkspace, L"test@test.com");
+    writeFile(concatPaths({remoteWorkspace, L"a.txt"}), L"a\n", true);
+    GitService::stageAll(this->getLogConfig().get(), remoteWorkspace);
+    GitService::Commit(this->getLogConfig().get(), remoteWorkspace, L"Test Commit");
+
+    // file:// uses pack transfer as network clone
+    std::vector<std::wstring> phases;
+    GitService::cloneGitResponse(this->getLogConfig().get(), this->getWorkspace(), L"file://" + std::filesystem::absolute(remoteWorkspace).wstring() + L" Local", nullptr, nullptr, [&phases](const GitProgress *progress) {
+        if (progress->getIsDone())
+            phases.push_back(progress->getPhase());
+    });
+    EXPECT_TRUE(isFilePresent(concatPaths({this->getWorkspace(), L"Local", L"a.txt"})));
+    EXPECT_NE(std::find(phases.begin(), phases.end(), L"Receiving objects"), phases.end());
+}
+
+TEST(GitServiceCloneTest, getCloneDirectory)
+{
+    EXPECT_EQ(GitService::getCloneDirectory(L"https://github.com/a/b.git"), L"b");
+    EXPECT_EQ(GitService::getCloneDirectory(L"https://github.com/a/b/"), L"b");
+    EXPECT_EQ(GitService::getCloneDirectory(L"git@github.com:a/b.git"), L"b");
+    EXPECT_EQ(GitService::getCloneDirectory(L"/path/to/b/.git"), L"b");
+    EXPECT_EQ(GitService::getCloneDirectory(L"b"), L"b");
+}
+
+TEST_F(GitServiceTest, cloneGitResponseOption)
+{
+    std::wstring remoteWorkspace = concatPaths({this->getWorkspace(), L"Remote"});
+    createDirectory(remoteWorkspace);
+    GitService::initializeGitResponse(this->getLogConfig().get(), remoteWorkspace);
+    GitService::setLocalUserName(this->getLogConfig().get(), remoteWorkspace, L"test");
+    GitService::setLocalUserEmail(this->getLogConfig().get(), remoteWorkspace, L"test@test.com");
+    ProcessService::execute(this->getLogConfig().get(), L"", remoteWorkspace, L"git config uploadpack.allowFilter true");
+    writeFile(concatPaths({remoteWorkspace, L"a.txt"}), L"a\n", true);
+    writeFile(concatPaths({remoteWorkspace, L"dir1", L"b.txt"}), L"b\n", true);
+    writeFile(concatPaths({remoteWorkspace, L"dir2", L"c.txt"}), L"c\n", true);
+    GitService::stageAll(this->getLogConfig().get(), remoteWorkspace);
+    GitService::Commit(this->getLogConfig().get(), remoteWorkspace, L"Commit 1");
+    ProcessService::execute(this->getLogConfig().get(), L"", remoteWorkspace, L"git tag v0.0.1");
+    ProcessService::execute(this->getLogConfig().get(), L"", remoteWorkspace, L"git commit --allow-empty -m \"Commit 2\"");
+
+    // tag only, one commit, file content downloaded on checkout of sparse directories only
+    GitCloneOption option;
+    option.setBranch(L"v0.0.1");
+    option.setDepth(1);
+    option.setFilter(L"blob:none");
+    option.setDirectory(L"Local");
+    option.insertSparseCheckoutPaths(L"dir1");
+    GitService::cloneGitResponse(this->getLogConfig().get(), this->getWorkspace(), L"file://" + std::filesystem::absolute(remoteWorkspace).wstring(), &option);
+
+    std::wstring localWorkspace = concatPaths({this->getWorkspace(), L"Local"});
+    EXPECT_TRUE(isFilePresent(concatPaths({localWorkspace, L"a.txt"})));
+    EXPECT_TRUE(isFilePresent(concatPaths({localWorkspace, L"dir1", L"b.txt"})));
+    EXPECT_FALSE(isFilePresent(concatPaths({localWorkspace, L"dir2", L"c.txt"})));
+    EXPECT_EQ(ProcessService::execute(this->getLogConfig().get(), L"", localWorkspace, L"git rev-list --count HEAD"), L"1");
+    EXPECT_EQ(ProcessService::execute(this->getLogConfig().get(), L"", localWorkspace, L"git describe --tags"), L"v0.0.1");
+    EXPECT_EQ(ProcessService::execute(this->getLogConfig().get(), L"", localWorkspace, L"git config remote.origin.partialclonefilter"), L"blob:none");
+}
+
+TEST_F(GitServiceTest, isRemoteTagExists)
+{
+    std::wstring remoteWorkspace = concatPaths({this->getWorkspace(), L"Remote"});
+    createDirectory(remoteWorkspace);
+    GitService::initializeGitResponse(this->getLogConfig().get(), remoteWorkspace);
+    ProcessService::execute(this->getLogConfig().get(), L"", remoteWorkspace, L"git -c user.name=test -c user.email=test@test.com commit --allow-empty -m \"Commit 1\"");
+    ProcessService::execute(this->getLogConfig().get(), L"", remoteWorkspace, L"git tag v0.0.1");
+
+    std::wstring url = L"file://" + std::filesystem::absolute(remoteWorkspace).wstring();
+    EXPECT_TRUE(GitService::isRemoteTagExists(this->getLogConfig().get(), this->getWorkspace(), url, L"v0.0.1"));
+    EXPECT_FALSE(GitService::isRemoteTagExists(this->getLogConfig().get(), this->getWorkspace(), url, L"v0.0.2"));
+    EXPECT_THROW(GitService::isRemoteTagExists(this->getLogConfig().get(), this->getWorkspace(), url + L"NotExists", L"v0.0.1"), std::exception);
+}
+
 TEST_F(GitServiceTest, parseGitDiff)
 {
     std::wstring str = L"diff --git a/test.txt b/test.txt\r\n";
@@ -437,6 +620,36 @@ TEST_F(GitServiceTest, parseGitDiff)
     EXPECT_EQ(diff->getChangedLines()[0], expectedChangedLine);
 }
 
+TEST_F(GitServiceTest, getDifferences)
+{
+    GitService::initializeGitResponse(this->getLogConfig().get(), this->getWorkspace());
+    GitService::setLocalUserName(this->getLogConfig().get(), this->getWorkspace(), L"test");
+    GitService::setLocalUserEmail(this->getLogConfig().get(), this->getWorkspace(), L"test@test.com");
+    writeFile(concatPaths({this->getWorkspace(), L"a.txt"}), L"a\n", true);
+    writeFile(concatPaths({this->getWorkspace(), L"b c.txt"}), L"b\n", true);
+    writeFile(concatPaths({this->getWorkspace(), L"d.txt"}), L"d\n", true);
+    GitService::stageAll(this->getLogConfig().get(), this->getWorkspace());
+    GitService::Commit(this->getLogConfig().get(), this->getWorkspace(), L"Test Commit");
+
+    writeFile(concatPaths({this->getWorkspace(), L"a.txt"}), L"a\nA\n", true);
+    writeFile(concatPaths({this->getWorkspace(), L"b c.txt"}), L"B\n", true);
+    writeFile(concatPaths({this->getWorkspace(), L"d.txt"}), L"D\n", true);
+    auto differences = GitService::getDifferences(this->getLogConfig().get(), this->getWorkspace(), { L"b c.txt", L"a.txt", L"e.txt" });
+    ASSERT_EQ(differences.size(), (size_t)2);
+    EXPECT_EQ(differences.at(0)->getFilePathNew(), L"a.txt");
+    EXPECT_EQ(differences.at(0)->getChangedLines().at(0), L" a\n+A\n");
+    EXPECT_EQ(differences.at(1)->getFilePathNew(), L"b c.txt");
+    EXPECT_EQ(differences.at(1)->getChangedLines().at(0), L"-b\n+B\n");
+    EXPECT_EQ(GitService::getDifferences(this->getLogConfig().get(), this->getWorkspace(), {}).size(), (size_t)3);
+
+    GitService::stage(this->getLogConfig().get(), this->getWorkspace(), L"d.txt");
+    GitDifferentSearchCriteria searchCriteria;
+    searchCriteria.setIsCached(true);
+    differences = GitService::getDifferences(this->getLogConfig().get(), this->getWorkspace(), {}, &searchCriteria);
+    ASSERT_EQ(differences.size(), (size_t)1);
+    EXPECT_EQ(differences.at(0)->getFilePathNew(), L"d.txt");
+}
+
 TEST_F(GitServiceTest, stageAndDifference)
 {
     // init
@@ -564,6 +777,15 @@ TEST_F(GitServiceTest, stageAndDifference)
     EXPECT_EQ(logs.at(2)->getTitle(), L"Test Modify");
     EXPECT_EQ(logs.at(3)->getTitle(), L"Test Commit");
 
+    // Skipped history has unknown lanes, not laid out
+    EXPECT_EQ(logs.at(1)->getGraphOutgoingColumnIndexes(), std::vector<int64_t>({ 0 }));
+    GitLogSearchCriteria skipSearchCriteria;
+    skipSearchCriteria.setSkip(1);
+    std::vector<std::shared_ptr<GitLog>> skippedLogs = GitService::getLogs(this->getLogConfig().get(), this->getWorkspace(), &skipSearchCriteria);
+    ASSERT_EQ(skippedLogs.size(), (size_t)3);
+    EXPECT_EQ(skippedLogs.at(0)->getTitle(), L"Test Rename");
+    EXPECT_TRUE(skippedLogs.at(0)->getGraphOutgoingColumnIndexes().empty());
+
     // Test normal operation
     GitService::FetchAll(this->getLogConfig().get(), this->getWorkspace());
     // Note: cannot pull as it is local response
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "class_macro.hpp"
+#include "file_helper.hpp"
+#include "git_service.hpp"
+#include "git_status_monitor.hpp"
+#include "log_config.hpp"
+#include "process_service.hpp"
+
+using namespace vcc;
+
+class GitStatusMonitorTest : public testing::Test
+{
+    GETSET_SPTR_NULL(LogConfig, LogConfig);
+    GETSET(std::wstring, Workspace, L"bin/Debug/GitStatusMonitor/");
+    public:
+
+        void SetUp() override
+        {
+            this->_LogConfig = std::make_shared<vcc::LogConfig>();
+            this->_LogConfig->setIsConsoleLog(false);
+
+            if (isDirectoryExists(this->getWorkspace()))
+                std::filesystem::remove_all(this->getWorkspace());
+            createDirectory(this->getWorkspace());
+
+            GitService::initializeGitResponse(this->getLogConfig().get(), this->getWorkspace());
+            GitService::setLocalUserName(this->getLogConfig().get(), this->getWorkspace(), L"test");
+            GitService::setLocalUserEmail(this->getLogConfig().get(), this->getWorkspace(), L"test@test.com");
+            writeFile(concatPaths({this->getWorkspace(), L"a.txt"}), L"a\n", true);
+            writeFile(concatPaths({this->getWorkspace(), L"b.txt"}), L"b\n", true);
+            GitService::stageAll(this->getLogConfig().get(), this->getWorkspace());
+            GitService::Commit(this->getLogConfig().get(), this->getWorkspace(), L"Test Commit");
+        }
+
+        bool waitFor(GitStatusMonitor &monitor, GitFileStatus fileStatus, const std::wstring &path, bool isExpected)
+        {
+            for (int i = 0; i < 50; i++) {
+                auto status = monitor.getStatus();
+                auto files = status->getWorkingTreeFiles().find(fileStatus);
+                bool isFound = files != status->getWorkingTreeFiles().end() && std::find(files->second.begin(), files->second.end(), path) != files->second.end();
+                if (isFound == isExpected)
+                    return true;
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            }
+            return false;
+        }
+};
+
+TEST_F(GitStatusMonitorTest, NotRunning)
+{
+    GitStatusMonitor monitor(this->getLogConfig(), this->getWorkspace());
+    writeFile(concatPaths({this->getWorkspace(), L"c.txt"}), L"c\n", true);
+    auto status = monitor.getStatus();
+    EXPECT_EQ(status->getBranch(), GitService::getCurrentBranchName(this->getLogConfig().get(), this->getWorkspace()));
+    EXPECT_EQ(status->getWorkingTreeFiles()[GitFileStatus::Untracked], std::vector<std::wstring>({ L"c.txt" }));
+    EXPECT_EQ(monitor.getQueryCount(), 1);
+}
+
+#ifdef __linux__
+TEST_F(GitStatusMonitorTest, Watch)
+{
+    GitStatusMonitor monitor(this->getLogConfig(), this->getWorkspace());
+    monitor.setDebounce(50);
+    std::atomic<int64_t> changedCount = 0;
+    monitor.setOnChanged([&](std::shared_ptr<GitStatus>) { changedCount++; });
+    monitor.start();
+    EXPECT_TRUE(monitor.isRunning());
+    EXPECT_EQ(monitor.getQueryCount(), 1);
+    EXPECT_TRUE(monitor.getStatus()->getWorkingTreeFiles().empty());
+
+    // modify tracked file, only dirty path is queried
+    writeFile(concatPaths({this->getWorkspace(), L"a.txt"}), L"a modified\n", true);
+    EXPECT_TRUE(waitFor(monitor, GitFileStatus::Modified, L"a.txt", true));
+    EXPECT_GE(changedCount, 1);
+    EXPECT_GE(monitor.getQueryCount(), 2);
+
+    // new directory is watched
+    createDirectory(concatPaths({this->getWorkspace(), L"dir"}));
+    writeFile(concatPaths({this->getWorkspace(), L"dir", L"c.txt"}), L"c\n", true);
+    EXPECT_TRUE(waitFor(monitor, GitFileStatus::Untracked, L"dir/", true));
+    // file added to untracked directory keeps it collapsed
+    int64_t queryCount = monitor.getQueryCount();
+    writeFile(concatPaths({this->getWorkspace(), L"dir", L"d.txt"}), L"d\n", true);
+    for (int i = 0; i < 50 && monitor.getQueryCount() == queryCount; i++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_GT(monitor.getQueryCount(), queryCount);
+    EXPECT_EQ(monitor.getStatus()->getWorkingTreeFiles()[GitFileStatus::Untracked], std::vector<std::wstring>({ L"dir/" }));
+    std::filesystem::remove_all(concatPaths({this->getWorkspace(), L"dir"}));
+    EXPECT_TRUE(waitFor(monitor, GitFileStatus::Untracked, L"dir/", false));
+
+    // revert
+    writeFile(concatPaths({this->getWorkspace(), L"a.txt"}), L"a\n", true);
+    EXPECT_TRUE(waitFor(monitor, GitFileStatus::Modified, L"a.txt", false));
+    EXPECT_TRUE(monitor.getStatus()->getWorkingTreeFiles().empty());
+
+    // commit changes refs and index, whole working tree is queried
+    writeFile(concatPaths({this->getWorkspace(), L"b.txt"}), L"b modified\n", true);
+    EXPECT_TRUE(waitFor(monitor, GitFileStatus::Modified, L"b.txt", true));
+    GitService::stageAll(this->getLogConfig().get(), this->getWorkspace());
+    GitService::Commit(this->getLogConfig().get(), this->getWorkspace(), L"Second Commit");
+    EXPECT_TRUE(waitFor(monitor, GitFileStatus::Modified, L"b.txt", false));
+
+    monitor.stop();
+    EXPECT_FALSE(monitor.isRunning());
+}
+
+TEST_F(GitStatusMonitorTest, WatchIgnoredDirectoryAndRefs)
+{
+    writeFile(concatPaths({this->getWorkspace(), L".gitignore"}), L"build*/\n", true);
+    GitService::stageAll(this->getLogConfig().get(), this->getWorkspace());
+    GitService::Commit(this->getLogConfig().get(), this->getWorkspace(), L"Ignore");
+    createDirectory(concatPaths({this->getWorkspace(), L"build", L"sub"}));
+
+    GitStatusMonitor monitor(this->getLogConfig(), this->getWorkspace());
+    monitor.setDebounce(50);
+    monitor.start();
+    auto waitForQuery = [&monitor](const int64_t &queryCount) {
+        for (int i = 0; i < 50 && monitor.getQueryCount() == queryCount; i++)
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        return monitor.getQueryCount() > queryCount;
+    };
+
+    // ignored directory existing or created later is not watched
+    int64_t queryCount = monitor.getQueryCount();
+    writeFile(concatPaths({this->getWorkspace(), L"build", L"sub", L"o.txt"}), L"o\n", true);
+    createDirectory(concatPaths({this->getWorkspace(), L"build2"}));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    writeFile(concatPaths({this->getWorkspace(), L"build2", L"o.txt"}), L"o\n", true);
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    EXPECT_EQ(monitor.getQueryCount(), queryCount);
+
+    // nested branch and remote ref
+    ProcessService::execute(this->getLogConfig().get(), L"", this->getWorkspace(), L"git branch feature/x HEAD~1");
+    EXPECT_TRUE(waitForQuery(queryCount));
+    queryCount = monitor.getQueryCount();
+    ProcessService::execute(this->getLogConfig().get(), L"", this->getWorkspace(), L"git update-ref refs/heads/feature/x HEAD");
+    EXPECT_TRUE(waitForQuery(queryCount));
+    queryCount = monitor.getQueryCount();
+    ProcessService::execute(this->getLogConfig().get(), L"", this->getWorkspace(), L"git update-ref refs/remotes/origin/main HEAD");
+    EXPECT_TRUE(waitForQuery(queryCount));
+    queryCount = monitor.getQueryCount();
+    ProcessService::execute(this->getLogConfig().get(), L"", this->getWorkspace(), L"git update-ref refs/remotes/origin/main HEAD~1");
+    EXPECT_TRUE(waitForQuery(queryCount));
+    monitor.stop();
+}
+#endif
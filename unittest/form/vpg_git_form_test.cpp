@@ -1,5 +1,11 @@
 #include <gtest/gtest.h>
 
+#include <filesystem>
+#include <string>
+
+#include "file_helper.hpp"
+#include "git_service.hpp"
+#include "process_service.hpp"
 #include "vpg_git_form.hpp"
 
 class VPGGitFormTest : public testing::Test 
@@ -25,3 +31,26 @@ TEST_F(VPGGitFormTest, Normal)
 {
     
 }
+
+TEST_F(VPGGitFormTest, VisibleLogs)
+{
+    std::wstring workspace = L"bin/Debug/GitForm/";
+    if (vcc::isDirectoryExists(workspace))
+        std::filesystem::remove_all(workspace);
+    vcc::createDirectory(workspace);
+    vcc::GitService::initializeGitResponse(nullptr, workspace);
+    vcc::GitService::setLocalUserName(nullptr, workspace, L"test");
+    vcc::GitService::setLocalUserEmail(nullptr, workspace, L"test@test.com");
+    for (int64_t i = 0; i < 5; i++)
+        vcc::ProcessService::execute(nullptr, L"", workspace, L"git commit --allow-empty -m \"Commit " + std::to_wstring(i) + L"\"");
+
+    _Form->getGitManager()->setWorkspace(workspace);
+    _Form->setLogPageSize(2);
+    auto logs = _Form->getVisibleLogs(1, 3);
+    EXPECT_EQ(logs.size(), (size_t)3);
+    EXPECT_EQ(logs.at(0)->getTitle(), L"Commit 3");
+    EXPECT_EQ(logs.at(2)->getTitle(), L"Commit 1");
+    // 2 visible pages and next page
+    EXPECT_EQ(_Form->getGitManager()->getLogPageCacheSize(), 3);
+    EXPECT_EQ(_Form->getVisibleLogs(4, 3).size(), (size_t)1);
+}